@@ -0,0 +1,133 @@
+"""Cost of the binding layer itself: conversions and per-call overhead."""
+import pytest
+
+import regarch_wrapper
+
+try:
+    import numpy as np
+except ImportError:
+    np = None
+
+
+@pytest.mark.benchmark(group="call-overhead")
+def bench_trivial_call(benchmark, model):
+    """One bound C++ call doing no work, the floor of every other benchmark."""
+    benchmark(model.get_n_param)
+
+
+@pytest.mark.benchmark(group="convert-list-to-cDVector")
+def bench_set_param_from_list(benchmark):
+    """py_list_or_tuple_to_cDVector through cAr.set(list)."""
+    ar = regarch_wrapper.cAr(100)
+    coefs = [0.001 * i for i in range(100)]
+    benchmark(ar.set, coefs, 0)
+
+
+@pytest.mark.benchmark(group="convert-list-to-cDVector")
+def bench_set_param_from_tuple(benchmark):
+    ar = regarch_wrapper.cAr(100)
+    coefs = tuple(0.001 * i for i in range(100))
+    benchmark(ar.set, coefs, 0)
+
+
+@pytest.mark.benchmark(group="convert-value")
+def bench_value_from_list(benchmark, series):
+    """cRegArchValue built from a Python list (copy of n floats)."""
+    n, yt, _ = series
+    benchmark(regarch_wrapper.cRegArchValue, yt)
+
+
+@pytest.mark.benchmark(group="convert-value")
+def bench_value_alloc_only(benchmark, series):
+    """Same allocation without the conversion."""
+    n, _, _ = series
+    benchmark(regarch_wrapper.cRegArchValue, n)
+
+
+@pytest.mark.benchmark(group="read-back")
+def bench_read_elementwise(benchmark, series):
+    """n __getitem__ calls on mYt."""
+    n, _, value = series
+    yt = value.mYt
+    benchmark(lambda: [yt[i] for i in range(n)])
+
+
+@pytest.mark.benchmark(group="read-back")
+@pytest.mark.skipif(np is None, reason="numpy not installed")
+def bench_read_view_copy(benchmark, series):
+    """One copy through the shared-memory view."""
+    _, _, value = series
+    benchmark(lambda: np.array(value.yt_view))
+
+
+@pytest.fixture(scope="module")
+def regressors():
+    """A 100000 x 20 cGSLMatrix."""
+    mat = regarch_wrapper.cGSLMatrix(100000, 20)
+    mat.set_rows([[0.01 * c] * 20 for c in range(100000)])
+    return mat
+
+
+@pytest.mark.benchmark(group="matrix-read")
+def bench_matrix_read_elementwise(benchmark, regressors):
+    """get(r, c) on every element."""
+    mat = regressors
+    benchmark.pedantic(lambda: [[mat.get(r, c) for c in range(20)] for r in range(100000)], rounds=3)
+
+
+@pytest.mark.benchmark(group="matrix-read")
+def bench_matrix_read_rows(benchmark, regressors):
+    """m[r] row views, one per row."""
+    mat = regressors
+    benchmark.pedantic(lambda: [mat[r] for r in range(100000)], rounds=3)
+
+
+@pytest.mark.benchmark(group="matrix-read")
+def bench_matrix_to_list(benchmark, regressors):
+    benchmark.pedantic(regressors.to_list, rounds=3)
+
+
+@pytest.mark.benchmark(group="matrix-read")
+@pytest.mark.skipif(np is None, reason="numpy not installed")
+def bench_matrix_read_buffer(benchmark, regressors):
+    """One copy through the buffer protocol."""
+    benchmark(lambda: np.array(regressors))
+
+
+# set() throughput: the argument is classified once (cParamDispatch.h), a
+# scalar is read directly, a float64 array copied in one block.
+@pytest.mark.benchmark(group="set-throughput")
+def bench_set_scalar(benchmark):
+    """set(float, index, num_param), the per-coefficient loop of a fit."""
+    garch = regarch_wrapper.cGarch(1, 1)
+    benchmark(garch.set, 0.85, 0, 2)
+
+
+@pytest.mark.benchmark(group="set-throughput")
+def bench_set_scalar_by_name(benchmark):
+    garch = regarch_wrapper.cGarch(1, 1)
+    benchmark(garch.set, 0.85, "garch", 0)
+
+
+@pytest.mark.benchmark(group="set-throughput")
+def bench_set_vector_list(benchmark):
+    ar = regarch_wrapper.cAr(100)
+    coefs = [0.001 * i for i in range(100)]
+    benchmark(ar.set, coefs, 0)
+
+
+@pytest.mark.benchmark(group="set-throughput")
+@pytest.mark.skipif(np is None, reason="numpy not installed")
+def bench_set_vector_numpy(benchmark):
+    """Fast path: one block copy of a float64 array."""
+    ar = regarch_wrapper.cAr(100)
+    coefs = np.arange(100) * 0.001
+    benchmark(ar.set, coefs, 0)
+
+
+@pytest.mark.benchmark(group="set-throughput")
+def bench_set_vector_cGSLVector(benchmark):
+    """A cDVector is passed by reference, without copy."""
+    ar = regarch_wrapper.cAr(100)
+    coefs = regarch_wrapper.cGSLVector(100)
+    benchmark(ar.set, coefs, 0)
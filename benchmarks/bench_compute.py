@@ -0,0 +1,140 @@
+"""End-to-end Python calls next to their C++-only counterparts."""
+import pytest
+
+import regarch_wrapper
+from conftest import CSTE, ARCH, GARCH
+
+
+class PyGarch(regarch_wrapper.cAbstCondVar):
+    """GARCH(1,1) in Python, to measure the per-date override cost."""
+
+    def __init__(self):
+        regarch_wrapper.cAbstCondVar.__init__(self, regarch_wrapper.eCondVarEnum.eGarch)
+
+    def get_n_param(self):
+        return 3
+
+    def get_n_lags(self):
+        return 1
+
+    def compute_var(self, date, data):
+        h = CSTE
+        if date > 0:
+            h += ARCH * data.mUt[date - 1] ** 2 + GARCH * data.mHt[date - 1]
+        return h
+
+
+@pytest.mark.benchmark(group="simul")
+def bench_simul_list(benchmark, model, series):
+    """RegArchSimul writing into a Python list (temporary cDVector + n list stores)."""
+    n, _, _ = series
+    out = [0.0] * n
+    benchmark(regarch_wrapper.RegArchSimul, n, model, out)
+
+
+@pytest.mark.benchmark(group="simul")
+def bench_simul_cdvector(benchmark, model, series):
+    n, _, _ = series
+    out = regarch_wrapper.cGSLVector(n)
+    benchmark(regarch_wrapper.RegArchSimul_with_cDVector, n, model, out)
+
+
+@pytest.mark.benchmark(group="simul")
+def bench_simul_value(benchmark, model, series):
+    """C++ only: the value is reused, nothing is converted."""
+    n, _, _ = series
+    value = regarch_wrapper.cRegArchValue(n)
+    benchmark(regarch_wrapper.RegArchSimul_from_value, n, model, value)
+
+
+@pytest.mark.benchmark(group="llh")
+def bench_llh_from_list(benchmark, model, series):
+    """Conversion of the list included."""
+    _, yt, _ = series
+    benchmark(lambda: regarch_wrapper.RegArchLLH_from_value(model, regarch_wrapper.cRegArchValue(yt)))
+
+
+@pytest.mark.benchmark(group="llh")
+def bench_llh_from_value(benchmark, model, series):
+    _, _, value = series
+    benchmark(regarch_wrapper.RegArchLLH_from_value, model, value)
+
+
+@pytest.mark.benchmark(group="llh")
+def bench_llh_python_var(benchmark, series):
+    """Same model with the variance implemented in Python."""
+    _, _, value = series
+    mean = regarch_wrapper.cCondMean()
+    mean.add_one_mean(regarch_wrapper.cConst(0.1))
+    var = PyGarch()
+    py_model = regarch_wrapper.cRegArchModel(mean, var, regarch_wrapper.cNormResiduals())
+    benchmark(regarch_wrapper.RegArchLLH_from_value, py_model, value)
+
+
+@pytest.mark.benchmark(group="grad")
+def bench_grad_llh(benchmark, model, series):
+    _, _, value = series
+    grad = regarch_wrapper.cGSLVector(model.get_n_param())
+    benchmark(regarch_wrapper.RegArchGradLLH, model, value, grad)
+
+
+@pytest.mark.benchmark(group="grad")
+def bench_grad_llh_to_list(benchmark, model, series):
+    """Gradient plus the read-back a caller usually does."""
+    _, _, value = series
+    n_param = model.get_n_param()
+    grad = regarch_wrapper.cGSLVector(n_param)
+
+    def run():
+        regarch_wrapper.RegArchGradLLH(model, value, grad)
+        return [grad[i] for i in range(n_param)]
+
+    benchmark(run)
+
+
+@pytest.mark.benchmark(group="lt-series")
+def bench_lt_series(benchmark, model, series):
+    """l(t) of every date, one call."""
+    _, _, value = series
+    benchmark(regarch_wrapper.RegArchLtSeries, model, value)
+
+
+@pytest.mark.benchmark(group="lt-series")
+def bench_lt_series_score(benchmark, model, series):
+    """l(t) and the n x k score matrix, one call."""
+    _, _, value = series
+    benchmark(regarch_wrapper.RegArchLtSeries, model, value, None, True)
+
+
+@pytest.mark.benchmark(group="lt-series")
+def bench_grad_lt_per_date(benchmark, model, series):
+    """Score matrix with one RegArchGradLt call and one read-back per date."""
+    n, _, value = series
+    n_param = model.get_n_param()
+
+    def run():
+        grad_data = regarch_wrapper.cRegArchGradient(model.get_n_lags(), 1, 3, 0)
+        grad_lt = regarch_wrapper.cGSLVector(n_param)
+        score = []
+        for t in range(n):
+            regarch_wrapper.RegArchGradLt(t, model, value, grad_data, grad_lt)
+            score.append([grad_lt[j] for j in range(n_param)])
+        return score
+
+    benchmark(run)
+
+
+@pytest.mark.benchmark(group="executor")
+def bench_llh_sequential(benchmark, model, series):
+    """Eight LLH evaluations, one after the other."""
+    _, _, value = series
+    benchmark(lambda: [regarch_wrapper.RegArchLLH_from_value(model, value) for _ in range(8)])
+
+
+@pytest.mark.benchmark(group="executor")
+def bench_llh_executor(benchmark, model, series):
+    """Eight LLH jobs on the native executor, submission and value copies included."""
+    _, _, value = series
+    executor = regarch_wrapper.cRegArchExecutor()
+    benchmark(lambda: [f.result() for f in [executor.submit_llh(model, value) for _ in range(8)]])
+    executor.shutdown()
@@ -0,0 +1,48 @@
+"""Start-up cost of many fitted models: model bank against set() calls."""
+import pytest
+
+import regarch_wrapper
+
+N_MODELS = [10000, 100000]
+
+
+def rebuild(params):
+    """What a service does without the bank: one set() per parameter."""
+    models = []
+    for cste, arch, garch in params:
+        mean = regarch_wrapper.cCondMean()
+        mean.add_one_mean(regarch_wrapper.cConst(0.1))
+        var = regarch_wrapper.cGarch(1, 1)
+        var.set(cste, 0, 0)
+        var.set(arch, 0, 1)
+        var.set(garch, 0, 2)
+        models.append(regarch_wrapper.cRegArchModel(mean, var, regarch_wrapper.cNormResiduals()))
+    return models
+
+
+@pytest.fixture(scope="module", params=N_MODELS, ids=lambda n: "models=%d" % n)
+def bank(request, tmp_path_factory):
+    """(parameters, path of a bank) for the given number of GARCH(1,1) models."""
+    n = request.param
+    params = [(0.05, 0.10, 0.80 + 0.1 * k / n) for k in range(n)]
+    path = str(tmp_path_factory.mktemp("bank") / "models.ramb")
+    regarch_wrapper.save_model_bank(path, rebuild(params))
+    return params, path
+
+
+@pytest.mark.benchmark(group="model_bank")
+def bench_bank_rebuild_with_set(benchmark, bank):
+    params, _ = bank
+    benchmark.pedantic(rebuild, args=(params,), rounds=3)
+
+
+@pytest.mark.benchmark(group="model_bank")
+def bench_bank_load_all(benchmark, bank):
+    _, path = bank
+    benchmark.pedantic(regarch_wrapper.load_model_bank, args=(path,), rounds=3)
+
+
+@pytest.mark.benchmark(group="model_bank")
+def bench_bank_load_all_one_thread(benchmark, bank):
+    _, path = bank
+    benchmark.pedantic(regarch_wrapper.load_model_bank, args=(path, 1), rounds=3)
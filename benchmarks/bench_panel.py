@@ -0,0 +1,43 @@
+"""Feeding many series to the library: mapped panel against list conversion."""
+import pytest
+
+import regarch_wrapper
+
+N_DATE = 3750
+N_COLUMN = 2000
+
+
+@pytest.fixture(scope="module")
+def panel(tmp_path_factory):
+    """(series as lists, path of the same series written as a panel)."""
+    series = [[0.001 * ((7 * t + k) % 101 - 50) for t in range(N_DATE)] for k in range(N_COLUMN)]
+    path = str(tmp_path_factory.mktemp("panel") / "panel.rapn")
+    regarch_wrapper.write_panel(path, series)
+    return series, path
+
+
+def from_lists(series):
+    return [regarch_wrapper.cRegArchValue(yt) for yt in series]
+
+
+def from_panel(path):
+    data = regarch_wrapper.cRegArchPanel(path)
+    return [data.value(k) for k in range(len(data))]
+
+
+@pytest.mark.benchmark(group="panel")
+def bench_panel_values_from_lists(benchmark, panel):
+    series, _ = panel
+    benchmark.pedantic(from_lists, args=(series,), rounds=3)
+
+
+@pytest.mark.benchmark(group="panel")
+def bench_panel_values_from_mapping(benchmark, panel):
+    _, path = panel
+    benchmark.pedantic(from_panel, args=(path,), rounds=3)
+
+
+@pytest.mark.benchmark(group="panel")
+def bench_panel_open(benchmark, panel):
+    _, path = panel
+    benchmark(regarch_wrapper.cRegArchPanel, path)
@@ -0,0 +1,46 @@
+"""Reading a delimited text file: native loader against csv + list conversion."""
+import csv
+
+import pytest
+
+import regarch_wrapper
+
+N_ROWS = 1000000
+
+
+@pytest.fixture(scope="module")
+def csv_path(tmp_path_factory):
+    """Return series with two regressors, one header line."""
+    path = tmp_path_factory.mktemp("text") / "series.csv"
+    with open(path, "w") as f:
+        f.write("ret,x1,x2\n")
+        for t in range(N_ROWS):
+            f.write("%.10g,%d,%.6f\n" % (0.001 * ((7 * t) % 101 - 50), t % 5, 0.5 + 1e-6 * t))
+    return str(path)
+
+
+def from_csv_module(path):
+    with open(path, newline="") as f:
+        reader = csv.reader(f)
+        next(reader)
+        rows = [[float(x) for x in row] for row in reader]
+    value = regarch_wrapper.cRegArchValue([row[0] for row in rows])
+    value.set_xt([row[1:] for row in rows])
+    return value
+
+
+@pytest.mark.benchmark(group="text")
+def bench_text_csv_module(benchmark, csv_path):
+    benchmark.pedantic(from_csv_module, args=(csv_path,), rounds=3)
+
+
+@pytest.mark.benchmark(group="text")
+def bench_text_load_text(benchmark, csv_path):
+    benchmark.pedantic(regarch_wrapper.load_text, args=(csv_path,),
+                       kwargs={"xt_cols": [1, 2], "header": True}, rounds=3)
+
+
+@pytest.mark.benchmark(group="text")
+def bench_text_load_text_one_thread(benchmark, csv_path):
+    benchmark.pedantic(regarch_wrapper.load_text, args=(csv_path,),
+                       kwargs={"xt_cols": [1, 2], "header": True, "n_thread": 1}, rounds=3)
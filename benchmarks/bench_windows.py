@@ -0,0 +1,41 @@
+"""Rolling-window likelihoods: copied sub-series against views on the parent."""
+import pytest
+
+import regarch_wrapper
+
+N = 20000
+WINDOW = 1000
+STEP = 20
+
+
+@pytest.fixture(scope="module")
+def long_series(model):
+    yt = [0.0] * N
+    regarch_wrapper.RegArchSimul(N, model, yt)
+    return yt, regarch_wrapper.cRegArchValue(yt)
+
+
+def rolling_copies(model, yt):
+    return [regarch_wrapper.RegArchLLH_from_value(model, regarch_wrapper.cRegArchValue(yt[b:b + WINDOW]))
+            for b in range(0, N - WINDOW, STEP)]
+
+
+def rolling_view(model, parent):
+    view = regarch_wrapper.cRegArchValueView(parent, 0, WINDOW)
+    res = []
+    for b in range(0, N - WINDOW, STEP):
+        view.set_range(b, b + WINDOW)
+        res.append(regarch_wrapper.RegArchLLH_from_value(model, view))
+    return res
+
+
+@pytest.mark.benchmark(group="windows")
+def bench_windows_slice_and_copy(benchmark, model, long_series):
+    yt, _ = long_series
+    benchmark.pedantic(rolling_copies, args=(model, yt), rounds=5)
+
+
+@pytest.mark.benchmark(group="windows")
+def bench_windows_view(benchmark, model, long_series):
+    _, parent = long_series
+    benchmark.pedantic(rolling_view, args=(model, parent), rounds=5)
@@ -0,0 +1,44 @@
+"""Shared fixtures of the Python-side benchmarks.
+
+Run from the repository root with pytest-benchmark installed:
+
+    pytest benchmarks --benchmark-json=bench.json
+
+Each group pairs a Python-facing call with the closest call that only runs
+C++ code on data already held by the wrapper, so the difference is the cost
+of the binding layer (argument conversion, list copies, Python overrides).
+Compare two runs with `pytest-benchmark compare`.
+
+The module is imported from REGARCH_WRAPPER_PATH when set, from tests/
+(the checked-in build) otherwise.
+"""
+import os
+import sys
+
+import pytest
+
+_HERE = os.path.dirname(os.path.abspath(__file__))
+_TESTS = os.path.join(_HERE, os.pardir, "tests")
+# tests/ for the shared model factory, REGARCH_WRAPPER_PATH ahead of it when set
+sys.path.insert(0, _TESTS)
+if "REGARCH_WRAPPER_PATH" in os.environ:
+    sys.path.insert(0, os.environ["REGARCH_WRAPPER_PATH"])
+
+import regarch_wrapper  # noqa: E402
+from regarch_test_utils import CSTE, ARCH, GARCH, make_garch_model  # noqa: E402,F401
+
+SIZES = [1000, 10000, 100000]
+
+
+@pytest.fixture(scope="session")
+def model():
+    return make_garch_model()
+
+
+@pytest.fixture(scope="session", params=SIZES, ids=lambda n: "n=%d" % n)
+def series(request, model):
+    """(n, yt as a list, cRegArchValue) simulated from the GARCH(1,1) model."""
+    n = request.param
+    yt = [0.0] * n
+    regarch_wrapper.RegArchSimul(n, model, yt)
+    return n, yt, regarch_wrapper.cRegArchValue(yt)
@@ -1,5 +1,6 @@
 #include "PythonConversion.h"
 #include <stdexcept>
+#include <cstring>
 #include <boost/python.hpp>
 #include <boost/python/object.hpp>
 #include <boost/python/handle.hpp>
@@ -13,6 +14,7 @@ cDVector py_list_or_tuple_to_cDVector(const object& pyObj)
         throw std::runtime_error("Object is not a Python sequence (list or tuple).");
 
     Py_ssize_t n = PySequence_Size(pyObj.ptr());
+    REGARCH_PROFILE_COUNT("alloc", "cDVector", "py_list_or_tuple_to_cDVector", 1);
     cDVector result(n);
 
     for (Py_ssize_t i = 0; i < n; i++)
@@ -39,6 +41,7 @@ cDMatrix py_list_of_lists_to_cDMatrix(const object& pyObj)
         throw std::runtime_error("The first element is not a sequence (expected list for a row).");
 
     Py_ssize_t nCols = PySequence_Size(firstRow.ptr());
+    REGARCH_PROFILE_COUNT("alloc", "cDMatrix", "py_list_of_lists_to_cDMatrix", 1);
     cDMatrix result(nRows, nCols);
 
     for (Py_ssize_t i = 0; i < nRows; i++)
@@ -56,3 +59,240 @@ cDMatrix py_list_of_lists_to_cDMatrix(const object& pyObj)
     }
     return result;
 }
+
+bool HasPythonComponent(const cRegArchModel& theModel)
+{
+    typedef boost::python::detail::wrapper_base tPyBase;
+
+    if (dynamic_cast<const tPyBase*>(theModel.mVar) != NULL)
+        return true;
+    if (dynamic_cast<const tPyBase*>(theModel.mResids) != NULL)
+        return true;
+    if (theModel.mMean != NULL)
+    {
+        cAbstCondMean** myMean = theModel.mMean->GetCondMean();
+        for (uint i = 0; myMean != NULL && i < theModel.mMean->GetNMean(); i++)
+            if (dynamic_cast<const tPyBase*>(myMean[i]) != NULL)
+                return true;
+    }
+    return false;
+}
+
+// numpy.asarray, looked up once and kept for the life of the interpreter; NULL without NumPy
+static PyObject* NumpyAsArray(void)
+{
+    static PyObject* myAsArray = NULL;
+    static bool myTried = false;
+    if (!myTried)
+    {
+        myTried = true;
+        PyObject* myNumpy = PyImport_ImportModule("numpy");
+        if (myNumpy != NULL)
+        {
+            myAsArray = PyObject_GetAttrString(myNumpy, "asarray");
+            Py_DECREF(myNumpy);
+        }
+        if (myAsArray == NULL)
+            PyErr_Clear();
+    }
+    return myAsArray;
+}
+
+object make_double_view(double* theData, size_t theSize, bool theWritable)
+{
+    PyObject* myAsArray = NumpyAsArray();
+    PyObject* myRaw = PyMemoryView_FromMemory(reinterpret_cast<char*>(theData),
+        (Py_ssize_t)(theSize * sizeof(double)), theWritable ? PyBUF_WRITE : PyBUF_READ);
+    if (myRaw == NULL)
+        throw_error_already_set();
+    object myView = object(handle<>(myRaw)).attr("cast")("d");
+    if (myAsArray == NULL)
+        return myView;
+    return object(handle<>(PyObject_CallFunctionObjArgs(myAsArray, myView.ptr(), NULL)));
+}
+
+object make_double_array(size_t theNRow, size_t theNCol)
+{
+    size_t mySize = theNRow * ((theNCol > 0) ? theNCol : 1);
+    PyObject* myRaw = PyByteArray_FromStringAndSize(NULL, (Py_ssize_t)(mySize * sizeof(double)));
+    if (myRaw == NULL)
+        throw_error_already_set();
+    object myBytes = object(handle<>(myRaw));
+    if (mySize > 0)
+        memset(PyByteArray_AS_STRING(myRaw), 0, mySize * sizeof(double));
+    tuple myShape = (theNCol > 0) ? make_tuple(theNRow, theNCol) : make_tuple(theNRow);
+    object myView = object(handle<>(PyMemoryView_FromObject(myRaw)));
+    // memoryview cannot cast to a shape holding a zero
+    myView = (mySize > 0) ? myView.attr("cast")("d", myShape) : myView.attr("cast")("d");
+    PyObject* myAsArray = NumpyAsArray();
+    if (myAsArray == NULL)
+        return myView;
+    object myRes = object(handle<>(PyObject_CallFunctionObjArgs(myAsArray, myView.ptr(), NULL)));
+    return (mySize > 0) ? myRes : myRes.attr("reshape")(myShape);
+}
+
+object make_strided_double_view(double* theData, size_t theNRow, size_t theNCol, size_t theRowStride, size_t theColStride, bool theWritable)
+{
+    bool myIs2D = theNCol > 0;
+    size_t myNCol = myIs2D ? theNCol : 1;
+    // Contiguous: a memoryview cast to the shape is enough
+    if (theNRow == 0 || (theColStride == 1 && theRowStride == myNCol) || (!myIs2D && theRowStride == 1))
+    {
+        object myView = make_double_view(theData, theNRow * myNCol, theWritable);
+        if (!myIs2D || theNRow == 0)
+            return myView;
+        if (PyMemoryView_Check(myView.ptr()))
+            return myView.attr("cast")("B").attr("cast")("d", make_tuple(theNRow, theNCol));
+        return myView.attr("reshape")(make_tuple(theNRow, theNCol));
+    }
+
+    static PyObject* myNdArray = NULL;
+    static bool myTried = false;
+    if (!myTried)
+    {
+        myTried = true;
+        PyObject* myNumpy = PyImport_ImportModule("numpy");
+        if (myNumpy != NULL)
+        {
+            myNdArray = PyObject_GetAttrString(myNumpy, "ndarray");
+            Py_DECREF(myNumpy);
+        }
+        if (myNdArray == NULL)
+            PyErr_Clear();
+    }
+    if (myNdArray == NULL)
+        throw std::runtime_error("make_strided_double_view: strided views need NumPy");
+
+    // Memory spanned by the view, from the first to the last element
+    size_t myExtent = (theNRow - 1) * theRowStride + (myNCol - 1) * theColStride + 1;
+    PyObject* myRaw = PyMemoryView_FromMemory(reinterpret_cast<char*>(theData),
+        (Py_ssize_t)(myExtent * sizeof(double)), theWritable ? PyBUF_WRITE : PyBUF_READ);
+    if (myRaw == NULL)
+        throw_error_already_set();
+    object myBuffer = object(handle<>(myRaw));
+    tuple myShape = myIs2D ? make_tuple(theNRow, theNCol) : make_tuple(theNRow);
+    tuple myStrides = myIs2D
+        ? make_tuple(theRowStride * sizeof(double), theColStride * sizeof(double))
+        : make_tuple(theRowStride * sizeof(double));
+    dict myKw;
+    myKw["shape"] = myShape;
+    myKw["dtype"] = "f8";
+    myKw["buffer"] = myBuffer;
+    myKw["strides"] = myStrides;
+    object myArray = object(handle<>(borrowed(myNdArray)))(*tuple(), **myKw);
+    if (!theWritable)
+        myArray.attr("flags").attr("writeable") = false;
+    return myArray;
+}
+
+int fill_double_buffer(Py_buffer* theView, PyObject* theOwner, double* theData, int theNDim,
+    const size_t* theShape, const size_t* theStrides, int theFlags)
+{
+    theView->obj = NULL;
+    bool myContiguous = true;
+    size_t myExpected = 1;
+    size_t myCount = 1;
+    for (int d = theNDim - 1; d >= 0; d--)
+    {
+        myContiguous = myContiguous && (theShape[d] <= 1 || theStrides[d] == myExpected);
+        myExpected *= theShape[d];
+        myCount *= theShape[d];
+    }
+    if (!myContiguous && ((theFlags & PyBUF_STRIDES) != PyBUF_STRIDES
+        || (theFlags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS
+        || (theFlags & PyBUF_F_CONTIGUOUS) == PyBUF_F_CONTIGUOUS
+        || (theFlags & PyBUF_ANY_CONTIGUOUS) == PyBUF_ANY_CONTIGUOUS))
+    {
+        PyErr_SetString(PyExc_BufferError, "the data are strided, a contiguous buffer cannot be given");
+        return -1;
+    }
+
+    // shape then strides, freed with the view (fill_double_buffer_release)
+    Py_ssize_t* myInfo = new Py_ssize_t[2 * theNDim];
+    for (int d = 0; d < theNDim; d++)
+    {
+        myInfo[d] = (Py_ssize_t)theShape[d];
+        myInfo[theNDim + d] = (Py_ssize_t)(theStrides[d] * sizeof(double));
+    }
+    theView->buf = theData;
+    theView->obj = theOwner;
+    Py_INCREF(theOwner);
+    theView->len = (Py_ssize_t)(myCount * sizeof(double));
+    theView->readonly = 0;
+    theView->itemsize = sizeof(double);
+    theView->format = ((theFlags & PyBUF_FORMAT) == PyBUF_FORMAT) ? const_cast<char*>("d") : NULL;
+    theView->ndim = theNDim;
+    theView->shape = ((theFlags & PyBUF_ND) == PyBUF_ND) ? myInfo : NULL;
+    theView->strides = ((theFlags & PyBUF_STRIDES) == PyBUF_STRIDES) ? myInfo + theNDim : NULL;
+    theView->suboffsets = NULL;
+    theView->internal = myInfo;
+    return 0;
+}
+
+void fill_double_buffer_release(PyObject*, Py_buffer* theView)
+{
+    delete[] static_cast<Py_ssize_t*>(theView->internal);
+    theView->internal = NULL;
+}
+
+void set_buffer_procs(const object& theClass, getbufferproc theGet)
+{
+    // Boost.Python classes are heap types: their buffer slots live in the type object
+    PyHeapTypeObject* myType = reinterpret_cast<PyHeapTypeObject*>(theClass.ptr());
+    myType->as_buffer.bf_getbuffer = theGet;
+    myType->as_buffer.bf_releasebuffer = &fill_double_buffer_release;
+    myType->ht_type.tp_as_buffer = &myType->as_buffer;
+    PyType_Modified(&myType->ht_type);
+}
+
+void py_to_doubles(const object& pyObj, double* theDest, size_t theSize)
+{
+    Py_buffer myBuf;
+    if (PyObject_GetBuffer(pyObj.ptr(), &myBuf, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == 0)
+    {
+        bool myIsDouble = myBuf.itemsize == sizeof(double) && myBuf.format != NULL
+            && (strcmp(myBuf.format, "d") == 0 || strcmp(myBuf.format, "<d") == 0 || strcmp(myBuf.format, "=d") == 0);
+        if (myIsDouble)
+        {
+            Py_ssize_t myLen = myBuf.len;
+            if ((size_t)myLen != theSize * sizeof(double))
+            {
+                PyBuffer_Release(&myBuf);
+                throw std::runtime_error("py_to_doubles: size mismatch.");
+            }
+            // May be a view on theDest itself
+            memmove(theDest, myBuf.buf, (size_t)myLen);
+            PyBuffer_Release(&myBuf);
+            return;
+        }
+        PyBuffer_Release(&myBuf);
+    }
+    else
+        PyErr_Clear();
+
+    if (!PySequence_Check(pyObj.ptr()) || (size_t)PySequence_Size(pyObj.ptr()) != theSize)
+        throw std::runtime_error("py_to_doubles: expected a sequence of the right size.");
+    for (size_t i = 0; i < theSize; i++)
+    {
+        object item(handle<>(PySequence_GetItem(pyObj.ptr(), (Py_ssize_t)i)));
+        theDest[i] = extract<double>(item);
+    }
+}
+
+object make_py_bytes(const std::string& theData)
+{
+    return object(handle<>(PyBytes_FromStringAndSize(theData.data(), (Py_ssize_t)theData.size())));
+}
+
+std::string py_bytes_to_string(const object& pyObj)
+{
+    Py_buffer myBuf;
+    if (PyObject_GetBuffer(pyObj.ptr(), &myBuf, PyBUF_C_CONTIGUOUS) != 0)
+    {
+        PyErr_Clear();
+        throw std::runtime_error("py_bytes_to_string: expected bytes or a contiguous buffer.");
+    }
+    std::string myRes(static_cast<const char*>(myBuf.buf), (size_t)myBuf.len);
+    PyBuffer_Release(&myBuf);
+    return myRes;
+}
@@ -3,6 +3,7 @@
 
 #include <boost/python.hpp>
 #include "StdAfxRegArchLib.h"  // Adjust path if needed
+#include "cProfile.h"
 
 /*!
  * \brief Convert a Python sequence (list or tuple) of floats into a cDVector.
@@ -20,4 +21,171 @@ extern RegArchLib::cDVector py_list_or_tuple_to_cDVector(const boost::python::ob
  */
 extern RegArchLib::cDMatrix py_list_of_lists_to_cDMatrix(const boost::python::object& pyObj);
 
+/*!
+ * \brief Tell whether a model has a component implemented in Python (through one of the
+ *        cAbst*Wrap trampolines).
+ * \param theModel The model to inspect.
+ * \return true if the mean, variance or residuals component is a Python subclass.
+ *          Such models cannot be copied nor evaluated without holding the GIL.
+ */
+extern bool HasPythonComponent(const RegArchLib::cRegArchModel& theModel);
+
+/*!
+ * \brief Wrap theSize doubles at theData as a NumPy float64 array sharing the memory
+ *        (a memoryview of format 'd' when NumPy is not installed).
+ * \note No copy is made: the view must not be used after the owner of theData is
+ *       reallocated or destroyed.
+ */
+extern boost::python::object make_double_view(double* theData, size_t theSize, bool theWritable = true);
+
+/*!
+ * \brief New zero-filled float64 array of theNRow x theNCol doubles (theNCol == 0:
+ *        1-D array of theNRow doubles) owning its memory. A NumPy array, a
+ *        memoryview on a bytearray when NumPy is not installed.
+ */
+extern boost::python::object make_double_array(size_t theNRow, size_t theNCol = 0);
+
+/*!
+ * \brief View on theNRow x theNCol doubles at theData, theRowStride / theColStride
+ *        doubles apart (theNCol == 0: 1-D view of theNRow doubles, theRowStride
+ *        apart). Contiguous data give the same object as make_double_view, strided
+ *        data a NumPy array (std::runtime_error without NumPy).
+ * \note No copy is made, as for make_double_view.
+ */
+extern boost::python::object make_strided_double_view(double* theData, size_t theNRow, size_t theNCol,
+    size_t theRowStride, size_t theColStride, bool theWritable = true);
+
+/*!
+ * \brief Buffer protocol for the classes holding doubles (cGSLVector, cGSLMatrix).
+ *
+ * fill_double_buffer fills theView for theNDim dimensions (shapes, strides in
+ * doubles) and honours theFlags; it sets a BufferError and returns -1 when the
+ * data cannot be exposed as asked. set_buffer_procs installs theGet, which
+ * calls it, as the getbuffer slot of the Boost.Python class theClass.
+ */
+extern int fill_double_buffer(Py_buffer* theView, PyObject* theOwner, double* theData, int theNDim,
+    const size_t* theShape, const size_t* theStrides, int theFlags);
+extern void fill_double_buffer_release(PyObject* theOwner, Py_buffer* theView);
+extern void set_buffer_procs(const boost::python::object& theClass, getbufferproc theGet);
+
+/*!
+ * \brief Copy theSize floats from a Python object into theDest. Contiguous float64
+ *        buffers (NumPy arrays, memoryviews) are copied in one block, any other
+ *        sequence element by element.
+ * \throws std::runtime_error if the size does not match.
+ */
+extern void py_to_doubles(const boost::python::object& pyObj, double* theDest, size_t theSize);
+
+/*!
+ * \brief Copy theData into a new Python bytes object (pickle states).
+ */
+extern boost::python::object make_py_bytes(const std::string& theData);
+
+/*!
+ * \brief Copy the contents of a bytes-like object (bytes, bytearray, memoryview).
+ * \throws std::runtime_error if the object does not expose a contiguous buffer.
+ */
+extern std::string py_bytes_to_string(const boost::python::object& pyObj);
+
+/*!
+ * \brief Implemented by the trampolines that accept optional batched overrides
+ *        (compute_var_series, compute_mean_series). Lets the C++ drivers look the
+ *        override up once per evaluation instead of once per date.
+ */
+struct cPySeriesHook
+{
+    virtual ~cPySeriesHook() {}
+    /*! The Python override theName, or None if the subclass does not define it */
+    virtual boost::python::object GetPyOverride(const char* theName) const = 0;
+};
+
+/*!
+ * \brief C signatures accepted for native residual densities: one point, or
+ *        theN points at once (theRes[i] = f(theX[i])).
+ */
+typedef double (*tNativeScalarDensity)(double theX);
+typedef void (*tNativeArrayDensity)(const double* theX, double* theRes, size_t theN);
+
+typedef enum eNativeDensityEnum
+{
+    eNativeLogDensity,
+    eNativeDiffLogDensity,
+    eNativeDiff2LogDensity,
+    eNativeDensityCount
+} eNativeDensityEnum;
+
+/*!
+ * \brief Implemented by cAbstResidualsWrap. Holds the native function pointers
+ *        registered for log_density, diff_log_density and diff2_log_density.
+ *        They are plain C calls: the drivers may invoke them without the GIL.
+ */
+struct cNativeDensityHook
+{
+    cNativeDensityHook()
+    {
+        for (int i = 0; i < eNativeDensityCount; i++)
+        {
+            mvScalar[i] = NULL;
+            mvArray[i] = NULL;
+        }
+    }
+    virtual ~cNativeDensityHook() {}
+
+    bool HasNative(eNativeDensityEnum theWhich) const
+    {
+        return mvScalar[theWhich] != NULL || mvArray[theWhich] != NULL;
+    }
+
+    /*! theRes = f(theX) with the registered pointer, false if there is none */
+    bool EvalNative(eNativeDensityEnum theWhich, double theX, double& theRes) const
+    {
+        if (mvScalar[theWhich] != NULL)
+            theRes = mvScalar[theWhich](theX);
+        else if (mvArray[theWhich] != NULL)
+            mvArray[theWhich](&theX, &theRes, 1);
+        else
+            return false;
+        return true;
+    }
+
+    /*! theRes[i] = f(theX[i]) for i < theN, false if there is no pointer */
+    bool EvalNative(eNativeDensityEnum theWhich, const double* theX, double* theRes, size_t theN) const
+    {
+        if (mvArray[theWhich] != NULL)
+            mvArray[theWhich](theX, theRes, theN);
+        else if (mvScalar[theWhich] != NULL)
+            for (size_t i = 0; i < theN; i++)
+                theRes[i] = mvScalar[theWhich](theX[i]);
+        else
+            return false;
+        return true;
+    }
+
+    tNativeScalarDensity mvScalar[eNativeDensityCount];
+    tNativeArrayDensity mvArray[eNativeDensityCount];
+};
+
+/*!
+ * \brief Name of the Python class of a trampoline instance (profiler labels).
+ */
+inline const char* PyOwnerTypeName(const boost::python::detail::wrapper_base& theWrapper)
+{
+    PyObject* myOwner = boost::python::detail::wrapper_base_::get_owner(theWrapper);
+    return (myOwner != NULL) ? Py_TYPE(myOwner)->tp_name : "<python>";
+}
+
+/*!
+ * \brief RAII helper releasing the GIL for the lifetime of the object.
+ *        Only use it around code that does not touch any Python object.
+ */
+struct cScopedGILRelease
+{
+    cScopedGILRelease() : mvState(PyEval_SaveThread()) {}
+    ~cScopedGILRelease() { PyEval_RestoreThread(mvState); }
+    cScopedGILRelease(const cScopedGILRelease&) = delete;
+    cScopedGILRelease& operator=(const cScopedGILRelease&) = delete;
+private:
+    PyThreadState* mvState;
+};
+
 #endif // PYTHON_CONVERTION_H
@@ -0,0 +1,312 @@
+#include "RegArchBatchCompute.h"
+#include "PythonConversion.h"
+#include "cScratchArena.h"
+#include <cmath>
+#include <vector>
+
+using namespace boost::python;
+using namespace RegArchLib;
+
+// None for C++ components and for Python ones without the override
+static object GetSeriesOverride(const cPySeriesHook* theHook, const char* theName)
+{
+    if (theHook == NULL)
+        return object();
+    return theHook->GetPyOverride(theName);
+}
+
+static object GetVarSeries(const cRegArchModel& theModel)
+{
+    return GetSeriesOverride(dynamic_cast<const cPySeriesHook*>(theModel.mVar), "compute_var_series");
+}
+
+static object GetMeanSeries(const cAbstCondMean* theMean)
+{
+    return GetSeriesOverride(dynamic_cast<const cPySeriesHook*>(theMean), "compute_mean_series");
+}
+
+static bool HasMeanInMean(const cRegArchModel& theModel)
+{
+    if (theModel.mMean == NULL)
+        return false;
+    cAbstCondMean** myMean = theModel.mMean->GetCondMean();
+    for (uint i = 0; myMean != NULL && i < theModel.mMean->GetNMean(); i++)
+    {
+        eCondMeanEnum myType = myMean[i]->GetCondMeanType();
+        if (myType == eVarInMean || myType == eStdDevInMean)
+            return true;
+    }
+    return false;
+}
+
+bool HasPySeriesHook(const cRegArchModel& theModel)
+{
+    if (!GetVarSeries(theModel).is_none())
+        return true;
+    if (theModel.mMean != NULL)
+    {
+        cAbstCondMean** myMean = theModel.mMean->GetCondMean();
+        for (uint i = 0; myMean != NULL && i < theModel.mMean->GetNMean(); i++)
+            if (!GetMeanSeries(myMean[i]).is_none())
+                return true;
+    }
+    return false;
+}
+
+static bool HasPythonMeanOrVar(const cRegArchModel& theModel)
+{
+    typedef boost::python::detail::wrapper_base tPyBase;
+
+    if (dynamic_cast<const tPyBase*>(theModel.mVar) != NULL)
+        return true;
+    if (theModel.mMean != NULL)
+    {
+        cAbstCondMean** myMean = theModel.mMean->GetCondMean();
+        for (uint i = 0; myMean != NULL && i < theModel.mMean->GetNMean(); i++)
+            if (dynamic_cast<const tPyBase*>(myMean[i]) != NULL)
+                return true;
+    }
+    return false;
+}
+
+// m(t), u(t), h(t) and eps(t) for the whole sample, series overrides in one call each.
+// Calls Python, the GIL must be held.
+static void FillMeanAndVar(const cRegArchModel& theModel, cRegArchValue& theValue,
+    const std::vector<object>& theMeanSeries, const object& theVarSeries)
+{
+    uint myNObs = theValue.mYt.GetSize();
+    uint myNMean = (uint)theMeanSeries.size();
+    cAbstCondMean** myMean = (myNMean > 0) ? theModel.mMean->GetCondMean() : NULL;
+    bool myHasHook = !theVarSeries.is_none();
+    for (uint i = 0; i < myNMean; i++)
+        myHasHook = myHasHook || !theMeanSeries[i].is_none();
+    // Only built when a Python override will be called
+    object myData;
+    if (myHasHook)
+        myData = object(boost::ref(theValue));
+
+    // Means: series overrides in one call each, the others date by date
+    cScratchScope myScratch;
+    double** myMeanPart = myScratch.Alloc<double*>(myNMean, NULL);
+    for (uint i = 0; i < myNMean; i++)
+    {
+        if (theMeanSeries[i].is_none())
+            continue;
+        REGARCH_PROFILE_SCOPE("mean", PyOwnerTypeName(*dynamic_cast<const boost::python::detail::wrapper_base*>(myMean[i])), "compute_mean_series");
+        myMeanPart[i] = myScratch.Alloc<double>(myNObs);
+        object myRes = theMeanSeries[i](myData, 0, myNObs);
+        if (myRes.is_none())
+            throw std::runtime_error("compute_mean_series must return the mean contributions.");
+        py_to_doubles(myRes, myMeanPart[i], myNObs);
+    }
+    {
+        REGARCH_PROFILE_SCOPE("driver", "RegArchLLHBatch", "mean");
+#ifdef REGARCH_ENABLE_PROFILE
+        // Python components count themselves in their trampolines
+        for (uint i = 0; i < myNMean; i++)
+            if (dynamic_cast<const boost::python::detail::wrapper_base*>(myMean[i]) == NULL)
+                REGARCH_PROFILE_COUNT("mean", REGARCH_PROFILE_TYPE(*myMean[i]), "ComputeMean", myNObs);
+#endif
+        for (uint t = 0; t < myNObs; t++)
+        {
+            double myMt = 0.0;
+            for (uint i = 0; i < myNMean; i++)
+                myMt += theMeanSeries[i].is_none() ? myMean[i]->ComputeMean(t, theValue) : myMeanPart[i][t];
+            theValue.mMt[t] = myMt;
+            theValue.mUt[t] = theValue.mYt[t] - myMt;
+        }
+    }
+
+    // Variances: the residuals are all known, one call covers the sample
+    REGARCH_PROFILE_SCOPE("driver", "RegArchLLHBatch", "var");
+    if (!theVarSeries.is_none())
+    {
+        {
+            REGARCH_PROFILE_SCOPE("var", PyOwnerTypeName(*dynamic_cast<const boost::python::detail::wrapper_base*>(theModel.mVar)), "compute_var_series");
+            object myRes = theVarSeries(myData, 0, myNObs);
+            if (!myRes.is_none() && myNObs > 0)
+                py_to_doubles(myRes, &theValue.mHt[0], myNObs);
+        }
+        for (uint t = 0; t < myNObs; t++)
+            theValue.mEpst[t] = theValue.mUt[t] / sqrt(theValue.mHt[t]);
+    }
+    else
+    {
+#ifdef REGARCH_ENABLE_PROFILE
+        if (dynamic_cast<const boost::python::detail::wrapper_base*>(theModel.mVar) == NULL)
+            REGARCH_PROFILE_COUNT("var", REGARCH_PROFILE_TYPE(*theModel.mVar), "ComputeVar", myNObs);
+#endif
+        // eps(t) before h(t+1): EGARCH and the like read the lagged eps
+        for (uint t = 0; t < myNObs; t++)
+        {
+            theValue.mHt[t] = theModel.mVar->ComputeVar(t, theValue);
+            theValue.mEpst[t] = theValue.mUt[t] / sqrt(theValue.mHt[t]);
+        }
+    }
+}
+
+// The log-likelihood from h(t) and eps(t), the log-density in one native call if registered.
+// With theLt, l(t) is also stored at theLt[t * theLtStride].
+static double SumLLH(const cRegArchModel& theModel, cRegArchValue& theValue, const cNativeDensityHook* theNative,
+    double* theLt, size_t theLtStride)
+{
+    REGARCH_PROFILE_SCOPE("driver", "RegArchLLHBatch", "density");
+    uint myNObs = theValue.mYt.GetSize();
+
+    double myLLH = 0.0;
+    if (theNative != NULL && myNObs > 0)
+    {
+        cScratchScope myScratch;
+        double* myLogDens = myScratch.Alloc<double>(myNObs);
+        {
+            REGARCH_PROFILE_SCOPE("resid", "native", "LogDensity[array]");
+            theNative->EvalNative(eNativeLogDensity, &theValue.mEpst[0], myLogDens, myNObs);
+        }
+        for (uint t = 0; t < myNObs; t++)
+        {
+            double mylt = -0.5 * log(theValue.mHt[t]) + myLogDens[t];
+            if (theLt != NULL)
+                theLt[t * theLtStride] = mylt;
+            myLLH += mylt;
+        }
+        return myLLH;
+    }
+#ifdef REGARCH_ENABLE_PROFILE
+    if (dynamic_cast<const boost::python::detail::wrapper_base*>(theModel.mResids) == NULL)
+        REGARCH_PROFILE_COUNT("resid", REGARCH_PROFILE_TYPE(*theModel.mResids), "LogDensity", myNObs);
+#endif
+    for (uint t = 0; t < myNObs; t++)
+    {
+        double mylt = -0.5 * log(theValue.mHt[t]) + theModel.mResids->LogDensity(theValue.mEpst[t]);
+        if (theLt != NULL)
+            theLt[t * theLtStride] = mylt;
+        myLLH += mylt;
+    }
+    return myLLH;
+}
+
+// RegArchLLH, keeping l(t)
+static double SumLt(const cRegArchModel& theModel, cRegArchValue& theValue, double* theLt, size_t theLtStride)
+{
+    uint myNObs = theValue.mYt.GetSize();
+    double myLLH = 0.0;
+    for (uint t = 0; t < myNObs; t++)
+    {
+        FillValue(t, theModel, theValue);
+        double mylt = -0.5 * log(theValue.mHt[t]) + theModel.mResids->LogDensity(theValue.mEpst[t]);
+        theLt[t * theLtStride] = mylt;
+        myLLH += mylt;
+    }
+    return myLLH;
+}
+
+static double LLHBatch(const cRegArchModel& theModel, cRegArchValue& theValue, double* theLt, size_t theLtStride)
+{
+    // One lookup per evaluation
+    object myVarSeries = GetVarSeries(theModel);
+    uint myNMean = (theModel.mMean != NULL) ? theModel.mMean->GetNMean() : 0;
+    cAbstCondMean** myMean = (myNMean > 0) ? theModel.mMean->GetCondMean() : NULL;
+    std::vector<object> myMeanSeries(myNMean);
+    bool myHasHook = !myVarSeries.is_none();
+    for (uint i = 0; i < myNMean; i++)
+    {
+        myMeanSeries[i] = GetMeanSeries(myMean[i]);
+        myHasHook = myHasHook || !myMeanSeries[i].is_none();
+    }
+    const cNativeDensityHook* myNative = dynamic_cast<const cNativeDensityHook*>(theModel.mResids);
+    if (myNative != NULL && !myNative->HasNative(eNativeLogDensity))
+        myNative = NULL;
+
+    if ((!myHasHook && myNative == NULL) || HasMeanInMean(theModel))
+    {
+        bool myNoPython = !HasPythonComponent(theModel) && Py_IsInitialized() && PyGILState_Check();
+        if (theLt == NULL)
+        {
+            if (myNoPython)
+            {
+                cScopedGILRelease myNoGIL;
+                return RegArchLLH(theModel, theValue);
+            }
+            return RegArchLLH(theModel, theValue);
+        }
+        if (myNoPython)
+        {
+            cScopedGILRelease myNoGIL;
+            return SumLt(theModel, theValue, theLt, theLtStride);
+        }
+        return SumLt(theModel, theValue, theLt, theLtStride);
+    }
+
+    bool myCanRelease = Py_IsInitialized() && PyGILState_Check();
+    // Native residuals with a C++ mean and variance: the library fills the
+    // values, only the density is batched, nothing needs the interpreter
+    if (!myHasHook && !HasPythonMeanOrVar(theModel))
+    {
+        uint myNObs = theValue.mYt.GetSize();
+        if (myCanRelease)
+        {
+            cScopedGILRelease myNoGIL;
+            for (uint t = 0; t < myNObs; t++)
+                FillValue(t, theModel, theValue);
+            return SumLLH(theModel, theValue, myNative, theLt, theLtStride);
+        }
+        for (uint t = 0; t < myNObs; t++)
+            FillValue(t, theModel, theValue);
+        return SumLLH(theModel, theValue, myNative, theLt, theLtStride);
+    }
+
+    FillMeanAndVar(theModel, theValue, myMeanSeries, myVarSeries);
+    if (myNative != NULL && myCanRelease)
+    {
+        cScopedGILRelease myNoGIL;
+        return SumLLH(theModel, theValue, myNative, theLt, theLtStride);
+    }
+    return SumLLH(theModel, theValue, myNative, theLt, theLtStride);
+}
+
+double RegArchLLHBatch(const cRegArchModel& theModel, cRegArchValue& theValue)
+{
+    return LLHBatch(theModel, theValue, NULL, 0);
+}
+
+// l(t) and its gradient, date by date: the gradient data keep the lags
+static double SumLtAndScore(cRegArchModel& theModel, cRegArchValue& theValue, double* theLt, size_t theLtStride,
+    double* theScore, size_t theScoreStride)
+{
+    REGARCH_PROFILE_SCOPE("driver", "RegArchLtSeries", "score");
+    uint myNObs = theValue.mYt.GetSize();
+    uint myNParam = theModel.GetNParam();
+    uint myNMeanParam = (theModel.mMean != NULL) ? theModel.mMean->GetNParam() : 0;
+    uint myNDistrParam = theModel.mResids->GetNParam();
+    cRegArchGradient myGradData(theModel.GetNLags(), myNMeanParam, myNParam - myNMeanParam - myNDistrParam, myNDistrParam);
+    cDVector myGradlt(myNParam);
+    const gsl_vector* myG = myGradlt.GetGSLVector();
+
+    double myLLH = 0.0;
+    for (uint t = 0; t < myNObs; t++)
+    {
+        double mylt;
+        RegArchLtAndGradLt((int)t, theModel, theValue, myGradData, mylt, myGradlt);
+        if (theLt != NULL)
+            theLt[t * theLtStride] = mylt;
+        double* myRow = theScore + t * theScoreStride;
+        for (uint i = 0; i < myNParam; i++)
+            myRow[i] = myG->data[i * myG->stride];
+        myLLH += mylt;
+    }
+    return myLLH;
+}
+
+double RegArchLtSeries(cRegArchModel& theModel, cRegArchValue& theValue, double* theLt, size_t theLtStride,
+    double* theScore, size_t theScoreStride)
+{
+    if (theScore == NULL)
+        return LLHBatch(theModel, theValue, theLt, theLtStride);
+    // Pure C++ models: the pass does not need the interpreter
+    if (!HasPythonComponent(theModel) && Py_IsInitialized() && PyGILState_Check())
+    {
+        cScopedGILRelease myNoGIL;
+        return SumLtAndScore(theModel, theValue, theLt, theLtStride, theScore, theScoreStride);
+    }
+    return SumLtAndScore(theModel, theValue, theLt, theLtStride, theScore, theScoreStride);
+}
@@ -0,0 +1,49 @@
+#ifndef _REGARCHBATCHCOMPUTE_H_
+#define _REGARCHBATCHCOMPUTE_H_
+
+#include "StdAfxRegArchLib.h"
+
+/*!
+ * \file RegArchBatchCompute.h
+ * \brief Likelihood driver using the batched Python overrides.
+ *
+ * A Python subclass of cAbstCondVar may define, next to compute_var,
+ *
+ *     def compute_var_series(self, data, start, end)
+ *
+ * which computes h(t) for t in [start, end) in one call: either by writing
+ * into data.ht_view (a NumPy view on mHt) or by returning the end - start
+ * values. A Python subclass of cAbstCondMean may define compute_mean_series
+ * in the same way, returning its contribution to m(t); it must then not
+ * depend on u(t) (no MA-type term), since the residuals are only known once
+ * all the means are computed.
+ *
+ * A Python subclass of cAbstResiduals may register a native log-density
+ * (set_native_density): it is then evaluated over the whole sample in one
+ * C call, and with a C++ mean and variance the pass runs without the GIL.
+ *
+ * The overrides are looked up once per evaluation. Models without any
+ * series override or native density, and models whose mean depends on h(t)
+ * (eVarInMean, eStdDevInMean), go through RegArchLLH unchanged.
+ *
+ * RegArchLtSeries runs the same pass but keeps the contribution l(t) of
+ * every date and, on request, the score grad l(t) (one RegArchLtAndGradLt
+ * per date, in order). Without Python component the pass releases the GIL.
+ */
+
+/*! True if one of the Python components of theModel defines a series override */
+extern bool HasPySeriesHook(const RegArchLib::cRegArchModel& theModel);
+
+/*! Same result as RegArchLLH, using the series overrides when available */
+extern double RegArchLLHBatch(const RegArchLib::cRegArchModel& theModel, RegArchLib::cRegArchValue& theValue);
+
+/*!
+ * l(t) of every date at theLt[t * theLtStride] (theLt may be NULL with
+ * theScore). With theScore, grad l(t) is written at
+ * theScore + t * theScoreStride (GetNParam() contiguous doubles).
+ * \return the log-likelihood
+ */
+extern double RegArchLtSeries(RegArchLib::cRegArchModel& theModel, RegArchLib::cRegArchValue& theValue,
+    double* theLt, size_t theLtStride = 1, double* theScore = NULL, size_t theScoreStride = 0);
+
+#endif // _REGARCHBATCHCOMPUTE_H_
@@ -3,6 +3,8 @@
 #include <boost/python/wrapper.hpp>
 #include <boost/python/extract.hpp>
 #include "PythonConversion.h"  // Include your conversion helpers
+#include "RegArchBatchCompute.h"
+#include <cstring>
 
 using namespace boost::python;
 using namespace RegArchLib;
@@ -129,6 +131,55 @@ typedef void (*NumericRegArchHessLLHoldFunc)(cRegArchModel&, cRegArchValue&, cDM
 typedef void (*RegArchComputeIAndJFunc)(cRegArchModel&, cRegArchValue&, cDMatrix&, cDMatrix&);
 typedef void (*RegArchStatTableFunc)(cRegArchModel&, cRegArchValue&, cDMatrix&);
 
+// Writable float64 output of RegArchLtSeries, released on exit
+typedef struct sLtOutput
+{
+    Py_buffer mBuf;
+    bool mHeld;
+    sLtOutput() : mHeld(false) {}
+    ~sLtOutput() { if (mHeld) PyBuffer_Release(&mBuf); }
+} sLtOutput;
+
+// theOut must hold theNRow (x theNCol) doubles, rows may be strided; returns the row stride in doubles
+static size_t LtSeries_Output(const object& theOut, sLtOutput& theRes, size_t theNRow, size_t theNCol, const char* theName)
+{
+    if (PyObject_GetBuffer(theOut.ptr(), &theRes.mBuf, PyBUF_WRITABLE | PyBUF_FORMAT | PyBUF_STRIDES) != 0)
+        throw_error_already_set();
+    theRes.mHeld = true;
+    const Py_buffer& myBuf = theRes.mBuf;
+    int myNDim = (theNCol > 0) ? 2 : 1;
+    bool myOk = myBuf.ndim == myNDim && myBuf.itemsize == sizeof(double) && myBuf.format != NULL
+        && (strcmp(myBuf.format, "d") == 0 || strcmp(myBuf.format, "<d") == 0 || strcmp(myBuf.format, "=d") == 0);
+    if (!myOk)
+        throw std::invalid_argument(std::string("RegArchLtSeries: ") + theName + " must be a " + (myNDim == 2 ? "2-D" : "1-D") + " float64 array");
+    if ((size_t)myBuf.shape[0] != theNRow || (myNDim == 2 && (size_t)myBuf.shape[1] != theNCol))
+        throw std::invalid_argument(std::string("RegArchLtSeries: ") + theName + " must have shape ("
+            + std::to_string(theNRow) + (myNDim == 2 ? ", " + std::to_string(theNCol) : std::string(",")) + ")");
+    if (myBuf.strides[0] <= 0 || myBuf.strides[0] % sizeof(double) != 0 || (myNDim == 2 && myBuf.strides[1] != sizeof(double)))
+        throw std::invalid_argument(std::string("RegArchLtSeries: the rows of ") + theName + " must be contiguous");
+    return (size_t)myBuf.strides[0] / sizeof(double);
+}
+
+static object RegArchLtSeries_py(cRegArchModel& theModel, cRegArchValue& theValue, object theLt, object theScore)
+{
+    size_t myNObs = theValue.mYt.GetSize();
+    size_t myNParam = theModel.GetNParam();
+    bool myWithScore = !theScore.is_none() && theScore.ptr() != Py_False;
+    if (theLt.is_none())
+        theLt = make_double_array(myNObs);
+    if (theScore.ptr() == Py_True)
+        theScore = make_double_array(myNObs, myNParam);
+
+    sLtOutput myLt, myScore;
+    size_t myLtStride = LtSeries_Output(theLt, myLt, myNObs, 0, "lt");
+    size_t myScoreStride = myWithScore ? LtSeries_Output(theScore, myScore, myNObs, myNParam, "score") : 0;
+    RegArchLtSeries(theModel, theValue, static_cast<double*>(myLt.mBuf.buf), myLtStride,
+        myWithScore ? static_cast<double*>(myScore.mBuf.buf) : NULL, myScoreStride);
+    if (myWithScore)
+        return make_tuple(theLt, theScore);
+    return theLt;
+}
+
 // 4. Export function
 void export_RegArchCompute()
 {
@@ -156,7 +207,20 @@ void export_RegArchCompute()
 
     // Export LLH functions:
     def("RegArchLLH", static_cast<LLHFunc1>(RegArchLLH));
-    def("RegArchLLH_from_value", static_cast<LLHFunc2>(RegArchLLH));
+    // Uses compute_var_series / compute_mean_series when a Python component defines them
+    def("RegArchLLH_from_value", &RegArchLLHBatch);
+    def("RegArchLtSeries", &RegArchLtSeries_py,
+        (boost::python::arg("model"), boost::python::arg("value"), boost::python::arg("lt") = object(),
+            boost::python::arg("score") = false),
+        "Log-likelihood contribution l(t) of every date, in one pass over the data.\n\n"
+        "  lt: None for a new float64 array of length n, or a writable float64\n"
+        "      array of length n written in place\n"
+        "  score: False, True for a new n x k array of the gradients of l(t)\n"
+        "      (k = model.get_n_param()), or a writable n x k float64 array\n"
+        "      with contiguous rows written in place\n\n"
+        "Returns lt, or (lt, score) when score is requested. sum(lt) is\n"
+        "RegArchLLH_from_value(model, value), score.T @ score / n the outer product\n"
+        "of gradients. The GIL is released when the model has no Python component.");
 
     // Export FillValue functions:
     def("FillValue", static_cast<FillValueFunc>(FillValue));
@@ -185,4 +249,4 @@ void export_RegArchCompute()
     def("NumericRegArchHessLLHold", static_cast<NumericRegArchHessLLHoldFunc>(NumericRegArchHessLLHold));
     def("RegArchComputeIAndJ", static_cast<RegArchComputeIAndJFunc>(RegArchComputeIAndJ));
     def("RegArchStatTable", static_cast<RegArchStatTableFunc>(RegArchStatTable));
-}
\ No newline at end of file
+}
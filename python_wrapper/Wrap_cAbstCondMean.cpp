@@ -13,6 +13,8 @@
 
  // 1) Include our new helper header:
 #include "PythonConversion.h"
+#include "cParamDispatch.h"
+#include "cRegArchSerial.h"
 
 using namespace boost::python;
 using namespace RegArchLib;
@@ -22,13 +24,19 @@ using namespace RegArchLib;
  * A trampoline class to wrap cAbstCondMean in Boost.Python.
  * This allows Python classes to inherit from cAbstCondMean and override its methods.
  */
-struct cAbstCondMeanWrap : public cAbstCondMean, wrapper<cAbstCondMean>
+struct cAbstCondMeanWrap : public cAbstCondMean, wrapper<cAbstCondMean>, public cPySeriesHook
 {
     // Constructor matching cAbstCondMean(eCondMeanEnum)
     cAbstCondMeanWrap(eCondMeanEnum theType = eUnknown)
         : cAbstCondMean(theType)
     {}
 
+    // Optional batched override, looked up once per evaluation by the drivers
+    virtual object GetPyOverride(const char* theName) const override
+    {
+        return this->get_override(theName);
+    }
+
     // For pure virtual methods, we need a default implementation for when Python
     // doesn't override them. These implementations will throw exceptions.
 
@@ -175,6 +183,7 @@ struct cAbstCondMeanWrap : public cAbstCondMean, wrapper<cAbstCondMean>
     //--- Other pure virtuals ---
     virtual double ComputeMean(uint theDate, const cRegArchValue& theData) const override
     {
+        REGARCH_PROFILE_SCOPE("mean", PyOwnerTypeName(*this), "ComputeMean");
         if (override f = this->get_override("compute_mean"))
             return f(theDate, boost::cref(theData));
         throw std::runtime_error("Implementation needed: You must override the 'compute_mean' method in your Python class");
@@ -196,6 +205,7 @@ struct cAbstCondMeanWrap : public cAbstCondMean, wrapper<cAbstCondMean>
 
     virtual void ComputeGrad(uint theDate, const cRegArchValue& theData, cRegArchGradient& theGradData, uint theBegIndex) override
     {
+        REGARCH_PROFILE_SCOPE("mean", PyOwnerTypeName(*this), "ComputeGrad");
         if (override f = this->get_override("compute_grad"))
             f(theDate, boost::cref(theData), boost::ref(theGradData), theBegIndex);
         else
@@ -237,6 +247,7 @@ struct cAbstCondMeanWrap : public cAbstCondMean, wrapper<cAbstCondMean>
     virtual void ComputeHess(uint theDate, const cRegArchValue& theData, const cRegArchGradient& theGradData,
         cRegArchHessien& theHessData, uint theBegIndex) override
     {
+        REGARCH_PROFILE_SCOPE("mean", PyOwnerTypeName(*this), "ComputeHess");
         if (override f = this->get_override("compute_hess"))
             f(theDate, boost::cref(theData), boost::cref(theGradData), boost::ref(theHessData), theBegIndex);
         else
@@ -246,6 +257,7 @@ struct cAbstCondMeanWrap : public cAbstCondMean, wrapper<cAbstCondMean>
     virtual void ComputeGradAndHess(uint theDate, const cRegArchValue& theData, cRegArchGradient& theGradData,
         cRegArchHessien& theHessData, uint theBegIndex) override
     {
+        REGARCH_PROFILE_SCOPE("mean", PyOwnerTypeName(*this), "ComputeGradAndHess");
         if (override f = this->get_override("compute_grad_and_hess"))
             f(theDate, boost::cref(theData), boost::ref(theGradData), boost::ref(theHessData), theBegIndex);
         else
@@ -298,160 +310,56 @@ boost::python::list get_param_names_py(cAbstCondMean& self, uint theIndex)
 // -------------------------------------------------------------------------
 void cAbstCondMean_set(cAbstCondMean& self, const object& arg1, const object& arg2, const object& arg3 = object())
 {
-    extract<cDVector> vector_extract(arg1);
-    extract<double>   value_extract(arg1);
-
-    // Check if second argument is a string or a uint
-    extract<std::string> name_extract(arg2);
-    extract<uint>        index_extract(arg2);
-
-    // First try direct conversions
-    if (vector_extract.check())
-    {
-        // The user gave us a cDVector from Python side
-        cDVector vector = vector_extract();
-
-        if (name_extract.check()) {
-            std::string name = name_extract();
-            self.Set(vector, name);
-        }
-        else if (index_extract.check()) {
-            uint param_num = index_extract();
-            self.Set(vector, param_num);
-        }
-        else {
-            throw std::runtime_error("Second argument must be either a parameter name (string) or parameter number (uint)");
-        }
-    }
-    else if (value_extract.check())
-    {
-        // The user gave us a scalar (double)
-        double value = value_extract();
-
-        if (name_extract.check()) {
-            std::string name = name_extract();
-            uint index = 0;
-            if (arg3 != object()) {
-                index = extract<uint>(arg3);
-            }
-            self.Set(value, name, index);
-        }
-        else if (index_extract.check()) {
-            uint index = index_extract();
-            uint param_num = 0;
-            if (arg3 != object()) {
-                param_num = extract<uint>(arg3);
-            }
-            self.Set(value, index, param_num);
-        }
-        else {
-            throw std::runtime_error("Second argument must be either a parameter name (string) or parameter index (uint)");
-        }
-    }
-    else
-    {
-        // Try list/tuple fallback
-        if (PyList_Check(arg1.ptr()) || PyTuple_Check(arg1.ptr()))
-        {
-            // Convert the python sequence to cDVector:
-            cDVector vector = py_list_or_tuple_to_cDVector(arg1);
-
-            if (name_extract.check()) {
-                self.Set(vector, name_extract());
-            }
-            else if (index_extract.check()) {
-                self.Set(vector, index_extract());
-            }
-            else {
-                throw std::runtime_error("Second argument must be either a parameter name (string) or parameter number (uint)");
-            }
-        }
-        else {
-            throw std::runtime_error("First argument must be float, cDVector, or a Python list/tuple of floats");
-        }
-    }
+    ParamSet(self, arg1, arg2, arg3, eParamNumFirst);
 }
 
 // Helper function to create a unified 'get' method with appropriate Python behavior
 object cAbstCondMean_get(cAbstCondMean& self, const object& arg1, const object& arg2 = object())
 {
-    extract<std::string> name_extract(arg1);
-    extract<uint>        param_extract(arg1);
-
-    if (name_extract.check())
-    {
-        // Getting by name
-        std::string name = name_extract();
-        if (arg2 == object())
-        {
-            // Return the entire vector
-            try {
-                return object(boost::ref(self.Get(name)));
-            }
-            catch (const std::exception& e) {
-                PyErr_SetString(PyExc_KeyError,
-                    (std::string("Parameter name not found: ") + name).c_str());
-                throw_error_already_set();
-                return object();
-            }
-        }
-        else
-        {
-            // Return a specific value by index
-            uint index = extract<uint>(arg2);
-            try {
-                return object(self.Get(name, index));
-            }
-            catch (const std::exception& e) {
-                PyErr_SetString(PyExc_IndexError,
-                    (std::string("Parameter or index not found: ") + name +
-                        ", index " + std::to_string(index)).c_str());
-                throw_error_already_set();
-                return object();
-            }
-        }
-    }
-    else if (param_extract.check())
-    {
-        // Getting by param_num
-        uint param_num = param_extract();
-        if (arg2 == object())
-        {
-            // Return the entire vector
-            try {
-                return object(boost::ref(self.Get(param_num)));
-            }
-            catch (const std::exception& e) {
-                PyErr_SetString(PyExc_IndexError,
-                    (std::string("Parameter number not found: ") +
-                        std::to_string(param_num)).c_str());
-                throw_error_already_set();
-                return object();
-            }
-        }
-        else
-        {
-            // Return a specific value by index
-            uint index = extract<uint>(arg2);
-            try {
-                return object(self.Get(index, param_num));
-            }
-            catch (const std::exception& e) {
-                PyErr_SetString(PyExc_IndexError,
-                    (std::string("Parameter or index not found: param ") +
-                        std::to_string(param_num) + ", index " +
-                        std::to_string(index)).c_str());
-                throw_error_already_set();
-                return object();
-            }
-        }
-    }
-    else
-    {
+    // Argument errors are reported as such, only the lookup is translated below
+    PyObject* key = arg1.ptr();
+    if (!PyUnicode_Check(key) && !PyLong_Check(key) && !PyIndex_Check(key))
         throw std::runtime_error("First argument must be either a parameter name (string) or parameter number (uint)");
+    ParamUint(arg2.ptr(), 0, "Second argument must be an index (uint)");
+    try {
+        return ParamGet(self, arg1, arg2, eParamNumFirst);
+    }
+    catch (const error_already_set&) {
+        throw;
+    }
+    catch (const std::exception&) {
+        // An unknown name is a KeyError, a parameter or index out of range an IndexError
+        extract<std::string> name_extract(arg1);
+        std::string what;
+        if (name_extract.check())
+            what = arg2.is_none() ? "Parameter name not found: " + name_extract()
+                : "Parameter or index not found: " + name_extract() + ", index " + std::string(extract<std::string>(str(arg2)));
+        else
+            what = arg2.is_none() ? "Parameter number not found: " + std::string(extract<std::string>(str(arg1)))
+                : "Parameter or index not found: param " + std::string(extract<std::string>(str(arg1)))
+                    + ", index " + std::string(extract<std::string>(str(arg2)));
+        PyErr_SetString(name_extract.check() && arg2.is_none() ? PyExc_KeyError : PyExc_IndexError, what.c_str());
+        throw_error_already_set();
+        return object();
     }
 }
 
+// Pickle support: the component is rebuilt from its type, see cRegArchSerial.h
+static object cAbstCondMean_reduce(cAbstCondMean& self)
+{
+    if (dynamic_cast<boost::python::detail::wrapper_base*>(&self) != NULL)
+        throw std::runtime_error("A mean component written in Python cannot be pickled");
+    std::string myState;
+    SerializeCondMean(self, myState);
+    object myRestore = import("regarch_wrapper").attr("_cond_mean_from_bytes");
+    return boost::python::make_tuple(myRestore, boost::python::make_tuple(make_py_bytes(myState)));
+}
+
+static cAbstCondMean* cAbstCondMean_from_bytes(const object& theState)
+{
+    return NewCondMean(py_bytes_to_string(theState));
+}
+
 void export_cAbstCondMean()
 {
     class_<cAbstCondMeanWrap, boost::noncopyable>("cAbstCondMean",
@@ -522,5 +430,12 @@ void export_cAbstCondMean()
         .def("compute_grad_and_hess",
             pure_virtual(&cAbstCondMean::ComputeGradAndHess),
             (boost::python::arg("date"), boost::python::arg("data"), boost::python::arg("grad_data"), boost::python::arg("hess_data"), boost::python::arg("beg_index")))
+
+        // Pickle support, only for the RegArchLib components
+        .def("__reduce__", &cAbstCondMean_reduce)
         ;
+
+    // Used by __reduce__ to rebuild a pickled conditional mean component
+    def("_cond_mean_from_bytes", &cAbstCondMean_from_bytes, boost::python::arg("state"),
+        return_value_policy<manage_new_object>());
 }
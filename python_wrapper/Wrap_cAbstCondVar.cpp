@@ -12,6 +12,8 @@
 
  // Include the new helper:
 #include "PythonConversion.h"
+#include "cParamDispatch.h"
+#include "cRegArchSerial.h"
 
 using namespace boost::python;
 using namespace RegArchLib;
@@ -19,13 +21,19 @@ using namespace RegArchLib;
 /*!
  * A trampoline class to wrap cAbstCondVar in Boost.Python.
  */
-struct cAbstCondVarWrap : public cAbstCondVar, wrapper<cAbstCondVar>
+struct cAbstCondVarWrap : public cAbstCondVar, wrapper<cAbstCondVar>, public cPySeriesHook
 {
     // Constructor matching cAbstCondVar(eCondVarEnum)
     cAbstCondVarWrap(eCondVarEnum theType = eNotKnown)
         : cAbstCondVar(theType)
     {}
 
+    // Optional batched override, looked up once per evaluation by the drivers
+    virtual object GetPyOverride(const char* theName) const override
+    {
+        return this->get_override(theName);
+    }
+
     // Override Print(ostream&) to call Python "print" method if defined.
     virtual void Print(ostream& theOut) const override
     {
@@ -172,6 +180,7 @@ struct cAbstCondVarWrap : public cAbstCondVar, wrapper<cAbstCondVar>
     //--- Other pure virtuals ---
     virtual double ComputeVar(uint theDate, const cRegArchValue& theData) const override
     {
+        REGARCH_PROFILE_SCOPE("var", PyOwnerTypeName(*this), "ComputeVar");
         if (override f = this->get_override("compute_var"))
             return f(theDate, boost::cref(theData));
         throw std::runtime_error("Python class must implement 'compute_var' method");
@@ -194,6 +203,7 @@ struct cAbstCondVarWrap : public cAbstCondVar, wrapper<cAbstCondVar>
     virtual void ComputeGrad(uint theDate, const cRegArchValue& theData,
         cRegArchGradient& theGradData, cAbstResiduals* theResiduals = NULL) override
     {
+        REGARCH_PROFILE_SCOPE("var", PyOwnerTypeName(*this), "ComputeGrad");
         if (override f = this->get_override("compute_grad"))
             f(theDate, boost::cref(theData), boost::ref(theGradData), ptr(theResiduals));
         else
@@ -236,6 +246,7 @@ struct cAbstCondVarWrap : public cAbstCondVar, wrapper<cAbstCondVar>
         const cRegArchGradient& theGradData, cRegArchHessien& theHessData,
         cAbstResiduals* theResiduals = NULL) override
     {
+        REGARCH_PROFILE_SCOPE("var", PyOwnerTypeName(*this), "ComputeHess");
         if (override f = this->get_override("compute_hess"))
             f(theDate, boost::cref(theData), boost::cref(theGradData), boost::ref(theHessData), ptr(theResiduals));
         else
@@ -246,6 +257,7 @@ struct cAbstCondVarWrap : public cAbstCondVar, wrapper<cAbstCondVar>
         cRegArchGradient& theGradData, cRegArchHessien& theHessData,
         cAbstResiduals* theResiduals = NULL) override
     {
+        REGARCH_PROFILE_SCOPE("var", PyOwnerTypeName(*this), "ComputeGradAndHess");
         if (override f = this->get_override("compute_grad_and_hess"))
             f(theDate, boost::cref(theData), boost::ref(theGradData), boost::ref(theHessData), ptr(theResiduals));
         else
@@ -289,68 +301,7 @@ boost::python::list get_param_names_py(cAbstCondVar& self, uint theIndex)
 // -------------------------------------------------------------------------
 void cAbstCondVar_set(cAbstCondVar& self, const object& arg1, const object& arg2, const object& arg3 = object())
 {
-    extract<cDVector> vector_extract(arg1);
-    extract<double>   value_extract(arg1);
-
-    // Check if second argument is a string or a uint
-    extract<std::string> name_extract(arg2);
-    extract<uint>        index_extract(arg2);
-
-    if (vector_extract.check())
-    {
-        cDVector vector = vector_extract();
-        if (name_extract.check()) {
-            self.Set(vector, name_extract());
-        }
-        else if (index_extract.check()) {
-            self.Set(vector, index_extract());
-        }
-        else {
-            throw std::runtime_error("Second argument must be either a parameter name (string) or parameter number (uint)");
-        }
-    }
-    else if (value_extract.check())
-    {
-        double value = value_extract();
-        if (name_extract.check()) {
-            uint idx = 0;
-            if (arg3 != object()) {
-                idx = extract<uint>(arg3);
-            }
-            self.Set(value, name_extract(), idx);
-        }
-        else if (index_extract.check()) {
-            uint idx_param = 0;
-            if (arg3 != object()) {
-                idx_param = extract<uint>(arg3);
-            }
-            self.Set(value, index_extract(), idx_param);
-        }
-        else {
-            throw std::runtime_error("Second argument must be either a parameter name (string) or parameter index (uint)");
-        }
-    }
-    else
-    {
-        // fallback for python list or tuple
-        if (PyList_Check(arg1.ptr()) || PyTuple_Check(arg1.ptr()))
-        {
-            cDVector vector = py_list_or_tuple_to_cDVector(arg1);
-
-            if (name_extract.check()) {
-                self.Set(vector, name_extract());
-            }
-            else if (index_extract.check()) {
-                self.Set(vector, index_extract());
-            }
-            else {
-                throw std::runtime_error("Second argument must be either a parameter name (string) or parameter number (uint)");
-            }
-        }
-        else {
-            throw std::runtime_error("First argument must be a float, cDVector, or a Python list/tuple of floats");
-        }
-    }
+    ParamSet(self, arg1, arg2, arg3, eParamNumFirst);
 }
 
 // -------------------------------------------------------------------------
@@ -358,69 +309,29 @@ void cAbstCondVar_set(cAbstCondVar& self, const object& arg1, const object& arg2
 // -------------------------------------------------------------------------
 void cAbstCondVar_realloc(cAbstCondVar& self, const object& arg1, const object& arg2 = object())
 {
-    extract<cDVector> vector_extract(arg1);
-    extract<uint>     size_extract(arg1);
-
-    uint param_num = 0;
-    if (arg2 != object()) {
-        param_num = extract<uint>(arg2);
-    }
-
-    if (vector_extract.check())
-    {
-        cDVector vector = vector_extract();
-        self.ReAlloc(vector, param_num);
-    }
-    else if (size_extract.check())
-    {
-        uint size = size_extract();
-        self.ReAlloc(size, param_num);
-    }
-    else
-    {
-        // fallback for python list or tuple
-        if (PyList_Check(arg1.ptr()) || PyTuple_Check(arg1.ptr()))
-        {
-            cDVector vector = py_list_or_tuple_to_cDVector(arg1);
-            self.ReAlloc(vector, param_num);
-        }
-        else {
-            throw std::runtime_error("First argument must be a uint size, cDVector, or a Python list/tuple of floats");
-        }
-    }
+    ParamReAlloc(self, arg1, arg2);
 }
 
 
 object cAbstCondVar_get(cAbstCondVar& self, const object& arg1, const object& arg2 = object())
 {
-    extract<std::string> name_extract(arg1);
-    extract<uint>        param_extract(arg1);
+    return ParamGet(self, arg1, arg2, eParamNumFirst);
+}
 
-    if (name_extract.check())
-    {
-        std::string name = name_extract();
-        if (arg2 == object()) {
-            return object(boost::ref(self.Get(name)));
-        }
-        else {
-            uint index = extract<uint>(arg2);
-            return object(self.Get(name, index));
-        }
-    }
-    else if (param_extract.check())
-    {
-        uint param_num = param_extract();
-        if (arg2 == object()) {
-            return object(boost::ref(self.Get(param_num)));
-        }
-        else {
-            uint index = extract<uint>(arg2);
-            return object(self.Get(index, param_num));
-        }
-    }
-    else {
-        throw std::runtime_error("First argument must be either a parameter name (string) or parameter number (uint)");
-    }
+// Pickle support: the component is rebuilt from its type, see cRegArchSerial.h
+static object cAbstCondVar_reduce(cAbstCondVar& self)
+{
+    if (dynamic_cast<boost::python::detail::wrapper_base*>(&self) != NULL)
+        throw std::runtime_error("A variance component written in Python cannot be pickled");
+    std::string myState;
+    SerializeCondVar(self, myState);
+    object myRestore = import("regarch_wrapper").attr("_cond_var_from_bytes");
+    return boost::python::make_tuple(myRestore, boost::python::make_tuple(make_py_bytes(myState)));
+}
+
+static cAbstCondVar* cAbstCondVar_from_bytes(const object& theState)
+{
+    return NewCondVar(py_bytes_to_string(theState));
 }
 
 void export_cAbstCondVar()
@@ -479,5 +390,12 @@ void export_cAbstCondVar()
         .def("compute_grad_and_hess",
             pure_virtual(&cAbstCondVar::ComputeGradAndHess),
             (boost::python::arg("date"), boost::python::arg("data"), boost::python::arg("grad_data"), boost::python::arg("hess_data"), boost::python::arg("residuals") = object()))
+
+        // Pickle support, only for the RegArchLib components
+        .def("__reduce__", &cAbstCondVar_reduce)
         ;
+
+    // Used by __reduce__ to rebuild a pickled conditional variance component
+    def("_cond_var_from_bytes", &cAbstCondVar_from_bytes, boost::python::arg("state"),
+        return_value_policy<manage_new_object>());
 }
@@ -3,13 +3,16 @@
 #include <boost/python/wrapper.hpp>
 #include <boost/python/extract.hpp>
 
+#include "PythonConversion.h"
+#include "cRegArchSerial.h"
+
 using namespace boost::python;
 using namespace RegArchLib;
 
 /*!
  * A trampoline class to wrap cAbstResiduals in Boost.Python.
  */
-struct cAbstResidualsWrap : public cAbstResiduals, wrapper<cAbstResiduals>
+struct cAbstResidualsWrap : public cAbstResiduals, wrapper<cAbstResiduals>, public cNativeDensityHook
 {
     // Constructor matching: cAbstResiduals(eDistrTypeEnum, cDVector*, bool)
     cAbstResidualsWrap(eDistrTypeEnum theDistr, cDVector* theDistrParam = 0, bool theSimulFlag = false)
@@ -42,6 +45,10 @@ struct cAbstResidualsWrap : public cAbstResiduals, wrapper<cAbstResiduals>
     }
 
     virtual double LogDensity(double theX) const override {
+        REGARCH_PROFILE_SCOPE("resid", PyOwnerTypeName(*this), "LogDensity");
+        double myRes;
+        if (EvalNative(eNativeLogDensity, theX, myRes))
+            return myRes;
         if (override f = this->get_override("log_density"))
             return f(theX);
         throw std::runtime_error("Python class must implement 'log_density' method");
@@ -54,6 +61,10 @@ struct cAbstResidualsWrap : public cAbstResiduals, wrapper<cAbstResiduals>
     }
 
     virtual double DiffLogDensity(double theX) const override {
+        REGARCH_PROFILE_SCOPE("resid", PyOwnerTypeName(*this), "DiffLogDensity");
+        double myRes;
+        if (EvalNative(eNativeDiffLogDensity, theX, myRes))
+            return myRes;
         if (override f = this->get_override("diff_log_density"))
             return f(theX);
         throw std::runtime_error("Python class must implement 'diff_log_density' method");
@@ -108,6 +119,10 @@ struct cAbstResidualsWrap : public cAbstResiduals, wrapper<cAbstResiduals>
     }
 
     virtual double Diff2LogDensity(double theX) const override {
+        REGARCH_PROFILE_SCOPE("resid", PyOwnerTypeName(*this), "Diff2LogDensity");
+        double myRes;
+        if (EvalNative(eNativeDiff2LogDensity, theX, myRes))
+            return myRes;
         if (override f = this->get_override("diff2_log_density"))
             return f(theX);
         throw std::runtime_error("Python class must implement 'diff2_log_density' method");
@@ -165,8 +180,55 @@ struct cAbstResidualsWrap : public cAbstResiduals, wrapper<cAbstResiduals>
             cAbstResiduals::NumericComputeGrad(theDate, theData, theGradData, theBegIndex, theNumDeriv);
         }
     }
+
+    // Python objects behind the native pointers, kept alive while registered
+    object mvNativeOwner[eNativeDensityCount];
 };
 
+/*!
+ * Address of a native callback: an integer, a Numba cfunc (.address) or a
+ * ctypes function pointer. cffi users pass int(ffi.cast("uintptr_t", f)).
+ */
+static uintptr_t NativeAddress(const object& theFunc)
+{
+    extract<uintptr_t> myInt(theFunc);
+    if (myInt.check())
+        return myInt();
+    if (PyObject_HasAttrString(theFunc.ptr(), "address"))
+        return extract<uintptr_t>(theFunc.attr("address"));
+    object myCtypes = import("ctypes");
+    object myAddr = myCtypes.attr("cast")(theFunc, myCtypes.attr("c_void_p")).attr("value");
+    if (myAddr.is_none())
+        throw std::runtime_error("Native density: null function pointer.");
+    return extract<uintptr_t>(myAddr);
+}
+
+static void SetNativeDensity(cAbstResidualsWrap& self, eNativeDensityEnum theWhich, object theFunc, bool theArray)
+{
+    if (theWhich < 0 || theWhich >= eNativeDensityCount)
+        throw std::runtime_error("Native density: unknown kind.");
+    self.mvScalar[theWhich] = NULL;
+    self.mvArray[theWhich] = NULL;
+    self.mvNativeOwner[theWhich] = object();
+    if (theFunc.is_none())
+        return;
+    uintptr_t myAddr = NativeAddress(theFunc);
+    if (myAddr == 0)
+        return;
+    if (theArray)
+        self.mvArray[theWhich] = reinterpret_cast<tNativeArrayDensity>(myAddr);
+    else
+        self.mvScalar[theWhich] = reinterpret_cast<tNativeScalarDensity>(myAddr);
+    self.mvNativeOwner[theWhich] = theFunc;
+}
+
+static bool HasNativeDensity(const cAbstResidualsWrap& self, eNativeDensityEnum theWhich)
+{
+    if (theWhich < 0 || theWhich >= eNativeDensityCount)
+        return false;
+    return self.HasNative(theWhich);
+}
+
 // Helper function to get parameter names as a Python list
 boost::python::list get_param_names_py(cAbstResiduals& self, uint theIndex)
 {
@@ -184,8 +246,29 @@ boost::python::list get_param_names_py(cAbstResiduals& self, uint theIndex)
     return result;
 }
 
+// Pickle support: the component is rebuilt from its type, see cRegArchSerial.h
+static object cAbstResiduals_reduce(cAbstResiduals& self)
+{
+    if (dynamic_cast<boost::python::detail::wrapper_base*>(&self) != NULL)
+        throw std::runtime_error("A residuals component written in Python cannot be pickled");
+    std::string myState;
+    SerializeResiduals(self, myState);
+    object myRestore = import("regarch_wrapper").attr("_residuals_from_bytes");
+    return boost::python::make_tuple(myRestore, boost::python::make_tuple(make_py_bytes(myState)));
+}
+
+static cAbstResiduals* cAbstResiduals_from_bytes(const object& theState)
+{
+    return NewResiduals(py_bytes_to_string(theState));
+}
+
 void export_cAbstResiduals()
 {
+    enum_<eNativeDensityEnum>("eNativeDensityEnum", "Functions of a residual distribution that can be native callbacks.")
+        .value("eNativeLogDensity", eNativeLogDensity)
+        .value("eNativeDiffLogDensity", eNativeDiffLogDensity)
+        .value("eNativeDiff2LogDensity", eNativeDiff2LogDensity)
+        ;
 
     class_<cAbstResidualsWrap, boost::noncopyable>("cAbstResiduals",
         "Abstract base class for residual distributions in RegArch.\n\n"
@@ -260,6 +343,26 @@ void export_cAbstResiduals()
             "index : int, optional\n"
             "    The parameter index (default 0)")
 
+        // Native callbacks replacing the Python density overrides
+        .def("set_native_density", &SetNativeDensity,
+            (boost::python::arg("kind"), boost::python::arg("func"), boost::python::arg("array") = false),
+            "Registers a compiled function in place of a density override.\n\n"
+            "The function is called directly from C++, without the GIL, and the\n"
+            "Python method of the same name is no longer used.\n\n"
+            "Parameters\n"
+            "----------\n"
+            "kind : eNativeDensityEnum\n"
+            "    eNativeLogDensity, eNativeDiffLogDensity or eNativeDiff2LogDensity\n"
+            "func : int or callback\n"
+            "    Function address, Numba cfunc or ctypes function pointer. None or 0\n"
+            "    removes the callback. The object is kept alive while registered.\n"
+            "array : bool, optional\n"
+            "    False for double f(double x), True for\n"
+            "    void f(const double* x, double* res, size_t n) (default False)")
+        .def("has_native_density", &HasNativeDensity,
+            boost::python::arg("kind"),
+            "Returns True if a native callback is registered for kind.")
+
         // Helper method for getting parameter names
         .def("get_param_names", &get_param_names_py,
             boost::python::arg("index"),
@@ -437,8 +540,15 @@ void export_cAbstResiduals()
             "    Starting index in the gradient vector\n"
             "num_deriv : cNumericDerivative\n"
             "    Numerical derivative helper object")
+
+        // Pickle support, only for the RegArchLib components
+        .def("__reduce__", &cAbstResiduals_reduce)
         ;
 
+    // Used by __reduce__ to rebuild a pickled residuals component
+    def("_residuals_from_bytes", &cAbstResiduals_from_bytes, boost::python::arg("state"),
+        return_value_policy<manage_new_object>());
+
     // Expose factory functions with disambiguation and an explicit return value policy.
     def("create_real_cond_residuals",
         static_cast<cAbstResiduals * (*)(const eDistrTypeEnum, cDVector*, bool)>(&CreateRealCondResiduals),
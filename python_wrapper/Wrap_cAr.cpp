@@ -5,6 +5,7 @@
 
 // 1) Include your helper header that provides py_list_or_tuple_to_cDVector(...)
 #include "PythonConversion.h"
+#include "cParamDispatch.h"
 
 using namespace boost::python;
 using namespace RegArchLib;
@@ -20,162 +21,19 @@ static void cArPrint(cAr& self)
 // Helper function to allow Python-style overloaded methods
 static void cArSet(cAr& self, const object& value_or_vector, const object& index_or_name, const object& num_param = object())
 {
-    // Check if first argument is a vector or a scalar
-    extract<cDVector> vector_extract(value_or_vector);
-    extract<double>   value_extract(value_or_vector);
-
-    // Check if second argument is a string or an index
-    extract<std::string> name_extract(index_or_name);
-    extract<uint>        index_extract(index_or_name);
-
-    if (vector_extract.check())
-    {
-        // The user directly provided a cDVector
-        cDVector vector = vector_extract();
-
-        if (name_extract.check()) {
-            // Set(cDVector, string)
-            std::string name = name_extract();
-            self.Set(vector, name);
-        }
-        else if (index_extract.check()) {
-            // Set(cDVector, uint)
-            uint num = 0;
-            if (!num_param.is_none())
-                num = extract<uint>(num_param);
-            self.Set(vector, num);
-        }
-        else {
-            throw std::runtime_error("Invalid arguments for set method");
-        }
-    }
-    else if (value_extract.check())
-    {
-        // The user provided a scalar (double)
-        double value = value_extract();
-
-        if (name_extract.check()) {
-            // Set(double, string, uint)
-            std::string name = name_extract();
-            uint index = 0;
-            if (!num_param.is_none())
-                index = extract<uint>(num_param);
-            self.Set(value, name, index);
-        }
-        else if (index_extract.check()) {
-            // Set(double, uint, uint)
-            uint index = index_extract();
-            uint num = 0;
-            if (!num_param.is_none())
-                num = extract<uint>(num_param);
-            self.Set(value, index, num);
-        }
-        else {
-            throw std::runtime_error("Invalid arguments for set method");
-        }
-    }
-    else
-    {
-        // Fallback for a Python list or tuple
-        if (PyList_Check(value_or_vector.ptr()) || PyTuple_Check(value_or_vector.ptr()))
-        {
-            // Convert it to a cDVector
-            cDVector vector = py_list_or_tuple_to_cDVector(value_or_vector);
-
-            if (name_extract.check()) {
-                self.Set(vector, name_extract());
-            }
-            else if (index_extract.check()) {
-                uint num = 0;
-                if (!num_param.is_none())
-                    num = extract<uint>(num_param);
-                self.Set(vector, num);
-            }
-            else {
-                throw std::runtime_error("Invalid arguments for set method (second argument must be string or uint)");
-            }
-        }
-        else {
-            throw std::runtime_error("First argument must be a double, cDVector, or a Python list/tuple of floats");
-        }
-    }
+    ParamSet(self, value_or_vector, index_or_name, num_param, eParamIndexFirst);
 }
 
 // Helper function for get
 static object cArGet(cAr& self, const object& index_or_name, const object& num_param = object())
 {
-    // Check if first argument is a string or an index
-    extract<std::string> name_extract(index_or_name);
-    extract<uint>        index_extract(index_or_name);
-
-    if (name_extract.check())
-    {
-        std::string name = name_extract();
-
-        if (num_param.is_none()) {
-            // Get(string) -> cDVector&
-            return object(boost::ref(self.Get(name)));
-        }
-        else {
-            // Get(string, uint) -> double
-            uint index = extract<uint>(num_param);
-            return object(self.Get(name, index));
-        }
-    }
-    else if (index_extract.check())
-    {
-        uint index = index_extract();
-
-        if (num_param.is_none()) {
-            // Get(uint) -> cDVector&
-            return object(boost::ref(self.Get(index)));
-        }
-        else {
-            // Get(uint, uint) -> double
-            uint num = extract<uint>(num_param);
-            return object(self.Get(index, num));
-        }
-    }
-    else {
-        throw std::runtime_error("First argument must be a string or uint");
-    }
+    return ParamGet(self, index_or_name, num_param, eParamIndexFirst);
 }
 
 // Helper for realloc
 static void cArReAlloc(cAr& self, const object& size_or_vector, const object& num_param = object())
 {
-    // Check if first argument is a vector or a scalar
-    extract<cDVector> vector_extract(size_or_vector);
-    extract<uint>     size_extract(size_or_vector);
-
-    uint param = 0;
-    if (!num_param.is_none())
-        param = extract<uint>(num_param);
-
-    if (vector_extract.check())
-    {
-        // ReAlloc(cDVector, uint)
-        cDVector vector = vector_extract();
-        self.ReAlloc(vector, param);
-    }
-    else if (size_extract.check())
-    {
-        // ReAlloc(uint, uint)
-        uint size = size_extract();
-        self.ReAlloc(size, param);
-    }
-    else
-    {
-        // Fallback for Python list or tuple
-        if (PyList_Check(size_or_vector.ptr()) || PyTuple_Check(size_or_vector.ptr()))
-        {
-            cDVector vector = py_list_or_tuple_to_cDVector(size_or_vector);
-            self.ReAlloc(vector, param);
-        }
-        else {
-            throw std::runtime_error("First argument must be a uint, cDVector, or a Python list/tuple of floats");
-        }
-    }
+    ParamReAlloc(self, size_or_vector, num_param);
 }
 
 void export_cAr()
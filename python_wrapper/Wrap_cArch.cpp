@@ -2,6 +2,7 @@
 #include <boost/python.hpp>
 #include <boost/python/wrapper.hpp>
 #include <boost/python/extract.hpp>
+#include "cParamDispatch.h"
 
 using namespace boost::python;
 using namespace RegArchLib;
@@ -16,123 +17,19 @@ static void cArchPrint(cArch& self) {
 // Helper function for unified parameter setting
 static void cArchSet(cArch& self, const object& value_or_vector, const object& index_or_name, const object& num_param = object())
 {
-    // Check if first argument is a vector or a scalar
-    extract<cDVector> vector_extract(value_or_vector);
-    extract<double> value_extract(value_or_vector);
-
-    // Check if second argument is a string or an index
-    extract<std::string> name_extract(index_or_name);
-    extract<uint> index_extract(index_or_name);
-
-    if (vector_extract.check()) {
-        cDVector vector = vector_extract();
-
-        if (name_extract.check()) {
-            // Set(cDVector, string)
-            std::string name = name_extract();
-            self.Set(vector, name);
-        }
-        else if (index_extract.check()) {
-            // Set(cDVector, uint)
-            uint num = 0;
-            if (!num_param.is_none())
-                num = extract<uint>(num_param);
-            self.Set(vector, num);
-        }
-        else {
-            throw std::runtime_error("Invalid arguments for set method");
-        }
-    }
-    else if (value_extract.check()) {
-        double value = value_extract();
-
-        if (name_extract.check()) {
-            // Set(double, string, uint)
-            std::string name = name_extract();
-            uint index = 0;
-            if (!num_param.is_none())
-                index = extract<uint>(num_param);
-            self.Set(value, name, index);
-        }
-        else if (index_extract.check()) {
-            // Set(double, uint, uint)
-            uint index = index_extract();
-            uint num = 0;
-            if (!num_param.is_none())
-                num = extract<uint>(num_param);
-            self.Set(value, index, num);
-        }
-        else {
-            throw std::runtime_error("Invalid arguments for set method");
-        }
-    }
-    else {
-        throw std::runtime_error("First argument must be a double or cDVector");
-    }
+    ParamSet(self, value_or_vector, index_or_name, num_param, eParamIndexFirst);
 }
 
 // Helper function for unified parameter getting
 static object cArchGet(cArch& self, const object& index_or_name, const object& num_param = object())
 {
-    // Check if first argument is a string or an index
-    extract<std::string> name_extract(index_or_name);
-    extract<uint> index_extract(index_or_name);
-
-    if (name_extract.check()) {
-        std::string name = name_extract();
-
-        if (num_param.is_none()) {
-            // Get(string) -> cDVector&
-            return object(boost::ref(self.Get(name)));
-        }
-        else {
-            // Get(string, uint) -> double
-            uint index = extract<uint>(num_param);
-            return object(self.Get(name, index));
-        }
-    }
-    else if (index_extract.check()) {
-        uint index = index_extract();
-
-        if (num_param.is_none()) {
-            // Get(uint) -> cDVector&
-            return object(boost::ref(self.Get(index)));
-        }
-        else {
-            // Get(uint, uint) -> double
-            uint num = extract<uint>(num_param);
-            return object(self.Get(index, num));
-        }
-    }
-    else {
-        throw std::runtime_error("First argument must be a string or uint");
-    }
+    return ParamGet(self, index_or_name, num_param, eParamIndexFirst);
 }
 
 // Helper for unified realloc
 static void cArchReAlloc(cArch& self, const object& size_or_vector, const object& num_param = object())
 {
-    // Check if first argument is a vector or a scalar
-    extract<cDVector> vector_extract(size_or_vector);
-    extract<uint> size_extract(size_or_vector);
-
-    uint param = 0;
-    if (!num_param.is_none())
-        param = extract<uint>(num_param);
-
-    if (vector_extract.check()) {
-        // ReAlloc(cDVector, uint)
-        cDVector vector = vector_extract();
-        self.ReAlloc(vector, param);
-    }
-    else if (size_extract.check()) {
-        // ReAlloc(uint, uint)
-        uint size = size_extract();
-        self.ReAlloc(size, param);
-    }
-    else {
-        throw std::runtime_error("First argument must be a uint or cDVector");
-    }
+    ParamReAlloc(self, size_or_vector, num_param);
 }
 
 void export_cArch() {
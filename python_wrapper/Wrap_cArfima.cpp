@@ -5,6 +5,7 @@
 
 // 1) Include your helper header that provides py_list_or_tuple_to_cDVector(...)
 #include "PythonConversion.h"
+#include "cParamDispatch.h"
 
 using namespace boost::python;
 using namespace RegArchLib;
@@ -14,84 +15,7 @@ using namespace RegArchLib;
 // ---------------------------------------------------------------------
 static void cArfimaSet(cArfima& self, const object& arg1, const object& arg2, const object& arg3 = object())
 {
-    // Attempt direct extraction as cDVector or double
-    extract<cDVector> vec_extract(arg1);
-    extract<double>   val_extract(arg1);
-
-    // Check second argument for string (param name) or uint (param index)
-    extract<std::string> name_extract(arg2);
-    extract<uint>        index_extract(arg2);
-
-    if (vec_extract.check())
-    {
-        // The user passed a cDVector
-        cDVector vector = vec_extract();
-
-        if (name_extract.check()) {
-            // e.g. set(vector, "ar") or set(vector, "ma"), etc.
-            self.Set(vector, name_extract());
-        }
-        else if (index_extract.check()) {
-            // e.g. set(vector, 0)
-            uint param_num = 0;
-            if (!arg3.is_none())
-                param_num = extract<uint>(arg3);
-            self.Set(vector, param_num);
-        }
-        else {
-            throw std::runtime_error("Second argument must be string (param name) or uint (index) when first arg is a cDVector.");
-        }
-    }
-    else if (val_extract.check())
-    {
-        // The user passed a single scalar (double)
-        double value = val_extract();
-
-        if (name_extract.check()) {
-            // e.g. set(0.5, "ar", 0)
-            uint idx = 0;
-            if (!arg3.is_none())
-                idx = extract<uint>(arg3);
-            self.Set(value, name_extract(), idx);
-        }
-        else if (index_extract.check()) {
-            // e.g. set(0.5, 0, 2)
-            uint idx = index_extract();
-            uint param_num = 0;
-            if (!arg3.is_none())
-                param_num = extract<uint>(arg3);
-            self.Set(value, idx, param_num);
-        }
-        else {
-            throw std::runtime_error("Second argument must be string (param name) or uint (index) when first arg is a double.");
-        }
-    }
-    else
-    {
-        // Fallback if the user passed a Python list or tuple
-        if (PyList_Check(arg1.ptr()) || PyTuple_Check(arg1.ptr()))
-        {
-            cDVector vector = py_list_or_tuple_to_cDVector(arg1);
-
-            if (name_extract.check()) {
-                // e.g. set([0.1, 0.2], "ar")
-                self.Set(vector, name_extract());
-            }
-            else if (index_extract.check()) {
-                // e.g. set([0.1, 0.2], 0)
-                uint param_num = 0;
-                if (!arg3.is_none())
-                    param_num = extract<uint>(arg3);
-                self.Set(vector, param_num);
-            }
-            else {
-                throw std::runtime_error("Second argument must be string or uint when passing a Python list/tuple.");
-            }
-        }
-        else {
-            throw std::runtime_error("First argument must be float, cDVector, or a Python list/tuple of floats.");
-        }
-    }
+    ParamSet(self, arg1, arg2, arg3, eParamNumFirst);
 }
 
 // ---------------------------------------------------------------------
@@ -99,42 +23,7 @@ static void cArfimaSet(cArfima& self, const object& arg1, const object& arg2, co
 // ---------------------------------------------------------------------
 static object cArfimaGet(cArfima& self, const object& arg1, const object& arg2 = object())
 {
-    // Check if first argument is a string or an index
-    extract<std::string> name_extract(arg1);
-    extract<uint>        idx_extract(arg1);
-
-    if (name_extract.check())
-    {
-        // e.g. get("ar") or get("ar", 0)
-        std::string param_name = name_extract();
-
-        if (arg2.is_none()) {
-            // Return the entire vector => cDVector
-            return object(boost::ref(self.Get(param_name)));
-        }
-        else {
-            // Return a single double
-            uint sub_idx = extract<uint>(arg2);
-            return object(self.Get(param_name, sub_idx));
-        }
-    }
-    else if (idx_extract.check())
-    {
-        // e.g. get(0) or get(0, 1)
-        uint param_num = idx_extract();
-        if (arg2.is_none()) {
-            // Return a cDVector
-            return object(boost::ref(self.Get(param_num)));
-        }
-        else {
-            // Return a double
-            uint sub_idx = extract<uint>(arg2);
-            return object(self.Get(sub_idx, param_num));
-        }
-    }
-    else {
-        throw std::runtime_error("First argument must be a string (param name) or uint (param index).");
-    }
+    return ParamGet(self, arg1, arg2, eParamNumFirst);
 }
 
 // ---------------------------------------------------------------------
@@ -142,38 +31,7 @@ static object cArfimaGet(cArfima& self, const object& arg1, const object& arg2 =
 // ---------------------------------------------------------------------
 static void cArfimaReAlloc(cArfima& self, const object& arg1, const object& arg2 = object())
 {
-    // Try to extract a cDVector or uint from the first argument
-    extract<cDVector> vec_extract(arg1);
-    extract<uint>     uint_extract(arg1);
-
-    uint param_num = 0;
-    if (!arg2.is_none())
-        param_num = extract<uint>(arg2);
-
-    if (vec_extract.check())
-    {
-        // ReAlloc(cDVector, uint)
-        cDVector vect = vec_extract();
-        self.ReAlloc(vect, param_num);
-    }
-    else if (uint_extract.check())
-    {
-        // ReAlloc(uint, uint)
-        uint size = uint_extract();
-        self.ReAlloc(size, param_num);
-    }
-    else
-    {
-        // Fallback for Python list or tuple
-        if (PyList_Check(arg1.ptr()) || PyTuple_Check(arg1.ptr()))
-        {
-            cDVector vect = py_list_or_tuple_to_cDVector(arg1);
-            self.ReAlloc(vect, param_num);
-        }
-        else {
-            throw std::runtime_error("First argument must be a uint, cDVector, or a Python list/tuple of floats.");
-        }
-    }
+    ParamReAlloc(self, arg1, arg2);
 }
 
 // ---------------------------------------------------------------------
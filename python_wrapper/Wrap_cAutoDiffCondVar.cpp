@@ -0,0 +1,35 @@
+#include "StdAfxRegArchLib.h"
+#include <boost/python.hpp>
+#include <boost/python/wrapper.hpp>
+#include <boost/python/extract.hpp>
+
+#include "cAutoDiffGarch.h"
+
+using namespace boost::python;
+using namespace RegArchLib;
+
+/*!
+ * Export function for the AD validation models.
+ * They inherit every accessor from cGarch / cTarch, only ComputeGrad,
+ * ComputeHess and ComputeGradAndHess differ.
+ */
+void export_cAutoDiffCondVar()
+{
+    class_<cAutoDiffGarch, bases<cGarch> >("cAutoDiffGarch",
+        "GARCH(p,q) variance model with derivatives from forward-mode automatic differentiation.",
+        init< optional<uint, uint> >(
+            (boost::python::arg("theNArch") = 0, boost::python::arg("theNGarch") = 0),
+            "cAutoDiffGarch(uint p=0, uint q=0)"
+        )
+    )
+        ;
+
+    class_<cAutoDiffTarch, bases<cTarch> >("cAutoDiffTarch",
+        "TARCH(p) variance model with derivatives from forward-mode automatic differentiation.",
+        init< optional<uint> >(
+            (boost::python::arg("theNTarch") = 0),
+            "cAutoDiffTarch(uint p=0)"
+        )
+    )
+        ;
+}
@@ -5,6 +5,7 @@
 
 // 1) Include your helper header for converting Python lists/tuples to cDVector
 #include "PythonConversion.h"
+#include "cParamDispatch.h"
 
 using namespace boost::python;
 using namespace RegArchLib;
@@ -25,86 +26,7 @@ static void cConstCondVarSet(cConstCondVar& self,
     const object& index_or_name,
     const object& num_param = object())
 {
-    extract<cDVector> vec_extract(value_or_vector);
-    extract<double>   val_extract(value_or_vector);
-
-    // Check if second argument is a string or a uint
-    extract<std::string> name_extract(index_or_name);
-    extract<uint>        idx_extract(index_or_name);
-
-    if (vec_extract.check())
-    {
-        // The user passed a cDVector or Python list that auto-converted
-        cDVector vect = vec_extract();
-
-        if (name_extract.check()) {
-            // Set(cDVector, param_name)
-            self.Set(vect, name_extract());
-        }
-        else if (idx_extract.check()) {
-            // Set(cDVector, uint)
-            uint param_num = 0;
-            if (!num_param.is_none())
-                param_num = extract<uint>(num_param);
-            self.Set(vect, param_num);
-        }
-        else {
-            throw std::runtime_error(
-                "cConstCondVar.set(...) usage: second arg must be string or uint when passing a cDVector.");
-        }
-    }
-    else if (val_extract.check())
-    {
-        // The user passed a scalar (float/double)
-        double val = val_extract();
-
-        if (name_extract.check()) {
-            // Set(double, param_name, index)
-            std::string param_name = name_extract();
-            uint idx = 0;
-            if (!num_param.is_none())
-                idx = extract<uint>(num_param);
-            self.Set(val, param_name, idx);
-        }
-        else if (idx_extract.check()) {
-            // Set(double, uint, uint)
-            uint idx = idx_extract();
-            uint param_num = 0;
-            if (!num_param.is_none())
-                param_num = extract<uint>(num_param);
-            self.Set(val, idx, param_num);
-        }
-        else {
-            throw std::runtime_error(
-                "cConstCondVar.set(...) usage: second arg must be string or uint when passing a float.");
-        }
-    }
-    else
-    {
-        // Fallback for Python list/tuple that didn't auto-convert
-        if (PyList_Check(value_or_vector.ptr()) || PyTuple_Check(value_or_vector.ptr()))
-        {
-            cDVector vect = py_list_or_tuple_to_cDVector(value_or_vector);
-
-            if (name_extract.check()) {
-                self.Set(vect, name_extract());
-            }
-            else if (idx_extract.check()) {
-                uint param_num = 0;
-                if (!num_param.is_none())
-                    param_num = extract<uint>(num_param);
-                self.Set(vect, param_num);
-            }
-            else {
-                throw std::runtime_error(
-                    "cConstCondVar.set(...) usage: second arg must be string or uint when passing a Python list/tuple.");
-            }
-        }
-        else {
-            throw std::runtime_error(
-                "First arg must be float, cDVector, or a Python list/tuple of floats for cConstCondVar.set(...).");
-        }
-    }
+    ParamSet(self, value_or_vector, index_or_name, num_param, eParamIndexFirst);
 }
 
 // --------------------------------------------------------------------
@@ -114,43 +36,7 @@ static object cConstCondVarGet(cConstCondVar& self,
     const object& index_or_name,
     const object& num_param = object())
 {
-    extract<std::string> name_extract(index_or_name);
-    extract<uint>        idx_extract(index_or_name);
-
-    if (name_extract.check())
-    {
-        // The user passed a param name
-        std::string pname = name_extract();
-
-        if (num_param.is_none()) {
-            // get(param_name) -> cDVector&
-            return object(boost::ref(self.Get(pname)));
-        }
-        else {
-            // get(param_name, idx) -> double
-            uint idx = extract<uint>(num_param);
-            return object(self.Get(pname, idx));
-        }
-    }
-    else if (idx_extract.check())
-    {
-        // The user passed a param index
-        uint idx = idx_extract();
-
-        if (num_param.is_none()) {
-            // get(uint) -> cDVector&
-            return object(boost::ref(self.Get(idx)));
-        }
-        else {
-            // get(uint, subindex) -> double
-            uint sub_idx = extract<uint>(num_param);
-            return object(self.Get(idx, sub_idx));
-        }
-    }
-    else {
-        throw std::runtime_error(
-            "First argument must be a param name (string) or a param index (uint) for cConstCondVar.get(...).");
-    }
+    return ParamGet(self, index_or_name, num_param, eParamIndexFirst);
 }
 
 // --------------------------------------------------------------------
@@ -160,38 +46,7 @@ static void cConstCondVarReAlloc(cConstCondVar& self,
     const object& size_or_vector,
     const object& num_param = object())
 {
-    extract<cDVector> vec_extract(size_or_vector);
-    extract<uint>     size_extract(size_or_vector);
-
-    uint param = 0;
-    if (!num_param.is_none())
-        param = extract<uint>(num_param);
-
-    if (vec_extract.check())
-    {
-        // ReAlloc(cDVector, uint)
-        cDVector vect = vec_extract();
-        self.ReAlloc(vect, param);
-    }
-    else if (size_extract.check())
-    {
-        // ReAlloc(uint, uint)
-        uint sz = size_extract();
-        self.ReAlloc(sz, param);
-    }
-    else
-    {
-        // Fallback for Python list/tuple
-        if (PyList_Check(size_or_vector.ptr()) || PyTuple_Check(size_or_vector.ptr()))
-        {
-            cDVector vect = py_list_or_tuple_to_cDVector(size_or_vector);
-            self.ReAlloc(vect, param);
-        }
-        else {
-            throw std::runtime_error(
-                "cConstCondVar.realloc(...) usage: must pass a uint size, cDVector, or a Python list/tuple of floats.");
-        }
-    }
+    ParamReAlloc(self, size_or_vector, num_param);
 }
 
 // --------------------------------------------------------------------
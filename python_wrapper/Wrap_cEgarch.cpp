@@ -5,6 +5,7 @@
 
 // 1) Include your helper header for converting Python lists to cDVector
 #include "PythonConversion.h"
+#include "cParamDispatch.h"
 
 using namespace boost::python;
 using namespace RegArchLib;
@@ -25,85 +26,7 @@ static void cEgarchSet(cEgarch& self,
     const object& index_or_name,
     const object& num_param = object())
 {
-    extract<cDVector> vec_extract(value_or_vector);
-    extract<double>   val_extract(value_or_vector);
-
-    // Check if second argument is a string or a uint
-    extract<std::string> name_extract(index_or_name);
-    extract<uint>        idx_extract(index_or_name);
-
-    if (vec_extract.check())
-    {
-        // The user passed a cDVector or Python list that auto-converted
-        cDVector vect = vec_extract();
-
-        if (name_extract.check()) {
-            // Set(cDVector, param_name)
-            self.Set(vect, name_extract());
-        }
-        else if (idx_extract.check()) {
-            // Set(cDVector, uint)
-            uint param_num = 0;
-            if (!num_param.is_none())
-                param_num = extract<uint>(num_param);
-            self.Set(vect, param_num);
-        }
-        else {
-            throw std::runtime_error(
-                "cEgarch.set(...) usage: second argument must be string or uint when passing a vector.");
-        }
-    }
-    else if (val_extract.check())
-    {
-        // The user passed a scalar (float/double)
-        double val = val_extract();
-
-        if (name_extract.check()) {
-            // Set(double, param_name, index)
-            uint index = 0;
-            if (!num_param.is_none())
-                index = extract<uint>(num_param);
-            self.Set(val, name_extract(), index);
-        }
-        else if (idx_extract.check()) {
-            // Set(double, uint, uint)
-            uint idx = idx_extract();
-            uint param_num = 0;
-            if (!num_param.is_none())
-                param_num = extract<uint>(num_param);
-            self.Set(val, idx, param_num);
-        }
-        else {
-            throw std::runtime_error(
-                "cEgarch.set(...) usage: second argument must be string or uint when passing a scalar.");
-        }
-    }
-    else
-    {
-        // Fallback if it's a Python list/tuple not auto-converted
-        if (PyList_Check(value_or_vector.ptr()) || PyTuple_Check(value_or_vector.ptr()))
-        {
-            cDVector vect = py_list_or_tuple_to_cDVector(value_or_vector);
-
-            if (name_extract.check()) {
-                self.Set(vect, name_extract());
-            }
-            else if (idx_extract.check()) {
-                uint param_num = 0;
-                if (!num_param.is_none())
-                    param_num = extract<uint>(num_param);
-                self.Set(vect, param_num);
-            }
-            else {
-                throw std::runtime_error(
-                    "cEgarch.set(...) usage: second arg must be string or uint when passing a Python list/tuple.");
-            }
-        }
-        else {
-            throw std::runtime_error(
-                "First argument must be float, cDVector, or a Python list/tuple of floats for cEgarch.set(...).");
-        }
-    }
+    ParamSet(self, value_or_vector, index_or_name, num_param, eParamIndexFirst);
 }
 
 // --------------------------------------------------------------------
@@ -114,63 +37,7 @@ static object cEgarchGet(cEgarch& self,
     const object& index_or_name,
     const object& num_param = object())
 {
-    // We define pointers to the specific overloads to remove the compiler's ambiguity
-    // for calls like Get(std::string) returning cDVector&, or Get(std::string,uint) returning double,
-    // and similarly for Get(uint) overloads.
-
-    // 1) Overloads returning cDVector&
-    cDVector& (cEgarch:: * fctVectorByName)(std::string)
-        = static_cast<cDVector & (cEgarch::*)(std::string)>(&cEgarch::Get);
-    cDVector& (cEgarch:: * fctVectorByIndex)(uint)
-        = static_cast<cDVector & (cEgarch::*)(uint)>(&cEgarch::Get);
-
-    // 2) Overloads returning double
-    double (cEgarch:: * fctDoubleByName)(std::string, uint)
-        = static_cast<double(cEgarch::*)(std::string, uint)>(&cEgarch::Get);
-    double (cEgarch:: * fctDoubleByIndex)(uint, uint)
-        = static_cast<double(cEgarch::*)(uint, uint)>(&cEgarch::Get);
-
-    extract<std::string> name_extract(index_or_name);
-    extract<uint>        idx_extract(index_or_name);
-
-    // If user gave a string param name
-    if (name_extract.check())
-    {
-        std::string pname = name_extract();
-
-        if (num_param.is_none()) {
-            // => cDVector& version : Get(std::string)
-            cDVector& vecRef = (self.*fctVectorByName)(pname);
-            return object(boost::ref(vecRef));
-        }
-        else {
-            // => double version : Get(std::string, uint)
-            uint idx = extract<uint>(num_param);
-            double val = (self.*fctDoubleByName)(pname, idx);
-            return object(val);
-        }
-    }
-    // If user gave a numeric param index
-    else if (idx_extract.check())
-    {
-        uint idx = idx_extract();
-
-        if (num_param.is_none()) {
-            // => cDVector& version : Get(uint)
-            cDVector& vecRef = (self.*fctVectorByIndex)(idx);
-            return object(boost::ref(vecRef));
-        }
-        else {
-            // => double version : Get(uint, uint)
-            uint sub_idx = extract<uint>(num_param);
-            double val = (self.*fctDoubleByIndex)(idx, sub_idx);
-            return object(val);
-        }
-    }
-    else {
-        throw std::runtime_error(
-            "cEgarch.get(...) usage: first argument must be a param name (string) or param index (uint).");
-    }
+    return ParamGet(self, index_or_name, num_param, eParamIndexFirst);
 }
 
 // --------------------------------------------------------------------
@@ -180,38 +47,7 @@ static void cEgarchReAlloc(cEgarch& self,
     const object& size_or_vector,
     const object& num_param = object())
 {
-    extract<cDVector> vec_extract(size_or_vector);
-    extract<uint>     size_extract(size_or_vector);
-
-    uint param = 0;
-    if (!num_param.is_none())
-        param = extract<uint>(num_param);
-
-    if (vec_extract.check())
-    {
-        // ReAlloc(cDVector, uint)
-        cDVector vect = vec_extract();
-        self.ReAlloc(vect, param);
-    }
-    else if (size_extract.check())
-    {
-        // ReAlloc(uint, uint)
-        uint sz = size_extract();
-        self.ReAlloc(sz, param);
-    }
-    else
-    {
-        // Fallback for Python list/tuple
-        if (PyList_Check(size_or_vector.ptr()) || PyTuple_Check(size_or_vector.ptr()))
-        {
-            cDVector vect = py_list_or_tuple_to_cDVector(size_or_vector);
-            self.ReAlloc(vect, param);
-        }
-        else {
-            throw std::runtime_error(
-                "cEgarch.realloc(...) usage: must pass a uint size, cDVector, or Python list/tuple of floats.");
-        }
-    }
+    ParamReAlloc(self, size_or_vector, num_param);
 }
 
 // --------------------------------------------------------------------
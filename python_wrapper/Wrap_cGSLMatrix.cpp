@@ -5,11 +5,42 @@
 #include <boost/python/wrapper.hpp>
 #include <boost/python/extract.hpp>
 
+#include "cGSLMove.h"
+#include "PythonConversion.h"
+#include <cstring>
+#include <vector>
 
 using namespace boost::python;
 using namespace VectorAndMatrixNameSpace;
 
 // Helper functions for cGSLMatrix in Python
+
+// Matrix results handed to Python as heap objects (manage_new_object):
+// returned by value, Boost would copy them once more into the instance.
+static cGSLMatrix* GSLMatrix_transpose(const cGSLMatrix& theMat)
+{
+    cGSLMatrix myRes = Transpose(theMat);
+    return NewMovedMatrix(myRes);
+}
+
+static cGSLMatrix* GSLMatrix_transposeVector(const cGSLVector& theVect)
+{
+    cGSLMatrix myRes = Transpose(theVect);
+    return NewMovedMatrix(myRes);
+}
+
+static cGSLMatrix* GSLMatrix_inv(const cGSLMatrix& theMat)
+{
+    cGSLMatrix myRes = Inv(theMat);
+    return NewMovedMatrix(myRes);
+}
+
+static cGSLMatrix* GSLMatrix_abs(const cGSLMatrix& theMat)
+{
+    cGSLMatrix myRes = Abs(theMat);
+    return NewMovedMatrix(myRes);
+}
+
 static double GSLMatrix_get_item(const cGSLMatrix& self, int row, int col)
 {
     // uses operator[](row) then index col
@@ -45,50 +76,132 @@ static cGSLMatrix& GSLMatrix_assignVector(cGSLMatrix& self, const cGSLVector& ve
     return self = vec;
 }
 
-// Helper functions for matrix row access
-//
-// This helper class allows Python-style indexing: matrix[row][col]
-struct MatrixRowHelper {
-    cGSLMatrix& matrix;
-    int row;
+// Views and bulk access. m[row], row(), col() and rows() share the memory
+// of the matrix (they keep it alive, but are invalid once it is reallocated).
+static gsl_matrix* GSLMatrix_checked(const cGSLMatrix& self)
+{
+    static gsl_matrix myEmpty = { 0, 0, 0, NULL, NULL, 0 };
+    gsl_matrix* myM = self.GetGSLMatrix();
+    return (myM != NULL) ? myM : &myEmpty;
+}
 
-    MatrixRowHelper(cGSLMatrix& mat, int r) : matrix(mat), row(r) {}
+static void GSLMatrix_check_index(int theIndex, size_t theSize, const char* theWhat)
+{
+    if (theIndex < 0 || (size_t)theIndex >= theSize)
+    {
+        PyErr_SetString(PyExc_IndexError, theWhat);
+        throw_error_already_set();
+    }
+}
 
-    double getitem(int col) {
-        if (col < 0 || col >= static_cast<int>(matrix.GetNCol())) {
-            PyErr_SetString(PyExc_IndexError, "Column index out of range");
-            throw_error_already_set();
-        }
-        return matrix[row][col];
+static object GSLMatrix_row(cGSLMatrix& self, int row)
+{
+    gsl_matrix* myM = GSLMatrix_checked(self);
+    GSLMatrix_check_index(row, myM->size1, "Row index out of range");
+    return make_strided_double_view(myM->data + (size_t)row * myM->tda, myM->size2, 0, 1, 1);
+}
+
+static object GSLMatrix_col(cGSLMatrix& self, int col)
+{
+    gsl_matrix* myM = GSLMatrix_checked(self);
+    GSLMatrix_check_index(col, myM->size2, "Column index out of range");
+    return make_strided_double_view(myM->data + col, myM->size1, 0, myM->tda, 1);
+}
+
+static object GSLMatrix_rows(cGSLMatrix& self, int begin, int end)
+{
+    gsl_matrix* myM = GSLMatrix_checked(self);
+    if (end < 0)
+        end = (int)myM->size1;
+    if (begin < 0 || begin > end || (size_t)end > myM->size1)
+    {
+        PyErr_SetString(PyExc_IndexError, "Row range out of range");
+        throw_error_already_set();
     }
+    double* myData = (end > begin) ? myM->data + (size_t)begin * myM->tda : NULL;
+    return make_strided_double_view(myData, end - begin, myM->size2, myM->tda, 1);
+}
+
+static object GSLMatrix_view(cGSLMatrix& self)
+{
+    return GSLMatrix_rows(self, 0, -1);
+}
 
-    void setitem(int col, double value) {
-        if (col < 0 || col >= static_cast<int>(matrix.GetNCol())) {
-            PyErr_SetString(PyExc_IndexError, "Column index out of range");
+static list GSLMatrix_to_list(const cGSLMatrix& self)
+{
+    gsl_matrix* myM = GSLMatrix_checked(self);
+    list myRes;
+    for (size_t r = 0; r < myM->size1; r++)
+    {
+        const double* myRow = myM->data + r * myM->tda;
+        PyObject* myList = PyList_New((Py_ssize_t)myM->size2);
+        if (myList == NULL)
             throw_error_already_set();
-        }
-        matrix[row][col] = value;
+        for (size_t c = 0; c < myM->size2; c++)
+            PyList_SET_ITEM(myList, (Py_ssize_t)c, PyFloat_FromDouble(myRow[c]));
+        myRes.append(object(handle<>(myList)));
     }
-};
+    return myRes;
+}
 
-static object GSLMatrix_getitem(cGSLMatrix& self, int row)
+// Rows begin, begin + 1... from a 2-D float64 array or a list of lists, one copy per row
+static void GSLMatrix_set_rows(cGSLMatrix& self, const object& data, int begin)
 {
-    if (row < 0 || row >= static_cast<int>(self.GetNRow())) {
-        PyErr_SetString(PyExc_IndexError, "Row index out of range");
+    gsl_matrix* myM = GSLMatrix_checked(self);
+    size_t myNRow = (size_t)len(data);
+    if (begin < 0 || (size_t)begin + myNRow > myM->size1)
+    {
+        PyErr_SetString(PyExc_IndexError, "Rows out of range");
         throw_error_already_set();
     }
+    Py_buffer myBuf;
+    if (PyObject_GetBuffer(data.ptr(), &myBuf, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == 0)
+    {
+        bool myOk = myBuf.ndim == 2 && myBuf.itemsize == sizeof(double) && myBuf.format != NULL
+            && (strcmp(myBuf.format, "d") == 0 || strcmp(myBuf.format, "<d") == 0 || strcmp(myBuf.format, "=d") == 0)
+            && (size_t)myBuf.shape[1] == myM->size2;
+        if (myOk)
+        {
+            const double* mySrc = static_cast<const double*>(myBuf.buf);
+            for (size_t r = 0; r < myNRow; r++)
+                memmove(myM->data + (begin + r) * myM->tda, mySrc + r * myM->size2, myM->size2 * sizeof(double));
+            PyBuffer_Release(&myBuf);
+            return;
+        }
+        PyBuffer_Release(&myBuf);
+    }
+    else
+        PyErr_Clear();
+    for (size_t r = 0; r < myNRow; r++)
+        py_to_doubles(data[r], myM->data + (begin + r) * myM->tda, myM->size2);
+}
 
-    // Create a MatrixRowHelper and expose its methods to Python
-    MatrixRowHelper helper(self, row);
-    return class_<MatrixRowHelper>("MatrixRowHelper", no_init)
-        .def("__getitem__", &MatrixRowHelper::getitem)
-        .def("__setitem__", &MatrixRowHelper::setitem)
-        .def("__repr__", +[](const MatrixRowHelper& h) {
-        std::ostringstream oss;
-        oss << "Row " << h.row << " of matrix";
-        return oss.str();
-            })
-        (helper);
+static void GSLMatrix_set_col(cGSLMatrix& self, int col, const object& values)
+{
+    gsl_matrix* myM = GSLMatrix_checked(self);
+    GSLMatrix_check_index(col, myM->size2, "Column index out of range");
+    std::vector<double> myValues(myM->size1);
+    if (!myValues.empty())
+        py_to_doubles(values, myValues.data(), myValues.size());
+    for (size_t r = 0; r < myM->size1; r++)
+        myM->data[r * myM->tda + col] = myValues[r];
+}
+
+// Buffer protocol: a 2-D float64 buffer sharing the memory (np.asarray(m), memoryview(m))
+static int GSLMatrix_getbuffer(PyObject* theObj, Py_buffer* theView, int theFlags)
+{
+    extract<cGSLMatrix*> myMat(theObj);
+    if (!myMat.check())
+    {
+        PyErr_Clear();
+        PyErr_SetString(PyExc_BufferError, "cGSLMatrix: not initialised");
+        return -1;
+    }
+    static double myDummy = 0.0;
+    gsl_matrix* myM = GSLMatrix_checked(*myMat());
+    size_t myShape[2] = { myM->size1, myM->size2 };
+    size_t myStrides[2] = { myM->tda, 1 };
+    return fill_double_buffer(theView, theObj, (myM->data != NULL) ? myM->data : &myDummy, 2, myShape, myStrides, theFlags);
 }
 
 // Overloads for ReAlloc
@@ -104,13 +217,6 @@ static void (cGSLMatrix::* ReAlloc_cGSLMatrix)(const cGSLMatrix&)
 // Export function for cGSLMatrix
 void export_cGSLMatrix()
 {
-    // First register the row helper class
-    class_<MatrixRowHelper>("MatrixRowHelper", no_init)
-        .def("__getitem__", &MatrixRowHelper::getitem)
-        .def("__setitem__", &MatrixRowHelper::setitem)
-        ;
-
-    // Now register the main matrix class
     class_<cGSLMatrix>("cGSLMatrix",
         "Wrapper for cGSLMatrix (GSL-based matrix).",
         init< optional<int, int, double> >(
@@ -139,8 +245,25 @@ void export_cGSLMatrix()
         .def("get", &GSLMatrix_get_item)
         .def("set", &GSLMatrix_set_item)
 
-        // Python-style indexing
-        .def("__getitem__", &GSLMatrix_getitem)
+        // Python-style indexing: m[row] is a view on the row, m[row][col] an element
+        .def("__getitem__", &GSLMatrix_row, with_custodian_and_ward_postcall<0, 1>())
+        .def("__len__", &cGSLMatrix::GetNRow)
+
+        // Views sharing the memory and bulk access
+        .def("row", &GSLMatrix_row, (boost::python::arg("row")), with_custodian_and_ward_postcall<0, 1>(),
+            "View on a row (no copy).")
+        .def("col", &GSLMatrix_col, (boost::python::arg("col")), with_custodian_and_ward_postcall<0, 1>(),
+            "Strided view on a column (no copy, needs NumPy).")
+        .def("rows", &GSLMatrix_rows, (boost::python::arg("begin") = 0, boost::python::arg("end") = -1),
+            with_custodian_and_ward_postcall<0, 1>(),
+            "2-D view on the rows [begin, end) (no copy), end=-1 for the last row.")
+        .add_property("view", make_function(&GSLMatrix_view, with_custodian_and_ward_postcall<0, 1>()),
+            "2-D view on the whole matrix (no copy).")
+        .def("to_list", &GSLMatrix_to_list, "Copy as a list of lists.")
+        .def("set_rows", &GSLMatrix_set_rows, (boost::python::arg("data"), boost::python::arg("begin") = 0),
+            "Copy data (2-D float64 array or list of lists) into the rows from begin on.")
+        .def("set_col", &GSLMatrix_set_col, (boost::python::arg("col"), boost::python::arg("values")),
+            "Copy values (float64 array or sequence) into a column.")
 
         // Direct Set method
         .def("Set", &cGSLMatrix::Set,
@@ -201,13 +324,14 @@ void export_cGSLMatrix()
         .def("__str__", &GSLMatrix_str)
         .def("__repr__", &GSLMatrix_str)
         ;
+    set_buffer_procs(scope().attr("cGSLMatrix"), &GSLMatrix_getbuffer);
 
     // Export matrix operations with explicit casts to resolve ambiguities
-    def("Transpose", static_cast<cGSLMatrix(*)(const cGSLMatrix&)>(Transpose),
+    def("Transpose", &GSLMatrix_transpose, return_value_policy<manage_new_object>(),
         "Transpose a matrix");
-    def("TransposeVector", static_cast<cGSLMatrix(*)(const cGSLVector&)>(Transpose),
+    def("TransposeVector", &GSLMatrix_transposeVector, return_value_policy<manage_new_object>(),
         "Create a row matrix as transpose of a vector");
-    def("Inv", static_cast<cGSLMatrix(*)(const cGSLMatrix&)>(Inv),
+    def("Inv", &GSLMatrix_inv, return_value_policy<manage_new_object>(),
         "Invert a matrix");
     def("Identity", Identity,
         "Create identity matrix of specified size");
@@ -216,7 +340,7 @@ void export_cGSLMatrix()
 
     // Removed Diag function that's causing linking issues
 
-    def("Abs", static_cast<cGSLMatrix(*)(const cGSLMatrix&)>(Abs),
+    def("Abs", &GSLMatrix_abs, return_value_policy<manage_new_object>(),
         "Take absolute value of each element in matrix");
     def("Maxi", static_cast<double(*)(const cGSLMatrix&)>(Maxi),
         "Find maximum value in matrix");
@@ -5,6 +5,10 @@
 #include <boost/python/wrapper.hpp>
 #include <boost/python/extract.hpp>
 
+#include "cGSLMove.h"
+#include "PythonConversion.h"
+#include <vector>
+
 using namespace boost::python;
 using namespace VectorAndMatrixNameSpace;
 
@@ -49,18 +53,93 @@ static void (cGSLVector::* ReAlloc_vectRef)(const cGSLVector&) =
 static void (cGSLVector::* ReAlloc_gslPtr)(gsl_vector*) =
 &cGSLVector::ReAlloc;  // ReAlloc(gsl_vector*)
 
-// Friend free functions for arithmetic operators
-static cGSLVector cGSLVector_addDoubleLeft(double lhs, const cGSLVector& rhs)
+// Friend free functions for arithmetic operators. The results are handed
+// to Python as heap objects (manage_new_object): returned by value, Boost
+// would copy them once more into the Python instance.
+static cGSLVector* cGSLVector_addDoubleLeft(double lhs, const cGSLVector& rhs)
 {
     // Calls friend operator+(double, const cGSLVector&)
-    return operator+(lhs, rhs);
+    cGSLVector tmp = operator+(lhs, rhs);
+    return NewMovedVector(tmp);
+}
+
+static cGSLVector* cGSLVector_addDoubleRight(const cGSLVector& lhs, double rhs)
+{
+    // One copy of lhs, the only one
+    cGSLVector* tmp = new cGSLVector(lhs);
+    *tmp += rhs; // uses member operator+=(double)
+    return tmp;
+}
+
+static cGSLVector* cGSLVector_abs(const cGSLVector& theVect)
+{
+    cGSLVector tmp = Abs(theVect);
+    return NewMovedVector(tmp);
+}
+
+// Views and bulk access, sharing the memory of the vector
+static gsl_vector* GSLVector_checked(const cGSLVector& self)
+{
+    static gsl_vector myEmpty = { 0, 1, NULL, NULL, 0 };
+    gsl_vector* myV = self.GetGSLVector();
+    return (myV != NULL) ? myV : &myEmpty;
 }
 
-static cGSLVector cGSLVector_addDoubleRight(const cGSLVector& lhs, double rhs)
+static object GSLVector_view(cGSLVector& self)
 {
-    // A simple implementation: make a copy of lhs and add rhs elementwise.
-    cGSLVector tmp(lhs);
-    return tmp += rhs; // uses member operator+=(double)
+    gsl_vector* myV = GSLVector_checked(self);
+    return make_strided_double_view(myV->data, myV->size, 0, myV->stride, 1);
+}
+
+static list GSLVector_to_list(const cGSLVector& self)
+{
+    gsl_vector* myV = GSLVector_checked(self);
+    PyObject* myList = PyList_New((Py_ssize_t)myV->size);
+    if (myList == NULL)
+        throw_error_already_set();
+    for (size_t i = 0; i < myV->size; i++)
+        PyList_SET_ITEM(myList, (Py_ssize_t)i, PyFloat_FromDouble(myV->data[i * myV->stride]));
+    return list(handle<>(myList));
+}
+
+// Copies values (float64 array or sequence) into [begin, begin + len(values))
+static void GSLVector_assign(cGSLVector& self, const object& values, int begin)
+{
+    gsl_vector* myV = GSLVector_checked(self);
+    size_t mySize = (size_t)len(values);
+    if (begin < 0 || (size_t)begin + mySize > myV->size)
+    {
+        PyErr_SetString(PyExc_IndexError, "Values out of range");
+        throw_error_already_set();
+    }
+    if (mySize == 0)
+        return;
+    if (myV->stride == 1)
+    {
+        py_to_doubles(values, myV->data + begin, mySize);
+        return;
+    }
+    std::vector<double> myValues(mySize);
+    py_to_doubles(values, myValues.data(), mySize);
+    for (size_t i = 0; i < mySize; i++)
+        myV->data[(begin + i) * myV->stride] = myValues[i];
+}
+
+// Buffer protocol: a 1-D float64 buffer sharing the memory (np.asarray(v), memoryview(v))
+static int GSLVector_getbuffer(PyObject* theObj, Py_buffer* theView, int theFlags)
+{
+    extract<cGSLVector*> myVect(theObj);
+    if (!myVect.check())
+    {
+        PyErr_Clear();
+        PyErr_SetString(PyExc_BufferError, "cGSLVector: not initialised");
+        return -1;
+    }
+    static double myDummy = 0.0;
+    gsl_vector* myV = GSLVector_checked(*myVect());
+    size_t myShape = myV->size;
+    size_t myStride = myV->stride;
+    return fill_double_buffer(theView, theObj, (myV->data != NULL) ? myV->data : &myDummy, 1, &myShape, &myStride, theFlags);
 }
 
 // Helper for __str__
@@ -149,14 +228,25 @@ void export_cGSLVector()
         return &self;
             }, return_internal_reference<>(), "In-place division with a double (self /= double).")
 
+        // Views sharing the memory and bulk access
+        .def("__len__", &cGSLVector::GetSize)
+        .add_property("view", make_function(&GSLVector_view, with_custodian_and_ward_postcall<0, 1>()),
+            "View on the elements (no copy).")
+        .def("to_list", &GSLVector_to_list, "Copy as a list.")
+        .def("assign", &GSLVector_assign, (boost::python::arg("values"), boost::python::arg("begin") = 0),
+            "Copy values (float64 array or sequence) from position begin on.")
+
         // **str** method
         .def("__str__", &GSLVector_str)
         .def("__repr__", &GSLVector_str)
         ;
+    set_buffer_procs(scope().attr("cGSLVector"), &GSLVector_getbuffer);
 
     // Export add operators as free functions 
-    def("AddDoubleLeft", &cGSLVector_addDoubleLeft, "Add a scalar to each element of a vector");
-    def("AddDoubleRight", &cGSLVector_addDoubleRight, "Add a scalar to each element of a vector");
+    def("AddDoubleLeft", &cGSLVector_addDoubleLeft, return_value_policy<manage_new_object>(),
+        "Add a scalar to each element of a vector");
+    def("AddDoubleRight", &cGSLVector_addDoubleRight, return_value_policy<manage_new_object>(),
+        "Add a scalar to each element of a vector");
 
     // Export convenience functions with explicit casts to resolve ambiguities
     def("Norm", static_cast<double(*)(const cGSLVector&)>(&Norm), "Calculate Euclidean norm of a vector");
@@ -166,6 +256,6 @@ void export_cGSLVector()
     def("Maxi", static_cast<double(*)(const cGSLVector&)>(&Maxi), "Find maximum value in vector");
     def("Mini", static_cast<double(*)(const cGSLVector&)>(&Mini), "Find minimum value in vector");
 
-    def("Abs", static_cast<cGSLVector(*)(const cGSLVector&)>(&Abs), "Get absolute values of vector elements");
+    def("Abs", &cGSLVector_abs, return_value_policy<manage_new_object>(), "Get absolute values of vector elements");
     def("IsNaN", static_cast<bool(*)(const cGSLVector&)>(&IsNaN), "Check if vector contains NaN values");
 }
\ No newline at end of file
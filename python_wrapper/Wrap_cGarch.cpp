@@ -5,6 +5,7 @@
 
 // 1) Include your helper header that provides py_list_or_tuple_to_cDVector(...)
 #include "PythonConversion.h"
+#include "cParamDispatch.h"
 
 using namespace boost::python;
 using namespace RegArchLib;
@@ -25,81 +26,7 @@ static void cGarchSet(cGarch& self,
     const object& index_or_name,
     const object& num_param = object())
 {
-    extract<cDVector> vec_extract(value_or_vector);
-    extract<double>   val_extract(value_or_vector);
-
-    // Check if second argument is a string or a uint
-    extract<std::string> name_extract(index_or_name);
-    extract<uint>        idx_extract(index_or_name);
-
-    if (vec_extract.check())
-    {
-        // The user passed a cDVector (or Python list automatically convertible to cDVector)
-        cDVector vect = vec_extract();
-
-        if (name_extract.check()) {
-            // Set(cDVector, string)
-            self.Set(vect, name_extract());
-        }
-        else if (idx_extract.check()) {
-            // Set(cDVector, uint)
-            uint param_num = 0;
-            if (!num_param.is_none())
-                param_num = extract<uint>(num_param);
-            self.Set(vect, param_num);
-        }
-        else {
-            throw std::runtime_error("Invalid usage: second argument must be string or uint when passing a cDVector.");
-        }
-    }
-    else if (val_extract.check())
-    {
-        // The user passed a single float
-        double val = val_extract();
-
-        if (name_extract.check()) {
-            // Set(double, string, uint)
-            uint idx = 0;
-            if (!num_param.is_none())
-                idx = extract<uint>(num_param);
-            self.Set(val, name_extract(), idx);
-        }
-        else if (idx_extract.check()) {
-            // Set(double, uint, uint)
-            uint idx = idx_extract();
-            uint param_num = 0;
-            if (!num_param.is_none())
-                param_num = extract<uint>(num_param);
-            self.Set(val, idx, param_num);
-        }
-        else {
-            throw std::runtime_error("Invalid usage: second argument must be string or uint when passing a float.");
-        }
-    }
-    else
-    {
-        // Fallback for a Python list/tuple
-        if (PyList_Check(value_or_vector.ptr()) || PyTuple_Check(value_or_vector.ptr()))
-        {
-            cDVector vect = py_list_or_tuple_to_cDVector(value_or_vector);
-
-            if (name_extract.check()) {
-                self.Set(vect, name_extract());
-            }
-            else if (idx_extract.check()) {
-                uint param_num = 0;
-                if (!num_param.is_none())
-                    param_num = extract<uint>(num_param);
-                self.Set(vect, param_num);
-            }
-            else {
-                throw std::runtime_error("Invalid usage: second argument must be string or uint when passing a Python list/tuple.");
-            }
-        }
-        else {
-            throw std::runtime_error("First argument must be a float, cDVector, or Python list/tuple of floats for cGarch.set(...).");
-        }
-    }
+    ParamSet(self, value_or_vector, index_or_name, num_param, eParamIndexFirst);
 }
 
 // --------------------------------------------------------------------
@@ -109,42 +36,7 @@ static object cGarchGet(cGarch& self,
     const object& index_or_name,
     const object& num_param = object())
 {
-    extract<std::string> name_extract(index_or_name);
-    extract<uint>        idx_extract(index_or_name);
-
-    if (name_extract.check())
-    {
-        // The user passed a param name
-        std::string pname = name_extract();
-
-        if (num_param.is_none()) {
-            // Get(string) -> cDVector&
-            return object(boost::ref(self.Get(pname)));
-        }
-        else {
-            // Get(string, uint) -> double
-            uint idx = extract<uint>(num_param);
-            return object(self.Get(pname, idx));
-        }
-    }
-    else if (idx_extract.check())
-    {
-        // The user passed a param index
-        uint idx = idx_extract();
-
-        if (num_param.is_none()) {
-            // Get(uint) -> cDVector&
-            return object(boost::ref(self.Get(idx)));
-        }
-        else {
-            // Get(uint, uint) -> double
-            uint param_num = extract<uint>(num_param);
-            return object(self.Get(idx, param_num));
-        }
-    }
-    else {
-        throw std::runtime_error("First argument must be a param name (string) or a param index (uint) for cGarch.get(...).");
-    }
+    return ParamGet(self, index_or_name, num_param, eParamIndexFirst);
 }
 
 // --------------------------------------------------------------------
@@ -154,37 +46,7 @@ static void cGarchReAlloc(cGarch& self,
     const object& size_or_vector,
     const object& num_param = object())
 {
-    extract<cDVector> vec_extract(size_or_vector);
-    extract<uint>     size_extract(size_or_vector);
-
-    uint param = 0;
-    if (!num_param.is_none())
-        param = extract<uint>(num_param);
-
-    if (vec_extract.check())
-    {
-        cDVector vect = vec_extract();
-        // ReAlloc(cDVector, uint)
-        self.ReAlloc(vect, param);
-    }
-    else if (size_extract.check())
-    {
-        // ReAlloc(uint, uint)
-        uint sz = size_extract();
-        self.ReAlloc(sz, param);
-    }
-    else
-    {
-        // Fallback for Python list/tuple
-        if (PyList_Check(size_or_vector.ptr()) || PyTuple_Check(size_or_vector.ptr()))
-        {
-            cDVector vect = py_list_or_tuple_to_cDVector(size_or_vector);
-            self.ReAlloc(vect, param);
-        }
-        else {
-            throw std::runtime_error("First argument must be uint, cDVector, or a list/tuple of floats for cGarch.realloc(...).");
-        }
-    }
+    ParamReAlloc(self, size_or_vector, num_param);
 }
 
 // --------------------------------------------------------------------
@@ -5,6 +5,7 @@
 
 // 1) Include your helper header that provides py_list_or_tuple_to_cDVector(...)
 #include "PythonConversion.h"
+#include "cParamDispatch.h"
 
 using namespace boost::python;
 using namespace RegArchLib;
@@ -24,56 +25,27 @@ static void cGedResidualsSet(cGedResiduals& self,
     const object& pyValueOrVector,
     const object& pyIndex = object())
 {
-    // Typically, cGedResiduals only has 1 param (Beta).
-    // But we'll allow a flexible approach that checks if the user wants
-    // to set multiple distribution parameters at once.
+    // Typically, cGedResiduals only has 1 param (Beta): a float sets it,
+    // a vector (list, tuple, array, cDVector) sets them all from paramIndex.
+    uint paramIndex = ParamUint(pyIndex.ptr(), 0, "ged.set(...) usage error: the index must be a uint.");
 
-    extract<cDVector> vectorExtract(pyValueOrVector);
-    extract<double>   doubleExtract(pyValueOrVector);
-
-    // If you have multiple parameters, you might interpret pyIndex as an index
-    // for which param to set. But cGedResiduals typically only has param[0].
-    // We'll show the logic anyway, in case there's more than 1 parameter.
-
-    uint paramIndex = 0;
-    if (!pyIndex.is_none())
-        paramIndex = extract<uint>(pyIndex);
-
-    if (vectorExtract.check())
+    eParamArgKind kind = ClassifyParamArg(pyValueOrVector.ptr());
+    if (kind == eParamArgFloat || kind == eParamArgInt)
     {
-        // The user passed a cDVector or a Python list converted to cDVector
-        cDVector vect = vectorExtract();
-        // If your distribution has only 1 param, vect.size() probably == 1
-        // We'll store them via VectorToRegArchParam or direct internal calls.
-        // For simplicity, let's do:
-        self.VectorToRegArchParam(vect, paramIndex);
-    }
-    else if (doubleExtract.check())
-    {
-        // The user passed a single float or int
-        double val = doubleExtract();
-
-        // We'll create a cDVector(1) just to store this single param,
-        // then call VectorToRegArchParam
         cDVector tmp(1);
-        tmp[0] = val;
+        tmp[0] = ParamDouble(pyValueOrVector.ptr());
         self.VectorToRegArchParam(tmp, paramIndex);
     }
+    else if (kind == eParamArgNone || kind == eParamArgName || kind == eParamArgUnknown)
+    {
+        throw std::runtime_error(
+            "ged.set(...) usage error: first argument must be a float, "
+            "a cDVector, or a Python list/tuple of floats.");
+    }
     else
     {
-        // fallback if it's neither a direct cDVector nor a double:
-        // maybe it's a Python list/tuple that didn't auto-convert.
-        // we'll check for a sequence manually.
-        if (PyList_Check(pyValueOrVector.ptr()) || PyTuple_Check(pyValueOrVector.ptr()))
-        {
-            cDVector vect = py_list_or_tuple_to_cDVector(pyValueOrVector);
-            self.VectorToRegArchParam(vect, paramIndex);
-        }
-        else {
-            throw std::runtime_error(
-                "ged.set(...) usage error: first argument must be a float, "
-                "a cDVector, or a Python list/tuple of floats.");
-        }
+        cDVector vect;
+        self.VectorToRegArchParam(ParamVector(pyValueOrVector.ptr(), kind, vect), paramIndex);
     }
 }
 
@@ -108,8 +80,8 @@ static object cGedResidualsGet(cGedResiduals& self,
     // If the user didn't specify an index, return the entire vector
     if (pyIndex.is_none() && nparam > 1)
     {
-        // Return the entire parameter vector
-        return object(boost::ref(allParams));
+        // Return the entire parameter vector (a copy: allParams is local)
+        return object(allParams);
     }
     else if (pyIndex.is_none() && nparam == 1)
     {
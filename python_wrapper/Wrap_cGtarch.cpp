@@ -5,6 +5,7 @@
 
 // 1) Include your helper header that provides py_list_or_tuple_to_cDVector(...)
 #include "PythonConversion.h"
+#include "cParamDispatch.h"
 
 using namespace boost::python;
 using namespace RegArchLib;
@@ -22,81 +23,7 @@ static void Gtarch_Print(cGtarch& self)
 // --------------------------------------------------------------------
 static void cGtarchSet(cGtarch& self, const object& value_or_vector, const object& index_or_name, const object& num_param = object())
 {
-    extract<cDVector> vec_extract(value_or_vector);
-    extract<double>   val_extract(value_or_vector);
-
-    // Check if second argument is a string or a uint
-    extract<std::string> name_extract(index_or_name);
-    extract<uint>        idx_extract(index_or_name);
-
-    if (vec_extract.check())
-    {
-        // The user passed a cDVector
-        cDVector vect = vec_extract();
-
-        if (name_extract.check()) {
-            // self.Set(cDVector, std::string)
-            self.Set(vect, name_extract());
-        }
-        else if (idx_extract.check()) {
-            uint param_num = 0;
-            if (!num_param.is_none())
-                param_num = extract<uint>(num_param);
-            // self.Set(cDVector, uint)
-            self.Set(vect, param_num);
-        }
-        else {
-            throw std::runtime_error("Invalid usage for cGtarch.set(...) with a cDVector. Provide param name (string) or param index (uint).");
-        }
-    }
-    else if (val_extract.check())
-    {
-        // The user passed a scalar (double)
-        double val = val_extract();
-
-        if (name_extract.check()) {
-            // self.Set(double, std::string, uint)
-            uint idx = 0;
-            if (!num_param.is_none())
-                idx = extract<uint>(num_param);
-            self.Set(val, name_extract(), idx);
-        }
-        else if (idx_extract.check()) {
-            // self.Set(double, uint, uint)
-            uint idx = idx_extract();
-            uint param_num = 0;
-            if (!num_param.is_none())
-                param_num = extract<uint>(num_param);
-            self.Set(val, idx, param_num);
-        }
-        else {
-            throw std::runtime_error("Invalid usage for cGtarch.set(...) with a float. Provide param name (string) or param index (uint).");
-        }
-    }
-    else
-    {
-        // Fallback for Python list/tuple
-        if (PyList_Check(value_or_vector.ptr()) || PyTuple_Check(value_or_vector.ptr()))
-        {
-            cDVector vect = py_list_or_tuple_to_cDVector(value_or_vector);
-
-            if (name_extract.check()) {
-                self.Set(vect, name_extract());
-            }
-            else if (idx_extract.check()) {
-                uint param_num = 0;
-                if (!num_param.is_none())
-                    param_num = extract<uint>(num_param);
-                self.Set(vect, param_num);
-            }
-            else {
-                throw std::runtime_error("Invalid usage for cGtarch.set(...) with a Python list/tuple. Provide param name or index.");
-            }
-        }
-        else {
-            throw std::runtime_error("First arg must be float, cDVector, or a Python list/tuple of floats for cGtarch.set(...).");
-        }
-    }
+    ParamSet(self, value_or_vector, index_or_name, num_param, eParamIndexFirst);
 }
 
 // --------------------------------------------------------------------
@@ -104,42 +31,7 @@ static void cGtarchSet(cGtarch& self, const object& value_or_vector, const objec
 // --------------------------------------------------------------------
 static object cGtarchGet(cGtarch& self, const object& index_or_name, const object& num_param = object())
 {
-    extract<std::string> name_extract(index_or_name);
-    extract<uint>        idx_extract(index_or_name);
-
-    if (name_extract.check())
-    {
-        // The user passed a param name
-        std::string pname = name_extract();
-
-        if (num_param.is_none()) {
-            // Get(std::string) -> cDVector&
-            return object(boost::ref(self.Get(pname)));
-        }
-        else {
-            // Get(std::string, uint) -> double
-            uint idx = extract<uint>(num_param);
-            return object(self.Get(pname, idx));
-        }
-    }
-    else if (idx_extract.check())
-    {
-        // The user passed a param index
-        uint idx = idx_extract();
-
-        if (num_param.is_none()) {
-            // Get(uint) -> cDVector&
-            return object(boost::ref(self.Get(idx)));
-        }
-        else {
-            // Get(uint, uint) -> double
-            uint sub_idx = extract<uint>(num_param);
-            return object(self.Get(idx, sub_idx));
-        }
-    }
-    else {
-        throw std::runtime_error("First argument must be a param name (string) or a param index (uint) for cGtarch.get(...).");
-    }
+    return ParamGet(self, index_or_name, num_param, eParamIndexFirst);
 }
 
 // --------------------------------------------------------------------
@@ -147,37 +39,7 @@ static object cGtarchGet(cGtarch& self, const object& index_or_name, const objec
 // --------------------------------------------------------------------
 static void cGtarchReAlloc(cGtarch& self, const object& size_or_vector, const object& num_param = object())
 {
-    extract<cDVector> vec_extract(size_or_vector);
-    extract<uint>     size_extract(size_or_vector);
-
-    uint param = 0;
-    if (!num_param.is_none())
-        param = extract<uint>(num_param);
-
-    if (vec_extract.check())
-    {
-        cDVector vect = vec_extract();
-        // ReAlloc(cDVector, uint)
-        self.ReAlloc(vect, param);
-    }
-    else if (size_extract.check())
-    {
-        // ReAlloc(uint, uint)
-        uint sz = size_extract();
-        self.ReAlloc(sz, param);
-    }
-    else
-    {
-        // Fallback for Python list/tuple
-        if (PyList_Check(size_or_vector.ptr()) || PyTuple_Check(size_or_vector.ptr()))
-        {
-            cDVector vect = py_list_or_tuple_to_cDVector(size_or_vector);
-            self.ReAlloc(vect, param);
-        }
-        else {
-            throw std::runtime_error("First argument must be uint, cDVector, or a Python list/tuple of floats for cGtarch.realloc(...).");
-        }
-    }
+    ParamReAlloc(self, size_or_vector, num_param);
 }
 
 // --------------------------------------------------------------------
@@ -5,6 +5,7 @@
 
 // 1) Include your helper header that declares py_list_or_tuple_to_cDVector(...)
 #include "PythonConversion.h"
+#include "cParamDispatch.h"
 
 using namespace boost::python;
 using namespace RegArchLib;
@@ -22,85 +23,7 @@ static void LinReg_Print(cLinReg& self)
 // --------------------------------------------------------------------
 static void cLinRegSet(cLinReg& self, const object& value_or_vector, const object& index_or_name, const object& num_param = object())
 {
-    extract<cDVector> vec_extract(value_or_vector);
-    extract<double>   val_extract(value_or_vector);
-
-    // Check if second argument is a name (string) or an index (uint)
-    extract<std::string> name_extract(index_or_name);
-    extract<uint>        idx_extract(index_or_name);
-
-    if (vec_extract.check())
-    {
-        // The user passed a cDVector directly
-        cDVector vector = vec_extract();
-
-        if (name_extract.check()) {
-            // self.Set(cDVector, std::string)
-            std::string param_name = name_extract();
-            self.Set(vector, param_name);
-        }
-        else if (idx_extract.check()) {
-            // self.Set(cDVector, uint)
-            uint param_num = 0;
-            if (!num_param.is_none())
-                param_num = extract<uint>(num_param);
-            self.Set(vector, param_num);
-        }
-        else {
-            throw std::runtime_error("cLinReg.set(...) usage error: second argument must be string or uint when passing a vector.");
-        }
-    }
-    else if (val_extract.check())
-    {
-        // The user passed a single float/double
-        double val = val_extract();
-
-        if (name_extract.check()) {
-            // self.Set(double, std::string, uint)
-            std::string param_name = name_extract();
-            uint idx = 0;
-            if (!num_param.is_none())
-                idx = extract<uint>(num_param);
-            self.Set(val, param_name, idx);
-        }
-        else if (idx_extract.check()) {
-            // self.Set(double, uint, uint)
-            uint idx = idx_extract();
-            uint pnum = 0;
-            if (!num_param.is_none())
-                pnum = extract<uint>(num_param);
-            self.Set(val, idx, pnum);
-        }
-        else {
-            throw std::runtime_error("cLinReg.set(...) usage error: second argument must be string or uint when passing a float.");
-        }
-    }
-    else
-    {
-        // Fallback for Python list/tuple
-        if (PyList_Check(value_or_vector.ptr()) || PyTuple_Check(value_or_vector.ptr()))
-        {
-            // Convert python sequence to cDVector
-            cDVector vector = py_list_or_tuple_to_cDVector(value_or_vector);
-
-            if (name_extract.check()) {
-                // self.Set(cDVector, std::string)
-                self.Set(vector, name_extract());
-            }
-            else if (idx_extract.check()) {
-                uint param_num = 0;
-                if (!num_param.is_none())
-                    param_num = extract<uint>(num_param);
-                self.Set(vector, param_num);
-            }
-            else {
-                throw std::runtime_error("cLinReg.set(...) usage error: second argument must be string or uint when passing a Python list/tuple.");
-            }
-        }
-        else {
-            throw std::runtime_error("cLinReg.set(...) usage error: first arg must be float, cDVector, or Python list/tuple of floats.");
-        }
-    }
+    ParamSet(self, value_or_vector, index_or_name, num_param, eParamIndexFirst);
 }
 
 // --------------------------------------------------------------------
@@ -108,40 +31,7 @@ static void cLinRegSet(cLinReg& self, const object& value_or_vector, const objec
 // --------------------------------------------------------------------
 static object cLinRegGet(cLinReg& self, const object& index_or_name, const object& num_param = object())
 {
-    extract<std::string> name_extract(index_or_name);
-    extract<uint>        idx_extract(index_or_name);
-
-    if (name_extract.check())
-    {
-        std::string param_name = name_extract();
-
-        if (num_param.is_none()) {
-            // Get(std::string) -> cDVector&
-            return object(boost::ref(self.Get(param_name)));
-        }
-        else {
-            // Get(std::string, uint) -> double
-            uint idx = extract<uint>(num_param);
-            return object(self.Get(param_name, idx));
-        }
-    }
-    else if (idx_extract.check())
-    {
-        uint idx = idx_extract();
-
-        if (num_param.is_none()) {
-            // Get(uint) -> cDVector&
-            return object(boost::ref(self.Get(idx)));
-        }
-        else {
-            // Get(uint, uint) -> double
-            uint sub_idx = extract<uint>(num_param);
-            return object(self.Get(idx, sub_idx));
-        }
-    }
-    else {
-        throw std::runtime_error("cLinReg.get(...) usage error: first argument must be a string (param name) or uint (param index).");
-    }
+    return ParamGet(self, index_or_name, num_param, eParamIndexFirst);
 }
 
 // --------------------------------------------------------------------
@@ -149,37 +39,7 @@ static object cLinRegGet(cLinReg& self, const object& index_or_name, const objec
 // --------------------------------------------------------------------
 static void cLinRegReAlloc(cLinReg& self, const object& size_or_vector, const object& num_param = object())
 {
-    extract<cDVector> vec_extract(size_or_vector);
-    extract<uint>     size_extract(size_or_vector);
-
-    uint pnum = 0;
-    if (!num_param.is_none())
-        pnum = extract<uint>(num_param);
-
-    if (vec_extract.check())
-    {
-        // The user passed a cDVector
-        cDVector vector = vec_extract();
-        self.ReAlloc(vector, pnum);
-    }
-    else if (size_extract.check())
-    {
-        // The user passed a size (uint)
-        uint size = size_extract();
-        self.ReAlloc(size, pnum);
-    }
-    else
-    {
-        // Fallback for Python list/tuple
-        if (PyList_Check(size_or_vector.ptr()) || PyTuple_Check(size_or_vector.ptr()))
-        {
-            cDVector vector = py_list_or_tuple_to_cDVector(size_or_vector);
-            self.ReAlloc(vector, pnum);
-        }
-        else {
-            throw std::runtime_error("cLinReg.realloc(...) usage error: must pass a uint size, cDVector, or Python list/tuple of floats.");
-        }
-    }
+    ParamReAlloc(self, size_or_vector, num_param);
 }
 
 // --------------------------------------------------------------------
@@ -5,6 +5,7 @@
 
 // 1) Include your helper header that defines py_list_or_tuple_to_cDVector(...)
 #include "PythonConversion.h"
+#include "cParamDispatch.h"
 
 using namespace boost::python;
 using namespace RegArchLib;
@@ -22,83 +23,7 @@ static void Ma_Print(cMa& self)
 // --------------------------------------------------------------------
 static void cMaSet(cMa& self, const object& value_or_vector, const object& index_or_name, const object& num_param = object())
 {
-    // Attempt direct extraction of cDVector or double
-    extract<cDVector> vector_extract(value_or_vector);
-    extract<double>   value_extract(value_or_vector);
-
-    // Check if second argument is a string or an index
-    extract<std::string> name_extract(index_or_name);
-    extract<uint>        idx_extract(index_or_name);
-
-    if (vector_extract.check())
-    {
-        // The user gave a cDVector directly
-        cDVector vect = vector_extract();
-
-        if (name_extract.check()) {
-            // Set(cDVector, string)
-            self.Set(vect, name_extract());
-        }
-        else if (idx_extract.check()) {
-            // Set(cDVector, uint)
-            uint param_num = 0;
-            if (!num_param.is_none())
-                param_num = extract<uint>(num_param);
-            self.Set(vect, param_num);
-        }
-        else {
-            throw std::runtime_error("Invalid usage of cMa.set(...) with a vector. Provide param name (str) or param index (uint).");
-        }
-    }
-    else if (value_extract.check())
-    {
-        // The user gave a scalar (double)
-        double val = value_extract();
-
-        if (name_extract.check()) {
-            // Set(double, string, uint)
-            uint i = 0;
-            if (!num_param.is_none())
-                i = extract<uint>(num_param);
-            self.Set(val, name_extract(), i);
-        }
-        else if (idx_extract.check()) {
-            // Set(double, uint, uint)
-            uint i = idx_extract();
-            uint pnum = 0;
-            if (!num_param.is_none())
-                pnum = extract<uint>(num_param);
-            self.Set(val, i, pnum);
-        }
-        else {
-            throw std::runtime_error("Invalid usage of cMa.set(...) with a double. Provide param name (str) or param index (uint).");
-        }
-    }
-    else
-    {
-        // Fallback for Python list or tuple
-        if (PyList_Check(value_or_vector.ptr()) || PyTuple_Check(value_or_vector.ptr()))
-        {
-            // Convert it to cDVector
-            cDVector vect = py_list_or_tuple_to_cDVector(value_or_vector);
-
-            if (name_extract.check()) {
-                self.Set(vect, name_extract());
-            }
-            else if (idx_extract.check()) {
-                uint param_num = 0;
-                if (!num_param.is_none())
-                    param_num = extract<uint>(num_param);
-                self.Set(vect, param_num);
-            }
-            else {
-                throw std::runtime_error("Invalid usage of cMa.set(...) with a Python list/tuple. Provide param name (str) or param index (uint).");
-            }
-        }
-        else {
-            throw std::runtime_error("First argument must be a float, cDVector, or a Python list/tuple of floats for cMa.set(...)");
-        }
-    }
+    ParamSet(self, value_or_vector, index_or_name, num_param, eParamIndexFirst);
 }
 
 // --------------------------------------------------------------------
@@ -106,42 +31,7 @@ static void cMaSet(cMa& self, const object& value_or_vector, const object& index
 // --------------------------------------------------------------------
 static object cMaGet(cMa& self, const object& index_or_name, const object& num_param = object())
 {
-    extract<std::string> name_extract(index_or_name);
-    extract<uint>        idx_extract(index_or_name);
-
-    if (name_extract.check())
-    {
-        // The user passed a param name
-        std::string pname = name_extract();
-
-        if (num_param.is_none()) {
-            // Get(string) -> cDVector&
-            return object(boost::ref(self.Get(pname)));
-        }
-        else {
-            // Get(string, uint) -> double
-            uint i = extract<uint>(num_param);
-            return object(self.Get(pname, i));
-        }
-    }
-    else if (idx_extract.check())
-    {
-        // The user passed a param index
-        uint idx = idx_extract();
-
-        if (num_param.is_none()) {
-            // Get(uint) -> cDVector&
-            return object(boost::ref(self.Get(idx)));
-        }
-        else {
-            // Get(uint, uint) -> double
-            uint pnum = extract<uint>(num_param);
-            return object(self.Get(idx, pnum));
-        }
-    }
-    else {
-        throw std::runtime_error("First argument must be a string (param name) or uint (param index) for cMa.get(...)");
-    }
+    return ParamGet(self, index_or_name, num_param, eParamIndexFirst);
 }
 
 // --------------------------------------------------------------------
@@ -149,37 +39,7 @@ static object cMaGet(cMa& self, const object& index_or_name, const object& num_p
 // --------------------------------------------------------------------
 static void cMaReAlloc(cMa& self, const object& size_or_vector, const object& param_num = object())
 {
-    extract<cDVector> vec_extract(size_or_vector);
-    extract<uint>     size_extract(size_or_vector);
-
-    uint pnum = 0;
-    if (!param_num.is_none())
-        pnum = extract<uint>(param_num);
-
-    if (vec_extract.check())
-    {
-        // The user passed a cDVector
-        cDVector vect = vec_extract();
-        self.ReAlloc(vect, pnum);
-    }
-    else if (size_extract.check())
-    {
-        // The user passed an integer size
-        uint sz = size_extract();
-        self.ReAlloc(sz, pnum);
-    }
-    else
-    {
-        // Fallback for Python list/tuple
-        if (PyList_Check(size_or_vector.ptr()) || PyTuple_Check(size_or_vector.ptr()))
-        {
-            cDVector vect = py_list_or_tuple_to_cDVector(size_or_vector);
-            self.ReAlloc(vect, pnum);
-        }
-        else {
-            throw std::runtime_error("First argument must be a uint, cDVector, or a Python list/tuple of floats for cMa.realloc(...)");
-        }
-    }
+    ParamReAlloc(self, size_or_vector, param_num);
 }
 
 // --------------------------------------------------------------------
@@ -5,6 +5,7 @@
 
 // If you have a helper for converting Python lists/tuples to cDVector:
 #include "PythonConversion.h"
+#include "cParamDispatch.h"
 
 using namespace boost::python;
 using namespace RegArchLib;
@@ -25,96 +26,7 @@ static void cNgarchSet(cNgarch& self,
     const object& index_or_name,
     const object& num_param = object())
 {
-    extract<cDVector> vec_extract(value_or_vector);
-    extract<double>   val_extract(value_or_vector);
-
-    // Check whether second argument is a string or a uint
-    extract<std::string> name_extract(index_or_name);
-    extract<uint>        idx_extract(index_or_name);
-
-    if (vec_extract.check())
-    {
-        // The user gave a cDVector or Python list that auto-converted
-        cDVector vect = vec_extract();
-
-        if (name_extract.check())
-        {
-            // self.Set(const cDVector&, std::string)
-            self.Set(vect, name_extract());
-        }
-        else if (idx_extract.check())
-        {
-            // self.Set(const cDVector&, uint)
-            uint param_num = 0;
-            if (!num_param.is_none())
-                param_num = extract<uint>(num_param);
-            self.Set(vect, param_num);
-        }
-        else
-        {
-            throw std::runtime_error(
-                "cNgarch.set(...) usage: second argument must be string or uint when passing a vector.");
-        }
-    }
-    else if (val_extract.check())
-    {
-        // The user gave a single float/double
-        double val = val_extract();
-
-        if (name_extract.check())
-        {
-            // self.Set(double, std::string, uint)
-            std::string param_name = name_extract();
-            uint idx = 0;
-            if (!num_param.is_none())
-                idx = extract<uint>(num_param);
-            self.Set(val, param_name, idx);
-        }
-        else if (idx_extract.check())
-        {
-            // self.Set(double, uint, uint)
-            uint i = idx_extract();
-            uint param_num = 0;
-            if (!num_param.is_none())
-                param_num = extract<uint>(num_param);
-            self.Set(val, i, param_num);
-        }
-        else
-        {
-            throw std::runtime_error(
-                "cNgarch.set(...) usage: second argument must be string or uint when passing a float.");
-        }
-    }
-    else
-    {
-        // Possibly a Python list/tuple that didn't auto-convert
-        if (PyList_Check(value_or_vector.ptr()) || PyTuple_Check(value_or_vector.ptr()))
-        {
-            cDVector vect = py_list_or_tuple_to_cDVector(value_or_vector);
-
-            if (name_extract.check())
-            {
-                self.Set(vect, name_extract());
-            }
-            else if (idx_extract.check())
-            {
-                uint param_num = 0;
-                if (!num_param.is_none())
-                    param_num = extract<uint>(num_param);
-                self.Set(vect, param_num);
-            }
-            else
-            {
-                throw std::runtime_error(
-                    "cNgarch.set(...) usage: second arg must be string or uint when passing a Python list/tuple.");
-            }
-        }
-        else
-        {
-            throw std::runtime_error(
-                "First argument must be float, cDVector, or Python list/tuple of floats for cNgarch.set(...).");
-        }
-    }
+    ParamSet(self, value_or_vector, index_or_name, num_param, eParamIndexFirst);
 }
 
 // --------------------------------------------------------------------
@@ -124,48 +36,7 @@ static object cNgarchGet(cNgarch& self,
     const object& index_or_name,
     const object& num_param = object())
 {
-    extract<std::string> name_extract(index_or_name);
-    extract<uint>        idx_extract(index_or_name);
-
-    if (name_extract.check())
-    {
-        // param name
-        std::string pname = name_extract();
-
-        if (num_param.is_none())
-        {
-            // cDVector& => self.Get(std::string)
-            return object(boost::ref(self.Get(pname)));
-        }
-        else
-        {
-            // double => self.Get(std::string, uint)
-            uint idx = extract<uint>(num_param);
-            return object(self.Get(pname, idx));
-        }
-    }
-    else if (idx_extract.check())
-    {
-        // param index
-        uint i = idx_extract();
-
-        if (num_param.is_none())
-        {
-            // cDVector& => self.Get(uint)
-            return object(boost::ref(self.Get(i)));
-        }
-        else
-        {
-            // double => self.Get(uint, uint)
-            uint sub_i = extract<uint>(num_param);
-            return object(self.Get(i, sub_i));
-        }
-    }
-    else
-    {
-        throw std::runtime_error(
-            "cNgarch.get(...) usage: first arg must be string (param name) or uint (param index).");
-    }
+    return ParamGet(self, index_or_name, num_param, eParamIndexFirst);
 }
 
 // --------------------------------------------------------------------
@@ -175,39 +46,7 @@ static void cNgarchReAlloc(cNgarch& self,
     const object& size_or_vector,
     const object& num_param = object())
 {
-    extract<cDVector> vec_extract(size_or_vector);
-    extract<uint>     size_extract(size_or_vector);
-
-    uint param = 0;
-    if (!num_param.is_none())
-        param = extract<uint>(num_param);
-
-    if (vec_extract.check())
-    {
-        // self.ReAlloc(const cDVector&, uint)
-        cDVector vect = vec_extract();
-        self.ReAlloc(vect, param);
-    }
-    else if (size_extract.check())
-    {
-        // self.ReAlloc(uint, uint)
-        uint sz = size_extract();
-        self.ReAlloc(sz, param);
-    }
-    else
-    {
-        // Possibly a Python list/tuple
-        if (PyList_Check(size_or_vector.ptr()) || PyTuple_Check(size_or_vector.ptr()))
-        {
-            cDVector vect = py_list_or_tuple_to_cDVector(size_or_vector);
-            self.ReAlloc(vect, param);
-        }
-        else
-        {
-            throw std::runtime_error(
-                "cNgarch.realloc(...) usage: pass a uint size, cDVector, or a Python list/tuple of floats.");
-        }
-    }
+    ParamReAlloc(self, size_or_vector, num_param);
 }
 
 // --------------------------------------------------------------------
@@ -31,10 +31,8 @@ static cNormResiduals* createNormResiduals_from_object(object paramObj, bool sim
     }
     // Otherwise, try converting to cDVector
     cDVector paramVec = py_list_or_tuple_to_cDVector(paramObj);
-    // cNormResiduals constructor expects cDVector* if your signature is cNormResiduals(cDVector*, bool).
-    // We'll allocate a new cDVector on the heap, but typically cNormResiduals copies or uses it:
-    cDVector* paramPtr = new cDVector(paramVec);
-    return new cNormResiduals(paramPtr, simulFlag);
+    // cNormResiduals(cDVector*, bool) copies the parameters, paramVec can stay on the stack
+    return new cNormResiduals(&paramVec, simulFlag);
 }
 
 // --------------------------------------------------------------------
@@ -0,0 +1,146 @@
+#include "StdAfxRegArchLib.h"
+#include <boost/python.hpp>
+
+#include "cPackedRegArchValue.h"
+#include "cRegArchSerial.h"
+#include "PythonConversion.h"
+#include <cstring>
+
+using namespace boost::python;
+using namespace RegArchLib;
+
+static cPackedRegArchValue* new_cPackedRegArchValue_from_cDVector(const cDVector& theYt)
+{
+    return new cPackedRegArchValue(theYt);
+}
+
+// Pickle support: a packed value comes back packed
+struct cPackedRegArchValue_pickle_suite : boost::python::pickle_suite
+{
+    static object getstate(const cPackedRegArchValue& self)
+    {
+        std::string myState;
+        SerializeRegArchValue(self, myState);
+        return make_py_bytes(myState);
+    }
+
+    static void setstate(cPackedRegArchValue& self, const object& state)
+    {
+        DeserializeRegArchValue(py_bytes_to_string(state), self);
+        self.Pack();
+    }
+};
+
+/*!
+ * cPackedRegArchValue attached to a writable Python buffer, typically the
+ * buf of a multiprocessing.shared_memory.SharedMemory. The buffer is held
+ * (PyBuffer) until the value is destroyed: the SharedMemory can only be
+ * closed afterwards.
+ */
+class cSharedRegArchValue : public cPackedRegArchValue
+{
+public:
+    cSharedRegArchValue(const object& theBuffer, uint theSize)
+    {
+        if (PyObject_GetBuffer(theBuffer.ptr(), &mvView, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS) != 0)
+            throw_error_already_set();
+        if ((size_t)mvView.len < GetAttachSize(theSize) || reinterpret_cast<uintptr_t>(mvView.buf) % alignof(double) != 0)
+        {
+            PyBuffer_Release(&mvView);
+            throw std::runtime_error("cSharedRegArchValue: the buffer is too small or not aligned on a double");
+        }
+        Attach(static_cast<double*>(mvView.buf), theSize);
+    }
+
+    virtual ~cSharedRegArchValue()
+    {
+        // The series must not point into the buffer once it is released
+        cRegArchValue::Delete();
+        PyBuffer_Release(&mvView);
+    }
+
+private:
+    Py_buffer mvView;
+};
+
+// Pickle support: the buffer is not part of the state, an owning
+// cPackedRegArchValue copy of the series is pickled instead
+static object cSharedRegArchValue_reduce(const cSharedRegArchValue& self)
+{
+    object myClass = import("regarch_wrapper").attr("cPackedRegArchValue");
+    return boost::python::make_tuple(myClass, boost::python::make_tuple(), cPackedRegArchValue_pickle_suite::getstate(self));
+}
+
+// Copies the five series of theSrc, of the same size
+static void cSharedRegArchValue_CopyFrom(cPackedRegArchValue& self, const cRegArchValue& theSrc)
+{
+    uint mySize = (uint)self.mYt.GetSize();
+    if ((uint)theSrc.mYt.GetSize() != mySize)
+        throw std::runtime_error("copy_from: the values do not have the same size");
+    cDVector* myDest[] = { &self.mYt, &self.mMt, &self.mHt, &self.mUt, &self.mEpst };
+    const cDVector* mySrc[] = { &theSrc.mYt, &theSrc.mMt, &theSrc.mHt, &theSrc.mUt, &theSrc.mEpst };
+    for (int k = 0; k < 5 && mySize > 0; k++)
+    {
+        gsl_vector* myV = mySrc[k]->GetGSLVector();
+        if (mySrc[k]->GetSize() != (int)mySize)
+            throw std::runtime_error("copy_from: the series of the source do not have the same size");
+        if (myV->stride == 1)
+            memcpy(&(*myDest[k])[0], myV->data, mySize * sizeof(double));
+        else
+            for (uint t = 0; t < mySize; t++)
+                (*myDest[k])[(int)t] = myV->data[t * myV->stride];
+    }
+}
+
+/*!
+ * Export function for cPackedRegArchValue.
+ * It derives from cRegArchValue, every function taking a value accepts it.
+ */
+void export_cPackedRegArchValue()
+{
+    class_<cPackedRegArchValue, bases<cRegArchValue>, boost::noncopyable>("cPackedRegArchValue",
+        "cRegArchValue whose series (Yt, Mt, Ht, Ut, Epst, Xt, Xvt) share one\n"
+        "64-byte aligned allocation. A library call that reallocates a member moves\n"
+        "it out of the arena (is_packed becomes False), pack() gathers them again.",
+        init< optional<uint, cDMatrix*, cDMatrix*> >(
+            (boost::python::arg("theSize") = 0, boost::python::arg("theXt") = (cDMatrix*)NULL, boost::python::arg("theXvt") = (cDMatrix*)NULL),
+            "cPackedRegArchValue(uint theSize=0, cDMatrix* theXt=nullptr, cDMatrix* theXvt=nullptr)"
+        )
+    )
+        .def("__init__", make_constructor(new_cPackedRegArchValue_from_cDVector,
+            default_call_policies(), (boost::python::arg("theYt"))))
+        .def("ReAlloc", (void (cPackedRegArchValue::*)(uint)) & cPackedRegArchValue::ReAlloc,
+            (boost::python::arg("theSize")),
+            "Resize the series, in place when the size does not change.")
+        .def("ReAlloc", (void (cPackedRegArchValue::*)(cDVector&)) & cPackedRegArchValue::ReAlloc,
+            (boost::python::arg("theYt")),
+            "Copy theYt and resize the other series.")
+        .def("pack", &cPackedRegArchValue::Pack,
+            "Move all the members back into one arena.")
+        .add_property("is_packed", &cPackedRegArchValue::IsPacked,
+            "True if every member points into the arena.")
+        .add_property("arena_size", &cPackedRegArchValue::GetArenaSize,
+            "Size of the arena in bytes.")
+        .add_property("is_attached", &cPackedRegArchValue::IsAttached,
+            "True if the series live in an external (shared) buffer.")
+        .def("copy_from", &cSharedRegArchValue_CopyFrom, (boost::python::arg("value")),
+            "Copy Yt, Mt, Ht, Ut and Epst of a value of the same size.")
+        .def_pickle(cPackedRegArchValue_pickle_suite())
+        ;
+
+    class_<cSharedRegArchValue, bases<cPackedRegArchValue>, boost::noncopyable>("cSharedRegArchValue",
+        "cPackedRegArchValue whose five series live in a writable buffer, laid out as\n"
+        "Yt | Mt | Ht | Ut | Epst (n doubles each), for instance the buf of a\n"
+        "multiprocessing.shared_memory.SharedMemory of nbytes(n) bytes. Every process\n"
+        "attaching the same block sees the same series, nothing is copied or pickled.\n"
+        "The buffer is held until the value is deleted, close the SharedMemory after.",
+        init<object, uint>((boost::python::arg("buffer"), boost::python::arg("theSize")),
+            "cSharedRegArchValue(buffer, uint theSize)")
+    )
+        .def("nbytes", &cPackedRegArchValue::GetAttachSize, (boost::python::arg("theSize")),
+            "Bytes of the buffer needed for theSize dates.")
+        .staticmethod("nbytes")
+        .def("__reduce__", &cSharedRegArchValue_reduce,
+            "Pickled as a cPackedRegArchValue holding a copy of the series.")
+        ;
+}
@@ -0,0 +1,82 @@
+#include "StdAfxRegArchLib.h"
+#include <boost/python.hpp>
+#include <boost/python/wrapper.hpp>
+#include <boost/python/extract.hpp>
+
+#include "cParallelNumericDerivative.h"
+
+using namespace boost::python;
+using namespace RegArchLib;
+
+// Return copies so the Python objects stay valid after the next call
+static cDVector cParallelNumericDerivative_GetGradError(const cParallelNumericDerivative& self)
+{
+    return self.GetGradError();
+}
+
+static cDMatrix cParallelNumericDerivative_GetHessError(const cParallelNumericDerivative& self)
+{
+    return self.GetHessError();
+}
+
+/*!
+ * Export function for cParallelNumericDerivative.
+ * The perturbed likelihood passes run without the GIL, unless the model
+ * has a component written in Python.
+ */
+void export_cParallelNumericDerivative()
+{
+    class_<cParallelNumericDerivative, boost::noncopyable>("cParallelNumericDerivative",
+        "Central-difference gradient, Hessian and covariance of the log-likelihood,\n"
+        "computed on a pool of threads. Each thread owns a copy of the model and a\n"
+        "data workspace; both are kept between calls, so reuse the same object\n"
+        "across an estimation loop.",
+        init< optional<uint, double, bool, double> >(
+            (boost::python::arg("n_thread") = 0, boost::python::arg("h") = 1e-2, boost::python::arg("adaptive") = false,
+                boost::python::arg("typical_scale") = 1.0),
+            "Create the helper.\n\n"
+            "Parameters:\n"
+            "  n_thread (int): number of worker threads, 0 for the number of cores\n"
+            "  h (float): relative step, parameter i is shifted by h*max(|theta_i|, typical_scale)\n"
+            "  adaptive (bool): per-parameter steps from the parameter scale and the machine\n"
+            "      epsilon, with Richardson extrapolation over h and h/2 (h is then unused)\n"
+            "  typical_scale (float): smallest scale of a parameter, so that a parameter near 0\n"
+            "      still gets a step above the rounding of the likelihood\n"
+        )
+    )
+        .def("get_n_thread", &cParallelNumericDerivative::GetNThread,
+            "Returns the number of worker threads.")
+        .def("get_h", &cParallelNumericDerivative::Geth,
+            "Returns the relative step h.")
+        .def("set_h", &cParallelNumericDerivative::Seth, boost::python::arg("h"),
+            "Sets the relative step h.")
+        .def("is_adaptive", &cParallelNumericDerivative::IsAdaptive,
+            "Returns True if automatic steps and Richardson extrapolation are used.")
+        .def("set_adaptive", &cParallelNumericDerivative::SetAdaptive, boost::python::arg("adaptive"),
+            "Switches automatic steps and Richardson extrapolation on or off.")
+        .def("get_grad_error", &cParallelNumericDerivative_GetGradError,
+            "Estimated truncation error of the last gradient (adaptive mode, empty otherwise).")
+        .def("get_hess_error", &cParallelNumericDerivative_GetHessError,
+            "Estimated truncation error of the last Hessian or covariance call (adaptive mode, empty otherwise).")
+        .def("get_typical_scale", &cParallelNumericDerivative::GetTypicalScale,
+            "Returns the smallest parameter scale used for the steps.")
+        .def("set_typical_scale", &cParallelNumericDerivative::SetTypicalScale, boost::python::arg("typical_scale"),
+            "Sets the smallest parameter scale used for the steps.")
+        .def("get_n_llh_eval", &cParallelNumericDerivative::GetNLLHEval,
+            "Returns the number of likelihood passes done by the last call.")
+        .def("compute_grad_llh", &cParallelNumericDerivative::ComputeGradLLH,
+            (boost::python::arg("model"), boost::python::arg("value"), boost::python::arg("grad")),
+            "Numeric gradient of the log-likelihood, stored in grad (2*k passes, 4*k if adaptive).")
+        .def("compute_hess_llh", &cParallelNumericDerivative::ComputeHessLLH,
+            (boost::python::arg("model"), boost::python::arg("value"), boost::python::arg("hess")),
+            "Numeric Hessian of the log-likelihood, stored in hess (2*k*k+1 passes, 4*k*k+1 if adaptive).")
+        .def("compute_grad_and_hess_llh", &cParallelNumericDerivative::ComputeGradAndHessLLH,
+            (boost::python::arg("model"), boost::python::arg("value"), boost::python::arg("grad"), boost::python::arg("hess")),
+            "Numeric gradient and Hessian from the same passes as compute_hess_llh.")
+        .def("compute_cov", &cParallelNumericDerivative::ComputeCov,
+            (boost::python::arg("model"), boost::python::arg("value"), boost::python::arg("cov")),
+            "Covariance of the estimates as the inverse of minus the numeric Hessian.")
+        .def("delete", &cParallelNumericDerivative::Delete,
+            "Free the per-thread model copies and workspaces.")
+        ;
+}
@@ -0,0 +1,36 @@
+#include "StdAfxRegArchLib.h"
+#include <boost/python.hpp>
+
+#include "cProfile.h"
+
+using namespace boost::python;
+
+static dict GetProfile(void)
+{
+    dict myRes;
+    std::map<std::string, sProfileEntry> mySnap = cProfile::Snapshot();
+    for (std::map<std::string, sProfileEntry>::const_iterator myIt = mySnap.begin(); myIt != mySnap.end(); ++myIt)
+    {
+        dict myEntry;
+        myEntry["count"] = myIt->second.mCount;
+        myEntry["time_s"] = 1e-9 * (double)myIt->second.mNs;
+        myRes[myIt->first] = myEntry;
+    }
+    return myRes;
+}
+
+/*!
+ * Export function for the hot-path profiler.
+ * The functions always exist; without REGARCH_ENABLE_PROFILE the profile stays empty.
+ */
+void export_cProfile()
+{
+    def("profile_enabled", &cProfile::IsEnabled,
+        "True if the module was built with REGARCH_ENABLE_PROFILE.");
+    def("get_profile", &GetProfile,
+        "Call counts and cumulated times since the last reset, summed over the threads.\n"
+        "Returns a dict 'kind/class/method' -> {'count': int, 'time_s': float}, kind being\n"
+        "'mean', 'var', 'resid', 'driver' or 'alloc'. Counted-only entries have time_s = 0.");
+    def("reset_profile", &cProfile::Reset,
+        "Clear all counters and timers.");
+}
@@ -0,0 +1,191 @@
+#include "StdAfxRegArchLib.h"
+#include <boost/python.hpp>
+
+#include "cRegArchExecutor.h"
+#include "cRegArchSandwich.h"
+#include "RegArchBatchCompute.h"
+#include "PythonConversion.h"
+#include "cGSLMove.h"
+#include <memory>
+
+using namespace boost::python;
+using namespace RegArchLib;
+
+// Seconds to wait for a queue slot, as cRegArchExecutor::Submit takes it
+static double Executor_Timeout(bool theBlock, const object& theTimeout)
+{
+    if (!theBlock)
+        return 0.0;
+    if (theTimeout.is_none())
+        return -1.0;
+    double myRes = extract<double>(theTimeout);
+    if (myRes < 0.0)
+        throw std::invalid_argument("cRegArchExecutor: timeout must be non-negative");
+    return myRes;
+}
+
+// Copy of the observations of theValue: jobs never share the buffers the computations write
+static std::shared_ptr<cRegArchValue> Executor_CopyData(cRegArchValue& theValue)
+{
+    std::shared_ptr<cRegArchValue> myRes(new cRegArchValue(theValue.mYt.GetSize()));
+    myRes->mYt = theValue.mYt;
+    if (theValue.mXt.GetNRow() > 0)
+        myRes->ReAllocXt(theValue.mXt);
+    if (theValue.mXvt.GetNRow() > 0)
+        myRes->ReAllocXvt(theValue.mXvt);
+    return myRes;
+}
+
+// Model a job runs: a pure C++ model is copied at submission, so later changes of
+// the caller's model do not reach the job; a model with Python components runs
+// under the GIL and is used as it is, theModel being kept alive by the job
+static std::shared_ptr<cRegArchModel> Executor_Model(const object& theModel)
+{
+    cRegArchModel& myModel = extract<cRegArchModel&>(theModel);
+    if (!HasPythonComponent(myModel))
+        return std::shared_ptr<cRegArchModel>(new cRegArchModel(myModel));
+    return std::shared_ptr<cRegArchModel>(&myModel, [](cRegArchModel*) {});
+}
+
+template <class T>
+static object Executor_Own(T* thePtr)
+{
+    typename manage_new_object::apply<T*>::type myConverter;
+    return object(handle<>(myConverter(thePtr)));
+}
+
+static object Executor_SubmitLLH(cRegArchExecutor& self, object theModel, cRegArchValue& theValue,
+    bool theBlock, object theTimeout)
+{
+    std::shared_ptr<cRegArchModel> myModel = Executor_Model(theModel);
+    std::shared_ptr<cRegArchValue> myValue = Executor_CopyData(theValue);
+    return self.Submit([myModel, myValue]()
+    {
+        // Releases the GIL itself where the model allows it
+        return object(RegArchLLHBatch(*myModel, *myValue));
+    }, theModel, Executor_Timeout(theBlock, theTimeout));
+}
+
+static object Executor_SubmitSimul(cRegArchExecutor& self, uint theNSample, object theModel,
+    bool theBlock, object theTimeout)
+{
+    std::shared_ptr<cRegArchModel> myModel = Executor_Model(theModel);
+    return self.Submit([theNSample, myModel]()
+    {
+        std::unique_ptr<cRegArchValue> myValue(new cRegArchValue(theNSample));
+        if (!HasPythonComponent(*myModel))
+        {
+            cScopedGILRelease myNoGIL;
+            RegArchSimul(theNSample, *myModel, *myValue);
+        }
+        else
+            RegArchSimul(theNSample, *myModel, *myValue);
+        return Executor_Own(myValue.release());
+    }, theModel, Executor_Timeout(theBlock, theTimeout));
+}
+
+static object Executor_SubmitCov(cRegArchExecutor& self, object theModel, cRegArchValue& theValue,
+    bool theBlock, object theTimeout)
+{
+    std::shared_ptr<cRegArchModel> myModel = Executor_Model(theModel);
+    std::shared_ptr<cRegArchValue> myValue = Executor_CopyData(theValue);
+    return self.Submit([myModel, myValue]()
+    {
+        uint myNParam = myModel->GetNParam();
+        cDMatrix myCov(myNParam, myNParam);
+        if (!HasPythonComponent(*myModel))
+        {
+            cScopedGILRelease myNoGIL;
+            RegArchComputeCov(*myModel, *myValue, myCov);
+        }
+        else
+            RegArchComputeCov(*myModel, *myValue, myCov);
+        return Executor_Own(NewMovedMatrix(myCov));
+    }, theModel, Executor_Timeout(theBlock, theTimeout));
+}
+
+static object Executor_SubmitSandwich(cRegArchExecutor& self, object theModel, cRegArchValue& theValue,
+    eHacKernelEnum theKernel, int theNLag, bool theBlock, object theTimeout)
+{
+    std::shared_ptr<cRegArchModel> myModel = Executor_Model(theModel);
+    std::shared_ptr<cRegArchValue> myValue = Executor_CopyData(theValue);
+    return self.Submit([myModel, myValue, theKernel, theNLag]()
+    {
+        std::unique_ptr<cRegArchSandwich> myRes(new cRegArchSandwich(theKernel, theNLag));
+        if (!HasPythonComponent(*myModel))
+        {
+            cScopedGILRelease myNoGIL;
+            myRes->Compute(*myModel, *myValue);
+        }
+        else
+            myRes->Compute(*myModel, *myValue);
+        return Executor_Own(myRes.release());
+    }, theModel, Executor_Timeout(theBlock, theTimeout));
+}
+
+static void Executor_Shutdown(cRegArchExecutor& self, bool theWait, bool theCancelFutures)
+{
+    self.Shutdown(theWait, theCancelFutures);
+}
+
+static object Executor_Enter(object self)
+{
+    return self;
+}
+
+static bool Executor_Exit(cRegArchExecutor& self, object, object, object)
+{
+    self.Shutdown(true, false);
+    return false;
+}
+
+/*!
+ * Export function for cRegArchExecutor.
+ */
+void export_cRegArchExecutor()
+{
+    class_<cRegArchExecutor, boost::noncopyable>("cRegArchExecutor",
+        "Native thread pool running LLH, simulation, covariance and sandwich jobs.\n\n"
+        "Every submit_* method returns at once a concurrent.futures.Future, which\n"
+        "can also be awaited from asyncio (await future). The observations of the\n"
+        "value are copied at submission, and so is a model written in C++ only; a\n"
+        "model with Python components is used as it is when the job runs, so do\n"
+        "not change its parameters while its jobs are pending.\n"
+        "A queued job can be cancelled with future.cancel(), a running one is not\n"
+        "interrupted. With max_queue > 0, a submit waits for a free slot (the GIL\n"
+        "released) or raises queue.Full: after timeout seconds, or at once with\n"
+        "block=False, the form to use from an event loop.",
+        init<optional<unsigned int, size_t> >(
+            (boost::python::arg("n_thread") = 0, boost::python::arg("max_queue") = 0),
+            "n_thread: number of workers, 0 for all cores. max_queue: most jobs waiting,\n"
+            "0 for no limit."))
+        .def("submit_llh", &Executor_SubmitLLH,
+            (boost::python::arg("model"), boost::python::arg("value"), boost::python::arg("block") = true,
+                boost::python::arg("timeout") = object()),
+            "Future of RegArchLLH_from_value(model, value).")
+        .def("submit_simul", &Executor_SubmitSimul,
+            (boost::python::arg("n_sample"), boost::python::arg("model"), boost::python::arg("block") = true,
+                boost::python::arg("timeout") = object()),
+            "Future of a new cRegArchValue simulated from model.")
+        .def("submit_cov", &Executor_SubmitCov,
+            (boost::python::arg("model"), boost::python::arg("value"), boost::python::arg("block") = true,
+                boost::python::arg("timeout") = object()),
+            "Future of the cGSLMatrix filled by RegArchComputeCov(model, value, cov).")
+        .def("submit_sandwich", &Executor_SubmitSandwich,
+            (boost::python::arg("model"), boost::python::arg("value"),
+                boost::python::arg("kernel") = eHacNone, boost::python::arg("n_lag") = -1,
+                boost::python::arg("block") = true, boost::python::arg("timeout") = object()),
+            "Future of RegArchComputeSandwich(model, value, kernel, n_lag): LLH, I, J,\n"
+            "covariance and statistics table of the estimates.")
+        .def("shutdown", &Executor_Shutdown,
+            (boost::python::arg("wait") = true, boost::python::arg("cancel_futures") = false),
+            "Refuse new jobs. cancel_futures cancels the jobs not started yet, wait\n"
+            "waits for the others (the GIL released).")
+        .def("__enter__", &Executor_Enter)
+        .def("__exit__", &Executor_Exit)
+        .add_property("n_thread", &cRegArchExecutor::GetNThread)
+        .add_property("max_queue", &cRegArchExecutor::GetMaxQueue)
+        .add_property("n_queued", &cRegArchExecutor::GetNQueued, "Number of jobs waiting for a worker.")
+        .add_property("is_shutdown", &cRegArchExecutor::IsShutdown)
+        ;
+}
@@ -3,6 +3,8 @@
 #include <boost/python/wrapper.hpp>
 #include <boost/python/extract.hpp>
 #include <sstream> // for std::ostringstream
+#include "PythonConversion.h"
+#include "cRegArchSerial.h"
 
 using namespace boost::python;
 using namespace RegArchLib;
@@ -106,6 +108,26 @@ void cRegArchModel_params_from_list(cRegArchModel& model, const boost::python::l
     }
 }
 
+/**
+ * Pickle support: the whole model in the compact encoding of cRegArchSerial.h
+ */
+struct cRegArchModel_pickle_suite : boost::python::pickle_suite
+{
+    static object getstate(const cRegArchModel& model)
+    {
+        if (HasPythonComponent(model))
+            throw std::runtime_error("A model with a component written in Python cannot be pickled");
+        std::string myState;
+        SerializeRegArchModel(model, myState);
+        return make_py_bytes(myState);
+    }
+
+    static void setstate(cRegArchModel& model, const object& state)
+    {
+        DeserializeRegArchModel(py_bytes_to_string(state), model);
+    }
+};
+
 void export_cRegArchModel() {
     class_<cRegArchModel>("cRegArchModel",
         "Main model class for RegArch (Regression ARCH) models.\n\n"
@@ -241,5 +263,8 @@ void export_cRegArchModel() {
             "Conditional variance model component.")
         .def_readwrite("mResids", &cRegArchModel::mResids,
             "Residuals distribution model.")
+
+        // Pickle support (multiprocessing, concurrent.futures)
+        .def_pickle(cRegArchModel_pickle_suite())
         ;
 }
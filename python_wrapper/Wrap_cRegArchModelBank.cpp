@@ -0,0 +1,114 @@
+#include "StdAfxRegArchLib.h"
+#include <boost/python.hpp>
+
+#include "cRegArchModelBank.h"
+#include "PythonConversion.h"
+
+using namespace boost::python;
+using namespace RegArchLib;
+
+// Python objects owning the models
+static list ModelBank_ToList(std::vector<cRegArchModel*>& theModels)
+{
+    list myRes;
+    size_t i = 0;
+    try
+    {
+        for (; i < theModels.size(); i++)
+        {
+            manage_new_object::apply<cRegArchModel*>::type myConverter;
+            myRes.append(object(handle<>(myConverter(theModels[i]))));
+        }
+    }
+    catch (...)
+    {
+        // The models not yet handed over
+        for (; i < theModels.size(); i++)
+            delete theModels[i];
+        throw;
+    }
+    return myRes;
+}
+
+static list ModelBank_LoadAll(const cRegArchModelBank& self, unsigned int theNThread)
+{
+    std::vector<cRegArchModel*> myModels;
+    {
+        cScopedGILRelease myNoGIL;
+        self.LoadAll(myModels, theNThread);
+    }
+    return ModelBank_ToList(myModels);
+}
+
+static cRegArchModel* ModelBank_Get(const cRegArchModelBank& self, uint theIndex)
+{
+    if (theIndex >= self.GetNModel())
+    {
+        PyErr_SetString(PyExc_IndexError, "model index out of range");
+        throw_error_already_set();
+    }
+    cRegArchModel* myRes = new cRegArchModel();
+    try
+    {
+        self.Load(theIndex, *myRes);
+    }
+    catch (...)
+    {
+        delete myRes;
+        throw;
+    }
+    return myRes;
+}
+
+static void save_model_bank(const std::string& thePath, const object& theModels)
+{
+    std::vector<const cRegArchModel*> myModels;
+    stl_input_iterator<object> myIt(theModels), myEnd;
+    for (; myIt != myEnd; ++myIt)
+    {
+        const cRegArchModel& myModel = extract<const cRegArchModel&>(*myIt);
+        if (HasPythonComponent(myModel))
+            throw std::runtime_error("save_model_bank: a model with a component written in Python cannot be saved");
+        myModels.push_back(&myModel);
+    }
+    // The Python objects are kept alive by theModels
+    cRegArchModelBank::Write(thePath, myModels);
+}
+
+static list load_model_bank(const std::string& thePath, unsigned int theNThread)
+{
+    cRegArchModelBank myBank(thePath);
+    return ModelBank_LoadAll(myBank, theNThread);
+}
+
+/*!
+ * Export function for cRegArchModelBank.
+ */
+void export_cRegArchModelBank()
+{
+    class_<cRegArchModelBank, boost::noncopyable>("cRegArchModelBank",
+        "File of fitted models written by save_model_bank, opened through a\n"
+        "memory mapping. get(i) decodes one model, load_all() all of them on\n"
+        "several threads.",
+        init<const std::string&>((boost::python::arg("path")),
+            "Map the file and check its header.")
+    )
+        .def("__len__", &cRegArchModelBank::GetNModel)
+        .def("get", &ModelBank_Get, (boost::python::arg("index")),
+            return_value_policy<manage_new_object>(),
+            "New cRegArchModel decoded from record index.")
+        .def("load_all", &ModelBank_LoadAll, (boost::python::arg("n_thread") = 0),
+            "List of all the models, decoded in parallel without the GIL\n"
+            "(n_thread=0: one thread per core).")
+        .def("close", &cRegArchModelBank::Close,
+            "Release the mapping (a load_all running in another thread keeps it\n"
+            "until it returns).")
+        ;
+
+    def("save_model_bank", &save_model_bank,
+        (boost::python::arg("path"), boost::python::arg("models")),
+        "Write an iterable of cRegArchModel to path, in the model bank format.");
+    def("load_model_bank", &load_model_bank,
+        (boost::python::arg("path"), boost::python::arg("n_thread") = 0),
+        "List of the models of the bank at path, in one call.");
+}
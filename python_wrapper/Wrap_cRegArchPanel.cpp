@@ -0,0 +1,151 @@
+#include "StdAfxRegArchLib.h"
+#include <boost/python.hpp>
+
+#include "cRegArchPanel.h"
+#include "PythonConversion.h"
+#include <cstring>
+
+using namespace boost::python;
+using namespace RegArchLib;
+
+// Index of a column given by position or by name
+static uint Panel_Index(const cRegArchPanel& self, const object& theKey)
+{
+    extract<std::string> myName(theKey);
+    int myIndex = myName.check() ? self.Find(myName()) : extract<int>(theKey)();
+    if (myIndex < 0 || myIndex >= (int)self.GetNColumn())
+    {
+        PyErr_SetString(PyExc_KeyError, "no such column in the panel");
+        throw_error_already_set();
+    }
+    return (uint)myIndex;
+}
+
+static cPackedRegArchValue* Panel_Value(const cRegArchPanel& self, const object& theKey)
+{
+    uint myIndex = Panel_Index(self, theKey);
+    cPackedRegArchValue* myRes = new cPackedRegArchValue();
+    self.GetValue(myIndex, *myRes);
+    return myRes;
+}
+
+static object Panel_YtView(const cRegArchPanel& self, const object& theKey)
+{
+    uint myIndex = Panel_Index(self, theKey);
+    return make_double_view(self.GetYt(myIndex), self.GetNDate(myIndex), false);
+}
+
+static uint Panel_NDate(const cRegArchPanel& self, const object& theKey)
+{
+    return self.GetNDate(Panel_Index(self, theKey));
+}
+
+static list Panel_Names(const cRegArchPanel& self)
+{
+    list myRes;
+    for (uint i = 0; i < self.GetNColumn(); i++)
+        myRes.append(self.GetName(i));
+    return myRes;
+}
+
+// Row-major copy of a 2-D float64 array or of a list of lists
+static uint Panel_Matrix(const object& theMat, uint theNDate, std::vector<double>& theDest)
+{
+    Py_buffer myBuf;
+    if (PyObject_GetBuffer(theMat.ptr(), &myBuf, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == 0)
+    {
+        bool myOk = myBuf.ndim == 2 && myBuf.itemsize == sizeof(double) && myBuf.format != NULL
+            && (strcmp(myBuf.format, "d") == 0 || strcmp(myBuf.format, "<d") == 0 || strcmp(myBuf.format, "=d") == 0);
+        if (myOk)
+        {
+            uint myNRow = (uint)myBuf.shape[0];
+            uint myNCol = (uint)myBuf.shape[1];
+            theDest.assign(static_cast<const double*>(myBuf.buf), static_cast<const double*>(myBuf.buf) + (size_t)myNRow * myNCol);
+            PyBuffer_Release(&myBuf);
+            if (myNRow != theNDate)
+                throw std::runtime_error("write_panel: the regressors do not have one row per date");
+            return myNCol;
+        }
+        PyBuffer_Release(&myBuf);
+    }
+    else
+        PyErr_Clear();
+
+    cDMatrix myMat = py_list_of_lists_to_cDMatrix(theMat);
+    if (myMat.GetNRow() != theNDate)
+        throw std::runtime_error("write_panel: the regressors do not have one row per date");
+    uint myNCol = myMat.GetNCol();
+    theDest.resize((size_t)theNDate * myNCol);
+    for (uint r = 0; r < theNDate; r++)
+        for (uint c = 0; c < myNCol; c++)
+            theDest[(size_t)r * myNCol + c] = myMat[r][c];
+    return myNCol;
+}
+
+static void write_panel(const std::string& thePath, const object& theYt, const object& theNames,
+    const object& theXt, const object& theXvt)
+{
+    uint myNColumn = (uint)len(theYt);
+    std::vector<std::vector<double> > myYt(myNColumn), myXt(myNColumn), myXvt(myNColumn);
+    std::vector<sPanelColumnData> myColumns(myNColumn);
+    for (uint i = 0; i < myNColumn; i++)
+    {
+        sPanelColumnData& myCol = myColumns[i];
+        object myYtObj = theYt[i];
+        myCol.mNDate = (uint)len(myYtObj);
+        myYt[i].resize(myCol.mNDate);
+        if (myCol.mNDate > 0)
+            py_to_doubles(myYtObj, myYt[i].data(), myCol.mNDate);
+        myCol.mYt = myYt[i].data();
+        myCol.mName = theNames.is_none() ? std::to_string(i) : std::string(extract<std::string>(theNames[i]));
+        myCol.mXt = myCol.mXvt = NULL;
+        myCol.mNXtCol = myCol.mNXvtCol = 0;
+        if (!theXt.is_none() && !object(theXt[i]).is_none())
+        {
+            myCol.mNXtCol = Panel_Matrix(theXt[i], myCol.mNDate, myXt[i]);
+            myCol.mXt = myXt[i].data();
+        }
+        if (!theXvt.is_none() && !object(theXvt[i]).is_none())
+        {
+            myCol.mNXvtCol = Panel_Matrix(theXvt[i], myCol.mNDate, myXvt[i]);
+            myCol.mXvt = myXvt[i].data();
+        }
+    }
+    cRegArchPanel::Write(thePath, myColumns);
+}
+
+/*!
+ * Export function for cRegArchPanel.
+ */
+void export_cRegArchPanel()
+{
+    class_<cRegArchPanel, boost::noncopyable>("cRegArchPanel",
+        "Panel of series written by write_panel, opened through a memory mapping:\n"
+        "opening only reads the column table. value(key) returns a\n"
+        "cPackedRegArchValue whose Yt, Xt and Xvt point into the file, without\n"
+        "copy; it keeps the panel open. The mapping is copy-on-write, writing\n"
+        "into a value never changes the file. key is a column index or name.",
+        init<const std::string&>((boost::python::arg("path")),
+            "Map the file and check its column table.")
+    )
+        .def("__len__", &cRegArchPanel::GetNColumn)
+        .add_property("names", &Panel_Names, "Names of the columns.")
+        .def("n_date", &Panel_NDate, (boost::python::arg("key")),
+            "Number of dates of a column.")
+        .def("find", &cRegArchPanel::Find, (boost::python::arg("name")),
+            "Index of the column named name, -1 if there is none.")
+        .def("value", &Panel_Value, (boost::python::arg("key")),
+            return_value_policy<manage_new_object, with_custodian_and_ward_postcall<0, 1> >(),
+            "New cPackedRegArchValue on the column, sharing the mapping.")
+        .def("yt_view", &Panel_YtView, (boost::python::arg("key")),
+            with_custodian_and_ward_postcall<0, 1>(),
+            "Read-only NumPy view on Yt of a column (no copy).")
+        ;
+
+    def("write_panel", &write_panel,
+        (boost::python::arg("path"), boost::python::arg("yt"), boost::python::arg("names") = object(),
+            boost::python::arg("xt") = object(), boost::python::arg("xvt") = object()),
+        "Write a panel: yt is a list of series (sequences or float64 arrays), names,\n"
+        "xt and xvt optional lists of the same length. Each xt[i] / xvt[i] is None\n"
+        "or a matrix (2-D array or list of lists) with one row per date.");
+}
@@ -0,0 +1,85 @@
+#include "StdAfxRegArchLib.h"
+#include <boost/python.hpp>
+#include <boost/python/wrapper.hpp>
+#include <boost/python/extract.hpp>
+
+#include "cRegArchSandwich.h"
+
+using namespace boost::python;
+using namespace RegArchLib;
+
+// Getters return copies, so results survive the next compute()
+static cDVector Sandwich_GetParam(const cRegArchSandwich& self) { return self.GetParam(); }
+static cDMatrix Sandwich_GetI(const cRegArchSandwich& self) { return self.GetI(); }
+static cDMatrix Sandwich_GetJ(const cRegArchSandwich& self) { return self.GetJ(); }
+static cDMatrix Sandwich_GetCov(const cRegArchSandwich& self) { return self.GetCov(); }
+static cDVector Sandwich_GetStdErr(const cRegArchSandwich& self) { return self.GetStdErr(); }
+static cDVector Sandwich_GetTStat(const cRegArchSandwich& self) { return self.GetTStat(); }
+static cDVector Sandwich_GetPValue(const cRegArchSandwich& self) { return self.GetPValue(); }
+static cDMatrix Sandwich_GetStatTable(const cRegArchSandwich& self) { return self.GetStatTable(); }
+static cDMatrix Sandwich_GetHacCov(const cRegArchSandwich& self) { return self.GetHacCov(); }
+
+static cRegArchSandwich RegArchComputeSandwich(cRegArchModel& theModel, cRegArchValue& theValue,
+    eHacKernelEnum theKernel, int theNLag)
+{
+    cRegArchSandwich myRes(theKernel, theNLag);
+    myRes.Compute(theModel, theValue);
+    return myRes;
+}
+
+/*!
+ * Export function for cRegArchSandwich.
+ */
+void export_cRegArchSandwich()
+{
+    enum_<eHacKernelEnum>("eHacKernelEnum", "Kernels for the HAC covariance.")
+        .value("eHacNone", eHacNone)
+        .value("eHacBartlett", eHacBartlett)
+        .value("eHacParzen", eHacParzen)
+        ;
+
+    class_<cRegArchSandwich>("cRegArchSandwich",
+        "Robust covariance J^-1 I J^-1 / n, standard errors and statistics table,\n"
+        "all from one pass over the data. With a HAC kernel the score\n"
+        "autocovariances are accumulated in the same pass and the standard\n"
+        "errors come from the HAC covariance.",
+        init< optional<eHacKernelEnum, int> >(
+            (boost::python::arg("kernel") = eHacNone, boost::python::arg("lags") = -1),
+            "Create an empty result, fill it with compute(model, value).\n\n"
+            "Parameters:\n"
+            "  kernel (eHacKernelEnum): eHacNone, eHacBartlett or eHacParzen\n"
+            "  lags (int): number of autocovariance lags, negative for the Newey-West (1994) bandwidth\n"
+        )
+    )
+        .def("set_hac", &cRegArchSandwich::SetHac,
+            (boost::python::arg("kernel"), boost::python::arg("lags") = -1),
+            "Select the HAC kernel and the number of lags (negative for automatic).")
+        .def("get_hac_kernel", &cRegArchSandwich::GetHacKernel,
+            "Returns the HAC kernel.")
+        .def("compute", &cRegArchSandwich::Compute,
+            (boost::python::arg("model"), boost::python::arg("value")),
+            "Run the pass for the current parameters of model.")
+        .def("delete", &cRegArchSandwich::Delete,
+            "Free the stored results.")
+        .add_property("n_obs", &cRegArchSandwich::GetNObs, "Number of observations.")
+        .add_property("llh", &cRegArchSandwich::GetLLH, "Log-likelihood.")
+        .add_property("param", &Sandwich_GetParam, "Parameter vector.")
+        .add_property("I", &Sandwich_GetI, "Mean outer product of the scores.")
+        .add_property("J", &Sandwich_GetJ, "Mean Hessian of the log-density.")
+        .add_property("cov", &Sandwich_GetCov, "Sandwich covariance J^-1 I J^-1 / n.")
+        .add_property("std_err", &Sandwich_GetStdErr, "Standard errors.")
+        .add_property("t_stat", &Sandwich_GetTStat, "t-statistics.")
+        .add_property("p_value", &Sandwich_GetPValue, "Two-sided p-values.")
+        .add_property("stat_table", &Sandwich_GetStatTable,
+            "One row per parameter: estimate, standard error, t-stat, p-value.")
+        .add_property("hac_cov", &Sandwich_GetHacCov, "HAC covariance J^-1 Omega J^-1 / n (empty without kernel).")
+        .add_property("hac_n_lag", &cRegArchSandwich::GetHacNLag, "Number of autocovariance lags used.")
+        .add_property("hac_bandwidth", &cRegArchSandwich::GetHacBandwidth, "Kernel bandwidth used.")
+        ;
+
+    def("RegArchComputeSandwich", &RegArchComputeSandwich,
+        (boost::python::arg("model"), boost::python::arg("value"),
+            boost::python::arg("kernel") = eHacNone, boost::python::arg("lags") = -1),
+        "I, J, robust covariance, standard errors and statistics table from one pass.\n"
+        "Returns a cRegArchSandwich.");
+}
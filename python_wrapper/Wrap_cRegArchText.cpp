@@ -0,0 +1,118 @@
+#include "StdAfxRegArchLib.h"
+#include <boost/python.hpp>
+
+#include "cRegArchText.h"
+#include "PythonConversion.h"
+#include <algorithm>
+#include <memory>
+
+using namespace boost::python;
+using namespace RegArchLib;
+
+// Delimiter from a one character string, None for runs of blanks
+static char Text_Delimiter(const object& theDelimiter)
+{
+    if (theDelimiter.is_none())
+        return '\0';
+    std::string myDelimiter = extract<std::string>(theDelimiter);
+    if (myDelimiter.size() != 1)
+        throw std::invalid_argument("load_text: delimiter must be a single character or None");
+    return myDelimiter[0];
+}
+
+// Index of a column given by position or by header name
+static uint Text_Column(const object& theKey, const std::vector<std::string>& theHeader)
+{
+    extract<std::string> myName(theKey);
+    if (!myName.check())
+    {
+        int myIndex = extract<int>(theKey);
+        if (myIndex < 0)
+            throw std::invalid_argument("load_text: negative column index");
+        return (uint)myIndex;
+    }
+    std::vector<std::string>::const_iterator myIt = std::find(theHeader.begin(), theHeader.end(), myName());
+    if (myIt == theHeader.end())
+    {
+        PyErr_SetString(PyExc_KeyError, ("no column named '" + myName() + "' in the header").c_str());
+        throw_error_already_set();
+    }
+    return (uint)(myIt - theHeader.begin());
+}
+
+static std::vector<uint> Text_Columns(const object& theKeys, const std::vector<std::string>& theHeader)
+{
+    std::vector<uint> myRes;
+    if (theKeys.is_none())
+        return myRes;
+    for (ssize_t i = 0; i < len(theKeys); i++)
+        myRes.push_back(Text_Column(theKeys[i], theHeader));
+    return myRes;
+}
+
+static cRegArchValue* load_text(const std::string& thePath, const object& theYtCol, const object& theXtCols,
+    const object& theXvtCols, const object& theDelimiter, bool theHeader, const object& theMissing,
+    const std::string& theOnMissing, unsigned int theNThread)
+{
+    sTextOptions myOptions;
+    myOptions.mDelimiter = Text_Delimiter(theDelimiter);
+    myOptions.mHeader = theHeader;
+    myOptions.mNThread = theNThread;
+    if (theOnMissing == "error")
+        myOptions.mOnMissing = eMissingError;
+    else if (theOnMissing == "nan")
+        myOptions.mOnMissing = eMissingNaN;
+    else if (theOnMissing == "skip")
+        myOptions.mOnMissing = eMissingSkipRow;
+    else
+        throw std::invalid_argument("load_text: on_missing must be 'error', 'nan' or 'skip'");
+    if (!theMissing.is_none())
+        for (ssize_t i = 0; i < len(theMissing); i++)
+            myOptions.mMissing.push_back(extract<std::string>(theMissing[i]));
+
+    std::vector<std::string> myHeader;
+    if (theHeader)
+        myHeader = ReadTextHeader(thePath, myOptions.mDelimiter);
+    myOptions.mYtCol = Text_Column(theYtCol, myHeader);
+    myOptions.mXtCol = Text_Columns(theXtCols, myHeader);
+    myOptions.mXvtCol = Text_Columns(theXvtCols, myHeader);
+
+    std::unique_ptr<cRegArchValue> myValue(new cRegArchValue());
+    {
+        cScopedGILRelease myNoGIL;
+        LoadRegArchText(thePath, myOptions, *myValue);
+    }
+    return myValue.release();
+}
+
+static list read_text_header(const std::string& thePath, const object& theDelimiter)
+{
+    std::vector<std::string> myHeader = ReadTextHeader(thePath, Text_Delimiter(theDelimiter));
+    list myRes;
+    for (size_t i = 0; i < myHeader.size(); i++)
+        myRes.append(myHeader[i]);
+    return myRes;
+}
+
+/*!
+ * Export function for the text loader.
+ */
+void export_cRegArchText()
+{
+    def("load_text", &load_text,
+        (boost::python::arg("path"), boost::python::arg("yt_col") = 0, boost::python::arg("xt_cols") = object(),
+            boost::python::arg("xvt_cols") = object(), boost::python::arg("delimiter") = ",",
+            boost::python::arg("header") = false, boost::python::arg("missing") = object(),
+            boost::python::arg("on_missing") = "error", boost::python::arg("n_thread") = 0),
+        return_value_policy<manage_new_object>(),
+        "New cRegArchValue read from a delimited text file, parsed natively on\n"
+        "n_thread threads (0: all cores).\n"
+        "yt_col, xt_cols, xvt_cols: column indices, or names if header is True.\n"
+        "delimiter: one character, None for runs of blanks.\n"
+        "missing: tokens read as missing values, besides the empty field.\n"
+        "on_missing: 'error' (RuntimeError with the line), 'nan' or 'skip' (drop the row).");
+
+    def("read_text_header", &read_text_header,
+        (boost::python::arg("path"), boost::python::arg("delimiter") = ","),
+        "Column names on the first line of a delimited text file.");
+}
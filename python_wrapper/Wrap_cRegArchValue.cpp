@@ -3,6 +3,9 @@
 #include <boost/python/wrapper.hpp>
 #include <boost/python/extract.hpp>
 #include "PythonConversion.h"  // Now provides conversion functions
+#include "cRegArchSerial.h"
+#include "cGSLMove.h"
+#include <memory>
 #include <stdexcept>
 #include <sstream>
 
@@ -99,8 +102,9 @@ static void cRegArchValue_SetXtFromPyList(cRegArchValue& self, object pyList)
     // Convert to cDMatrix
     cDMatrix matrix = py_list_of_lists_to_cDMatrix(pyList);
 
-    // Apply to Xt by calling ReAllocXt with the matrix object
-    self.ReAllocXt(matrix);
+    // Size Xt, then take the storage of the converted matrix instead of copying it
+    self.ReAllocXt((uint)matrix.GetNRow(), (uint)matrix.GetNCol());
+    MoveMatrix(self.mXt, matrix);
 }
 
 // Corrected helper method to set a single element in Xt
@@ -124,16 +128,75 @@ static void cRegArchValue_SetXtElement(cRegArchValue& self, int row, int col, do
     }
 }
 
+// NumPy views on the data vectors, used by the compute_*_series overrides
+static object cRegArchValue_View(cDVector& theVect)
+{
+    uint mySize = theVect.GetSize();
+    return make_double_view(mySize > 0 ? &theVect[0] : NULL, mySize);
+}
+
+static object cRegArchValue_YtView(cRegArchValue& self) { return cRegArchValue_View(self.mYt); }
+static object cRegArchValue_MtView(cRegArchValue& self) { return cRegArchValue_View(self.mMt); }
+static object cRegArchValue_HtView(cRegArchValue& self) { return cRegArchValue_View(self.mHt); }
+static object cRegArchValue_UtView(cRegArchValue& self) { return cRegArchValue_View(self.mUt); }
+static object cRegArchValue_EpstView(cRegArchValue& self) { return cRegArchValue_View(self.mEpst); }
+
 // --- Factory function to construct cRegArchValue from a cDVector by value ---
 // This function uses your registered conversion for cDVector to allow passing a Python list.
 cRegArchValue* new_cRegArchValue_from_cDVector(const cDVector& yt)
 {
-    // Allocate a new cDVector on the heap from the passed value.
-    cDVector* p_yt = new cDVector(yt);
-    // Create a new cRegArchValue using the constructor that takes a cDVector pointer.
-    return new cRegArchValue(p_yt, NULL, NULL);
+    // The constructor copies *theYt: no heap copy to keep (nor to leak) here.
+    return new cRegArchValue(const_cast<cDVector*>(&yt), NULL, NULL);
+}
+
+// Takes the storage of theMat for Xt or Xvt, theMat is left empty
+static void cRegArchValue_AdoptMatrix(cRegArchValue& theValue, const object& theMat, bool theXvt)
+{
+    if (theMat.is_none())
+        return;
+    cDMatrix& myMat = extract<cDMatrix&>(theMat);
+    if (myMat.GetNRow() != (uint)theValue.mYt.GetSize())
+        throw std::runtime_error("cRegArchValue.adopt: the regressors do not have one row per date");
+    if (theXvt)
+    {
+        theValue.ReAllocXvt((uint)myMat.GetNRow(), (uint)myMat.GetNCol());
+        MoveMatrix(theValue.mXvt, myMat);
+    }
+    else
+    {
+        theValue.ReAllocXt((uint)myMat.GetNRow(), (uint)myMat.GetNCol());
+        MoveMatrix(theValue.mXt, myMat);
+    }
+    myMat.Delete();
+}
+
+// New value taking the storage of theYt (and theXt, theXvt), without copy
+static cRegArchValue* cRegArchValue_Adopt(cDVector& theYt, const object& theXt, const object& theXvt)
+{
+    std::unique_ptr<cRegArchValue> myValue(new cRegArchValue((uint)theYt.GetSize()));
+    MoveVector(myValue->mYt, theYt);
+    theYt.Delete();
+    cRegArchValue_AdoptMatrix(*myValue, theXt, false);
+    cRegArchValue_AdoptMatrix(*myValue, theXvt, true);
+    return myValue.release();
 }
 
+// Pickle support: the series in the compact encoding of cRegArchSerial.h
+struct cRegArchValue_pickle_suite : boost::python::pickle_suite
+{
+    static object getstate(const cRegArchValue& self)
+    {
+        std::string myState;
+        SerializeRegArchValue(self, myState);
+        return make_py_bytes(myState);
+    }
+
+    static void setstate(cRegArchValue& self, const object& state)
+    {
+        DeserializeRegArchValue(py_bytes_to_string(state), self);
+    }
+};
+
 void export_cRegArchValue()
 {
     class_<cRegArchValue>("cRegArchValue",
@@ -159,6 +222,12 @@ void export_cRegArchValue()
         .def_readwrite("mHt", &cRegArchValue::mHt, "Vector of conditional variance")
         .def_readwrite("mUt", &cRegArchValue::mUt, "Vector of residuals")
         .def_readwrite("mEpst", &cRegArchValue::mEpst, "Vector of standardized residuals")
+        // Views sharing the memory, invalid once the value is reallocated or deleted
+        .add_property("yt_view", &cRegArchValue_YtView, "NumPy view on mYt (no copy)")
+        .add_property("mt_view", &cRegArchValue_MtView, "NumPy view on mMt (no copy)")
+        .add_property("ht_view", &cRegArchValue_HtView, "NumPy view on mHt (no copy)")
+        .add_property("ut_view", &cRegArchValue_UtView, "NumPy view on mUt (no copy)")
+        .add_property("epst_view", &cRegArchValue_EpstView, "NumPy view on mEpst (no copy)")
         // Methods.
         .def("Delete", &cRegArchValue::Delete, "Delete all data and free memory")
         .def("ReAlloc", (void (cRegArchValue::*)(uint)) & cRegArchValue::ReAlloc,
@@ -196,5 +265,13 @@ void export_cRegArchValue()
         .def("set_xt_element", &cRegArchValue_SetXtElement,
             (boost::python::arg("row"), boost::python::arg("col"), boost::python::arg("value")),
             "Set a single element in the X matrix.")
+        .def("adopt", &cRegArchValue_Adopt,
+            (boost::python::arg("yt"), boost::python::arg("xt") = object(), boost::python::arg("xvt") = object()),
+            return_value_policy<manage_new_object>(),
+            "New cRegArchValue taking over the storage of the cDVector yt (and of the\n"
+            "cDMatrix xt, xvt): nothing is copied, the arguments are left empty.")
+        .staticmethod("adopt")
+        // Pickle support (multiprocessing, concurrent.futures)
+        .def_pickle(cRegArchValue_pickle_suite())
         ;
 }
\ No newline at end of file
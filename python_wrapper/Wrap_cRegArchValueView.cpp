@@ -0,0 +1,44 @@
+#include "StdAfxRegArchLib.h"
+#include <boost/python.hpp>
+
+#include "cRegArchValueView.h"
+#include "cRegArchSerial.h"
+#include "PythonConversion.h"
+
+using namespace boost::python;
+using namespace RegArchLib;
+
+// Pickle support: the parent is not part of the state, the window is pickled
+// as an owning cPackedRegArchValue copy
+static object cRegArchValueView_reduce(const cRegArchValueView& self)
+{
+    std::string myState;
+    SerializeRegArchValue(self, myState);
+    object myClass = import("regarch_wrapper").attr("cPackedRegArchValue");
+    return boost::python::make_tuple(myClass, boost::python::make_tuple(), make_py_bytes(myState));
+}
+
+/*!
+ * Export function for cRegArchValueView.
+ */
+void export_cRegArchValueView()
+{
+    class_<cRegArchValueView, bases<cPackedRegArchValue>, boost::noncopyable>("cRegArchValueView",
+        "Window [begin, end) of a cRegArchValue: mYt, mXt and mXvt are rows begin to\n"
+        "end - 1 of the parent, without copy; mMt, mHt, mUt and mEpst are its own.\n"
+        "Accepted wherever a cRegArchValue is. set_range() moves the window, in place\n"
+        "when its length does not change. The view keeps the parent alive; the parent\n"
+        "must not be reallocated while the view is used. pack() makes it a copy.",
+        init<cRegArchValue&, uint, uint>(
+            (boost::python::arg("parent"), boost::python::arg("begin"), boost::python::arg("end")),
+            "cRegArchValueView(parent, begin, end)")[with_custodian_and_ward<1, 2>()]
+    )
+        .def("set_range", &cRegArchValueView::SetRange,
+            (boost::python::arg("begin"), boost::python::arg("end")),
+            "Move the window to [begin, end) of the parent.")
+        .add_property("begin", &cRegArchValueView::GetBegin, "First date of the window in the parent.")
+        .add_property("end", &cRegArchValueView::GetEnd, "Date after the window in the parent.")
+        .def("__reduce__", &cRegArchValueView_reduce,
+            "Pickled as a cPackedRegArchValue holding a copy of the window.")
+        ;
+}
@@ -16,9 +16,8 @@ cStudentResiduals* CreateStudentResidualsFromVector(object pyParam, bool simulFl
 {
     // Convert the Python list/tuple to cDVector by value:
     cDVector vec = extract<cDVector>(pyParam);
-    // Construct a new cStudentResiduals with a pointer to a copy:
-    cDVector* heapVec = new cDVector(vec);
-    return new cStudentResiduals(heapVec, simulFlag);
+    // The constructor copies the parameters, vec can stay on the stack
+    return new cStudentResiduals(&vec, simulFlag);
 }
 
 static void StudentResiduals_Print(cStudentResiduals& self)
@@ -0,0 +1,294 @@
+#ifndef _CAUTODIFF_H_
+#define _CAUTODIFF_H_
+
+#include <algorithm>
+#include <cmath>
+
+/*!
+ * \file cAutoDiff.h
+ * \brief Forward-mode automatic differentiation numbers.
+ *
+ * cAdNumber<1, N> carries a value and its gradient, cAdNumber<2, N> also
+ * carries the Hessian (lower triangle, packed row by row). N is the capacity
+ * in local variables: only the first mN entries are used, so a number built
+ * from a constant (mN = 0) costs nothing to combine. Variables are created
+ * with Variable(), every other number comes from arithmetic on them.
+ *
+ * The local variables are the inputs of one ComputeVar() call (parameters
+ * and lagged values), so N stays small and the chain rule to the model's
+ * full parameter vector is done once per date, see cAutoDiffCondVar.h.
+ */
+
+#define AD_TRI(i, j) ((i) * ((i) + 1) / 2 + (j))
+
+template<unsigned int Order, unsigned int N = 16>
+class cAdNumber
+{
+public:
+    static const unsigned int msNHess = (Order >= 2) ? N * (N + 1) / 2 : 1;
+
+    double mVal;
+    unsigned int mN;
+    double mD[N];
+    double mDD[msNHess];
+
+    cAdNumber(double theVal = 0.0)
+        : mVal(theVal), mN(0)
+    {
+    }
+
+    cAdNumber(const cAdNumber& theSrc)
+    {
+        Copy(theSrc);
+    }
+
+    cAdNumber& operator=(const cAdNumber& theSrc)
+    {
+        Copy(theSrc);
+        return *this;
+    }
+
+    cAdNumber& operator=(double theVal)
+    {
+        mVal = theVal;
+        mN = 0;
+        return *this;
+    }
+
+    /*! Local variable theIndex among theN, with value theVal */
+    static cAdNumber Variable(double theVal, unsigned int theN, unsigned int theIndex)
+    {
+        cAdNumber myRes(theVal);
+        myRes.Resize(theN);
+        myRes.mD[theIndex] = 1.0;
+        return myRes;
+    }
+
+    double D(unsigned int i) const
+    {
+        return (i < mN) ? mD[i] : 0.0;
+    }
+
+    double DD(unsigned int i, unsigned int j) const
+    {
+        if (i < j)
+            std::swap(i, j);
+        return (i < mN) ? mDD[AD_TRI(i, j)] : 0.0;
+    }
+
+    /*!
+     * g(a): theD1 = g'(a), theD2 = g''(a).
+     * d_i = g' a_i, dd_ij = g' a_ij + g'' a_i a_j
+     */
+    static cAdNumber Unary(const cAdNumber& theA, double theVal, double theD1, double theD2)
+    {
+        cAdNumber myRes(theVal);
+        myRes.mN = theA.mN;
+        for (unsigned int i = 0; i < theA.mN; i++)
+            myRes.mD[i] = theD1 * theA.mD[i];
+        if (Order >= 2)
+            for (unsigned int i = 0; i < theA.mN; i++)
+                for (unsigned int j = 0; j <= i; j++)
+                    myRes.mDD[AD_TRI(i, j)] = theD1 * theA.mDD[AD_TRI(i, j)] + theD2 * theA.mD[i] * theA.mD[j];
+        return myRes;
+    }
+
+    /*!
+     * g(a, b) from its first and second partial derivatives.
+     */
+    static cAdNumber Binary(const cAdNumber& theA, const cAdNumber& theB, double theVal,
+        double theDa, double theDb, double theDaa, double theDab, double theDbb)
+    {
+        cAdNumber myRes(theVal);
+        myRes.mN = std::max(theA.mN, theB.mN);
+        for (unsigned int i = 0; i < myRes.mN; i++)
+            myRes.mD[i] = theDa * theA.D(i) + theDb * theB.D(i);
+        if (Order >= 2)
+            for (unsigned int i = 0; i < myRes.mN; i++)
+            {
+                double myAi = theA.D(i), myBi = theB.D(i);
+                for (unsigned int j = 0; j <= i; j++)
+                {
+                    double myAj = theA.D(j), myBj = theB.D(j);
+                    myRes.mDD[AD_TRI(i, j)] = theDa * theA.DD(i, j) + theDb * theB.DD(i, j)
+                        + theDaa * myAi * myAj + theDab * (myAi * myBj + myAj * myBi) + theDbb * myBi * myBj;
+                }
+            }
+        return myRes;
+    }
+
+    cAdNumber& operator+=(const cAdNumber& theB) { return *this = *this + theB; }
+    cAdNumber& operator-=(const cAdNumber& theB) { return *this = *this - theB; }
+    cAdNumber& operator*=(const cAdNumber& theB) { return *this = *this * theB; }
+    cAdNumber& operator/=(const cAdNumber& theB) { return *this = *this / theB; }
+    cAdNumber& operator+=(double theB) { mVal += theB; return *this; }
+    cAdNumber& operator-=(double theB) { mVal -= theB; return *this; }
+    cAdNumber& operator*=(double theB) { return *this = *this * theB; }
+    cAdNumber& operator/=(double theB) { return *this = *this * (1.0 / theB); }
+
+private:
+    void Resize(unsigned int theN)
+    {
+        mN = theN;
+        std::fill(mD, mD + theN, 0.0);
+        if (Order >= 2)
+            std::fill(mDD, mDD + theN * (theN + 1) / 2, 0.0);
+    }
+
+    void Copy(const cAdNumber& theSrc)
+    {
+        // Only the active part is copied
+        mVal = theSrc.mVal;
+        mN = theSrc.mN;
+        std::copy(theSrc.mD, theSrc.mD + mN, mD);
+        if (Order >= 2)
+            std::copy(theSrc.mDD, theSrc.mDD + mN * (mN + 1) / 2, mDD);
+    }
+};
+
+//--- Arithmetic ---
+
+template<unsigned int O, unsigned int N>
+inline cAdNumber<O, N> operator+(const cAdNumber<O, N>& theA, const cAdNumber<O, N>& theB)
+{
+    return cAdNumber<O, N>::Binary(theA, theB, theA.mVal + theB.mVal, 1.0, 1.0, 0.0, 0.0, 0.0);
+}
+
+template<unsigned int O, unsigned int N>
+inline cAdNumber<O, N> operator-(const cAdNumber<O, N>& theA, const cAdNumber<O, N>& theB)
+{
+    return cAdNumber<O, N>::Binary(theA, theB, theA.mVal - theB.mVal, 1.0, -1.0, 0.0, 0.0, 0.0);
+}
+
+template<unsigned int O, unsigned int N>
+inline cAdNumber<O, N> operator*(const cAdNumber<O, N>& theA, const cAdNumber<O, N>& theB)
+{
+    return cAdNumber<O, N>::Binary(theA, theB, theA.mVal * theB.mVal, theB.mVal, theA.mVal, 0.0, 1.0, 0.0);
+}
+
+template<unsigned int O, unsigned int N>
+inline cAdNumber<O, N> operator/(const cAdNumber<O, N>& theA, const cAdNumber<O, N>& theB)
+{
+    double myInv = 1.0 / theB.mVal;
+    double myVal = theA.mVal * myInv;
+    return cAdNumber<O, N>::Binary(theA, theB, myVal, myInv, -myVal * myInv,
+        0.0, -myInv * myInv, 2.0 * myVal * myInv * myInv);
+}
+
+template<unsigned int O, unsigned int N>
+inline cAdNumber<O, N> operator-(const cAdNumber<O, N>& theA)
+{
+    return cAdNumber<O, N>::Unary(theA, -theA.mVal, -1.0, 0.0);
+}
+
+template<unsigned int O, unsigned int N>
+inline cAdNumber<O, N> operator+(const cAdNumber<O, N>& theA, double theB)
+{
+    cAdNumber<O, N> myRes(theA);
+    myRes.mVal += theB;
+    return myRes;
+}
+
+template<unsigned int O, unsigned int N>
+inline cAdNumber<O, N> operator+(double theA, const cAdNumber<O, N>& theB)
+{
+    return theB + theA;
+}
+
+template<unsigned int O, unsigned int N>
+inline cAdNumber<O, N> operator-(const cAdNumber<O, N>& theA, double theB)
+{
+    return theA + (-theB);
+}
+
+template<unsigned int O, unsigned int N>
+inline cAdNumber<O, N> operator-(double theA, const cAdNumber<O, N>& theB)
+{
+    return cAdNumber<O, N>::Unary(theB, theA - theB.mVal, -1.0, 0.0);
+}
+
+template<unsigned int O, unsigned int N>
+inline cAdNumber<O, N> operator*(const cAdNumber<O, N>& theA, double theB)
+{
+    return cAdNumber<O, N>::Unary(theA, theA.mVal * theB, theB, 0.0);
+}
+
+template<unsigned int O, unsigned int N>
+inline cAdNumber<O, N> operator*(double theA, const cAdNumber<O, N>& theB)
+{
+    return theB * theA;
+}
+
+template<unsigned int O, unsigned int N>
+inline cAdNumber<O, N> operator/(const cAdNumber<O, N>& theA, double theB)
+{
+    return theA * (1.0 / theB);
+}
+
+template<unsigned int O, unsigned int N>
+inline cAdNumber<O, N> operator/(double theA, const cAdNumber<O, N>& theB)
+{
+    double myInv = 1.0 / theB.mVal;
+    return cAdNumber<O, N>::Unary(theB, theA * myInv, -theA * myInv * myInv, 2.0 * theA * myInv * myInv * myInv);
+}
+
+//--- Comparisons act on the value ---
+
+template<unsigned int O, unsigned int N>
+inline double AdValue(const cAdNumber<O, N>& theA)
+{
+    return theA.mVal;
+}
+
+inline double AdValue(double theA)
+{
+    return theA;
+}
+
+//--- Elementary functions ---
+
+template<unsigned int O, unsigned int N>
+inline cAdNumber<O, N> sqrt(const cAdNumber<O, N>& theA)
+{
+    double myVal = std::sqrt(theA.mVal);
+    double myD1 = 0.5 / myVal;
+    return cAdNumber<O, N>::Unary(theA, myVal, myD1, -0.5 * myD1 / theA.mVal);
+}
+
+template<unsigned int O, unsigned int N>
+inline cAdNumber<O, N> exp(const cAdNumber<O, N>& theA)
+{
+    double myVal = std::exp(theA.mVal);
+    return cAdNumber<O, N>::Unary(theA, myVal, myVal, myVal);
+}
+
+template<unsigned int O, unsigned int N>
+inline cAdNumber<O, N> log(const cAdNumber<O, N>& theA)
+{
+    double myInv = 1.0 / theA.mVal;
+    return cAdNumber<O, N>::Unary(theA, std::log(theA.mVal), myInv, -myInv * myInv);
+}
+
+template<unsigned int O, unsigned int N>
+inline cAdNumber<O, N> pow(const cAdNumber<O, N>& theA, double theExp)
+{
+    double myVal = std::pow(theA.mVal, theExp);
+    double myD1 = theExp * std::pow(theA.mVal, theExp - 1.0);
+    double myD2 = theExp * (theExp - 1.0) * std::pow(theA.mVal, theExp - 2.0);
+    return cAdNumber<O, N>::Unary(theA, myVal, myD1, myD2);
+}
+
+template<unsigned int O, unsigned int N>
+inline cAdNumber<O, N> pow(const cAdNumber<O, N>& theA, const cAdNumber<O, N>& theB)
+{
+    // a^b = exp(b log a)
+    return exp(theB * log(theA));
+}
+
+template<unsigned int O, unsigned int N>
+inline cAdNumber<O, N> fabs(const cAdNumber<O, N>& theA)
+{
+    return (theA.mVal < 0.0) ? -theA : theA;
+}
+
+#endif // _CAUTODIFF_H_
@@ -0,0 +1,275 @@
+#ifndef _CAUTODIFFCONDVAR_H_
+#define _CAUTODIFFCONDVAR_H_
+
+#include "StdAfxRegArchLib.h"
+#include "cAutoDiff.h"
+#include "cProfile.h"
+#include "cScratchArena.h"
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/*!
+ * \file cAutoDiffCondVar.h
+ * \brief Exact gradient and Hessian of a conditional variance model from a
+ *        single templated ComputeVar.
+ *
+ * A model deriving from cAutoDiffCondVar<Derived, Base> writes
+ *
+ *     template<class T> T ComputeVarT(uint theDate, const cAdVarArgs<T>& theArgs) const;
+ *
+ * using theArgs.Param(k) for its k-th parameter (RegArchParamToVector order),
+ * theArgs.Ut(i) for u(t-i) and theArgs.Ht(j) for h(t-j). ComputeGrad,
+ * ComputeHess and ComputeGradAndHess are then generated: the function is
+ * evaluated once on cAdNumber with the parameters and lags as local variables,
+ * and the result is mapped onto the full parameter vector with the lag
+ * gradients and Hessians already stored in cRegArchGradient / cRegArchHessien.
+ *
+ * Lags before the first date are the constant 0, as in the hand-written
+ * models. ComputeVar itself is left to the model: derive from a concrete class
+ * (cGarch, cTarch...) or implement it with ComputeVarFromParam().
+ */
+
+template<class T>
+class cAdVarArgs
+{
+public:
+    cAdVarArgs(uint theDate, const RegArchLib::cRegArchValue& theData, const RegArchLib::cDVector& theParam, uint theNLags)
+        : mvDate(theDate), mvData(theData), mvParam(theParam), mvNLags(theNLags)
+    {
+        mvNParam = (uint)theParam.GetSize();
+    }
+
+    /*! Number of local variables: parameters, then u(t-1..L), then h(t-1..L) */
+    uint GetNLocal(void) const
+    {
+        return mvNParam + 2 * mvNLags;
+    }
+
+    uint GetDate(void) const
+    {
+        return mvDate;
+    }
+
+    T Param(uint theIndex) const
+    {
+        return Make(mvParam[theIndex], theIndex);
+    }
+
+    /*! u(t - theLag), theLag in [1, GetNLags()] */
+    T Ut(uint theLag) const
+    {
+        CheckLag(theLag);
+        if (theLag > mvDate)
+            return T(0.0);
+        return Make(mvData.mUt[mvDate - theLag], mvNParam + theLag - 1);
+    }
+
+    /*! h(t - theLag), theLag in [1, GetNLags()] */
+    T Ht(uint theLag) const
+    {
+        CheckLag(theLag);
+        if (theLag > mvDate)
+            return T(0.0);
+        return Make(mvData.mHt[mvDate - theLag], mvNParam + mvNLags + theLag - 1);
+    }
+
+private:
+    T Make(double theVal, uint theLocal) const
+    {
+        if constexpr (std::is_same<T, double>::value)
+            return theVal;
+        else
+            return T::Variable(theVal, GetNLocal(), theLocal);
+    }
+
+    void CheckLag(uint theLag) const
+    {
+        if (theLag == 0 || theLag > mvNLags)
+            throw std::runtime_error("cAdVarArgs: lag out of range, check GetNLags()");
+    }
+
+    uint mvDate;
+    const RegArchLib::cRegArchValue& mvData;
+    const RegArchLib::cDVector& mvParam;
+    uint mvNParam;
+    uint mvNLags;
+};
+
+/*!
+ * CRTP mixin. tDerived provides ComputeVarT and may hide PrepareAD() to refresh
+ * cached sizes before each evaluation. N bounds the number of local variables
+ * GetNParam() + 2 * GetNLags().
+ */
+template<class tDerived, class tBase, uint N = 16>
+class cAutoDiffCondVar : public tBase
+{
+public:
+    typedef cAdNumber<1, N> tAdGrad;
+    typedef cAdNumber<2, N> tAdHess;
+
+    using tBase::tBase;
+
+    void ComputeGrad(uint theDate, const RegArchLib::cRegArchValue& theData,
+        RegArchLib::cRegArchGradient& theGradData, RegArchLib::cAbstResiduals* /* theResiduals */ = NULL) override
+    {
+        REGARCH_PROFILE_SCOPE("var", REGARCH_PROFILE_TYPE(*this), "ComputeGrad");
+        tAdGrad myRes = Evaluate<tAdGrad>(theDate, theData);
+        Project(theDate, theGradData.GetNMeanParam(), myRes, theGradData, &theGradData.mCurrentGradVar, NULL, NULL);
+    }
+
+    void ComputeHess(uint theDate, const RegArchLib::cRegArchValue& theData,
+        const RegArchLib::cRegArchGradient& theGradData, RegArchLib::cRegArchHessien& theHessData,
+        RegArchLib::cAbstResiduals* /* theResiduals */ = NULL) override
+    {
+        REGARCH_PROFILE_SCOPE("var", REGARCH_PROFILE_TYPE(*this), "ComputeHess");
+        tAdHess myRes = Evaluate<tAdHess>(theDate, theData);
+        Project(theDate, theHessData.GetNMeanParam(), myRes, theGradData, NULL, &theHessData, &theHessData.mCurrentHessVar);
+    }
+
+    void ComputeGradAndHess(uint theDate, const RegArchLib::cRegArchValue& theData,
+        RegArchLib::cRegArchGradient& theGradData, RegArchLib::cRegArchHessien& theHessData,
+        RegArchLib::cAbstResiduals* /* theResiduals */ = NULL) override
+    {
+        REGARCH_PROFILE_SCOPE("var", REGARCH_PROFILE_TYPE(*this), "ComputeGradAndHess");
+        tAdHess myRes = Evaluate<tAdHess>(theDate, theData);
+        Project(theDate, theGradData.GetNMeanParam(), myRes, theGradData, &theGradData.mCurrentGradVar,
+            &theHessData, &theHessData.mCurrentHessVar);
+    }
+
+    /*! Copies keep the AD class: models, clones and set_var copy through PtrCopy */
+    RegArchLib::cAbstCondVar* PtrCopy(void) const override
+    {
+        return new tDerived(*static_cast<const tDerived*>(this));
+    }
+
+    /*! Default hook, called before every evaluation */
+    void PrepareAD(void)
+    {
+    }
+
+protected:
+    /*! ComputeVar from the same template, for models written from scratch */
+    double ComputeVarFromParam(uint theDate, const RegArchLib::cRegArchValue& theData,
+        const RegArchLib::cDVector& theParam) const
+    {
+        cAdVarArgs<double> myArgs(theDate, theData, theParam, this->GetNLags());
+        return static_cast<const tDerived*>(this)->template ComputeVarT<double>(theDate, myArgs);
+    }
+
+private:
+    template<class T>
+    T Evaluate(uint theDate, const RegArchLib::cRegArchValue& theData)
+    {
+        tDerived* mySelf = static_cast<tDerived*>(this);
+        mySelf->PrepareAD();
+
+        uint myNParam = this->GetNParam();
+        if ((uint)mvParam.GetSize() != myNParam)
+            mvParam.ReAlloc(myNParam);
+        this->RegArchParamToVector(mvParam, 0);
+
+        cAdVarArgs<T> myArgs(theDate, theData, mvParam, this->GetNLags());
+        if (myArgs.GetNLocal() > N)
+            throw std::runtime_error("cAutoDiffCondVar: too many parameters and lags for the local capacity N");
+        return mySelf->template ComputeVarT<T>(theDate, myArgs);
+    }
+
+    /*!
+     * Chain rule from the local variables x_k to the full parameter vector:
+     *   grad h = sum_k dh/dx_k grad x_k
+     *   hess h = sum_kl d2h/dx_k dx_l grad x_k grad x_l' + sum_k dh/dx_k hess x_k
+     * with x = (own parameters, u(t-i), h(t-j)), grad u = -grad m.
+     */
+    template<class tAd>
+    void Project(uint theDate, uint theBegIndex, const tAd& theRes, const RegArchLib::cRegArchGradient& theGradData,
+        RegArchLib::cDVector* theGrad, RegArchLib::cRegArchHessien* theHessData, RegArchLib::cDMatrix* theHess)
+    {
+        uint myNOwn = this->GetNParam();
+        uint myNLags = this->GetNLags();
+        uint myNLocal = myNOwn + 2 * myNLags;
+        uint myNAvail = (theDate < myNLags) ? theDate : myNLags;
+        uint myP = (theGrad != NULL) ? (uint)theGrad->GetSize() : theHess->GetNRow();
+
+        // Jacobian of the local variables, one row of size myP per local,
+        // in the thread arena: clones evaluated in parallel share no buffer
+        cScratchScope myScratch;
+        double* myJac = myScratch.Alloc<double>((size_t)myNLocal * myP, 0.0);
+        for (uint k = 0; k < myNOwn; k++)
+            myJac[(size_t)k * myP + theBegIndex + k] = 1.0;
+        for (uint i = 1; i <= myNAvail; i++)
+        {
+            double* myURow = &myJac[(size_t)(myNOwn + i - 1) * myP];
+            double* myHRow = &myJac[(size_t)(myNOwn + myNLags + i - 1) * myP];
+            const RegArchLib::cDVector& myGradM = theGradData.mGradMt[i - 1];
+            const RegArchLib::cDVector& myGradH = theGradData.mGradHt[i - 1];
+            for (uint a = 0; a < myP; a++)
+            {
+                myURow[a] = -myGradM[a];
+                myHRow[a] = myGradH[a];
+            }
+        }
+
+        if (theGrad != NULL)
+        {
+            *theGrad = 0.0;
+            for (uint k = 0; k < myNLocal; k++)
+            {
+                double myDk = theRes.D(k);
+                if (myDk == 0.0)
+                    continue;
+                const double* myRow = &myJac[(size_t)k * myP];
+                for (uint a = 0; a < myP; a++)
+                    (*theGrad)[a] += myDk * myRow[a];
+            }
+        }
+
+        if (theHess == NULL)
+            return;
+
+        // W = H_local * J, then hess = J' W
+        double* myWork = myScratch.Alloc<double>((size_t)myNLocal * myP, 0.0);
+        for (uint k = 0; k < myNLocal; k++)
+            for (uint l = 0; l < myNLocal; l++)
+            {
+                double myHkl = theRes.DD(k, l);
+                if (myHkl == 0.0)
+                    continue;
+                const double* myRow = &myJac[(size_t)l * myP];
+                double* myWRow = &myWork[(size_t)k * myP];
+                for (uint b = 0; b < myP; b++)
+                    myWRow[b] += myHkl * myRow[b];
+            }
+
+        *theHess = 0.0;
+        for (uint k = 0; k < myNLocal; k++)
+        {
+            const double* myJRow = &myJac[(size_t)k * myP];
+            const double* myWRow = &myWork[(size_t)k * myP];
+            for (uint a = 0; a < myP; a++)
+            {
+                if (myJRow[a] == 0.0)
+                    continue;
+                double* myHRow = (*theHess)[a];
+                for (uint b = 0; b < myP; b++)
+                    myHRow[b] += myJRow[a] * myWRow[b];
+            }
+        }
+
+        // Curvature of the lagged inputs: hess u = -hess m
+        for (uint i = 1; i <= myNAvail; i++)
+        {
+            double myDu = theRes.D(myNOwn + i - 1);
+            double myDh = theRes.D(myNOwn + myNLags + i - 1);
+            const RegArchLib::cDMatrix& myHessM = theHessData->mHessMt[i - 1];
+            const RegArchLib::cDMatrix& myHessH = theHessData->mHessHt[i - 1];
+            for (uint a = 0; a < myP; a++)
+                for (uint b = 0; b < myP; b++)
+                    (*theHess)[a][b] += myDh * myHessH[a][b] - myDu * myHessM[a][b];
+        }
+    }
+
+    RegArchLib::cDVector mvParam;
+};
+
+#endif // _CAUTODIFFCONDVAR_H_
@@ -0,0 +1,81 @@
+#ifndef _CAUTODIFFGARCH_H_
+#define _CAUTODIFFGARCH_H_
+
+#include "cAutoDiffCondVar.h"
+
+/*!
+ * \file cAutoDiffGarch.h
+ * \brief GARCH and TARCH with derivatives generated by cAutoDiffCondVar.
+ *
+ * Both keep the parameters, ComputeVar and every accessor of the library
+ * classes, only the derivatives are replaced. They validate the AD backend
+ * against the hand-written cGarch / cTarch derivatives and serve as
+ * templates for new models.
+ */
+
+/*!
+ * h(t) = cste + sum_i arch_i u(t-i)^2 + sum_j garch_j h(t-j)
+ * Parameters: 0 = cste, 1 = arch, 2 = garch.
+ */
+class cAutoDiffGarch : public cAutoDiffCondVar<cAutoDiffGarch, RegArchLib::cGarch>
+{
+public:
+    using cAutoDiffCondVar<cAutoDiffGarch, RegArchLib::cGarch>::cAutoDiffCondVar;
+
+    void PrepareAD(void)
+    {
+        mvNArch = (uint)Get(1).GetSize();
+        mvNGarch = (uint)Get(2).GetSize();
+    }
+
+    template<class T>
+    T ComputeVarT(uint /* theDate */, const cAdVarArgs<T>& theArgs) const
+    {
+        T myRes = theArgs.Param(0);
+        for (uint i = 1; i <= mvNArch; i++)
+        {
+            T myU = theArgs.Ut(i);
+            myRes += theArgs.Param(i) * myU * myU;
+        }
+        for (uint j = 1; j <= mvNGarch; j++)
+            myRes += theArgs.Param(mvNArch + j) * theArgs.Ht(j);
+        return myRes;
+    }
+
+private:
+    uint mvNArch = 0;
+    uint mvNGarch = 0;
+};
+
+/*!
+ * h(t) = cste + sum_i (archPos_i 1{u(t-i) > 0} + archNeg_i 1{u(t-i) <= 0}) u(t-i)^2
+ * Parameters: 0 = cste, 1 = archPos, 2 = archNeg.
+ */
+class cAutoDiffTarch : public cAutoDiffCondVar<cAutoDiffTarch, RegArchLib::cTarch>
+{
+public:
+    using cAutoDiffCondVar<cAutoDiffTarch, RegArchLib::cTarch>::cAutoDiffCondVar;
+
+    void PrepareAD(void)
+    {
+        mvNTarch = (uint)Get(1).GetSize();
+    }
+
+    template<class T>
+    T ComputeVarT(uint /* theDate */, const cAdVarArgs<T>& theArgs) const
+    {
+        T myRes = theArgs.Param(0);
+        for (uint i = 1; i <= mvNTarch; i++)
+        {
+            T myU = theArgs.Ut(i);
+            uint myIndex = (AdValue(myU) > 0.0) ? i : mvNTarch + i;
+            myRes += theArgs.Param(myIndex) * myU * myU;
+        }
+        return myRes;
+    }
+
+private:
+    uint mvNTarch = 0;
+};
+
+#endif // _CAUTODIFFGARCH_H_
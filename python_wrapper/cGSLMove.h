@@ -0,0 +1,65 @@
+#ifndef _CGSLMOVE_H_
+#define _CGSLMOVE_H_
+
+#include "StdAfxRegArchLib.h"
+#include <utility>
+
+/*!
+ * \file cGSLMove.h
+ * \brief Ownership transfer between cGSLVector / cGSLMatrix without copying the data.
+ *
+ * cGSLVector and cGSLMatrix (RegArchLib) only have deep copies. A vector is a
+ * handle on a heap gsl_vector, so exchanging the two gsl_vector structures
+ * (size, stride, data, block, owner) hands the storage over: MoveVector()
+ * leaves theDest with the data of theSrc and theSrc with the old contents of
+ * theDest. Used to return library results to Python as heap objects
+ * (manage_new_object) instead of copying them into the Python instance, and
+ * to adopt a vector into a cRegArchValue.
+ */
+
+/*! theDest takes the storage of theSrc, theSrc gets the one of theDest */
+inline void MoveVector(RegArchLib::cDVector& theDest, RegArchLib::cDVector& theSrc)
+{
+    gsl_vector* myDest = theDest.GetGSLVector();
+    gsl_vector* mySrc = theSrc.GetGSLVector();
+    if (myDest != NULL && mySrc != NULL)
+        std::swap(*myDest, *mySrc);
+    else
+    {
+        // One side has no gsl_vector yet (empty vector): copy
+        theDest = theSrc;
+        theSrc.Delete();
+    }
+}
+
+inline void MoveMatrix(RegArchLib::cDMatrix& theDest, RegArchLib::cDMatrix& theSrc)
+{
+    gsl_matrix* myDest = theDest.GetGSLMatrix();
+    gsl_matrix* mySrc = theSrc.GetGSLMatrix();
+    if (myDest != NULL && mySrc != NULL)
+        std::swap(*myDest, *mySrc);
+    else
+    {
+        theDest = theSrc;
+        theSrc.Delete();
+    }
+}
+
+/*! New heap vector holding the storage of theSrc, theSrc is left empty */
+inline RegArchLib::cDVector* NewMovedVector(RegArchLib::cDVector& theSrc)
+{
+    RegArchLib::cDVector* myRes = new RegArchLib::cDVector(1);
+    MoveVector(*myRes, theSrc);
+    theSrc.Delete();
+    return myRes;
+}
+
+inline RegArchLib::cDMatrix* NewMovedMatrix(RegArchLib::cDMatrix& theSrc)
+{
+    RegArchLib::cDMatrix* myRes = new RegArchLib::cDMatrix(1, 1);
+    MoveMatrix(*myRes, theSrc);
+    theSrc.Delete();
+    return myRes;
+}
+
+#endif // _CGSLMOVE_H_
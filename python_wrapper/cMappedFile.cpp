@@ -0,0 +1,154 @@
+#include "cMappedFile.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // _WIN32
+
+cMappedFile::cMappedFile()
+    : mvData(NULL), mvSize(0), mvCopyOnWrite(false)
+#ifdef _WIN32
+    , mvFile(NULL), mvMapping(NULL)
+#endif // _WIN32
+{
+}
+
+cMappedFile::cMappedFile(const std::string& thePath, bool theCopyOnWrite)
+    : cMappedFile()
+{
+    Open(thePath, theCopyOnWrite);
+}
+
+cMappedFile::~cMappedFile()
+{
+    Close();
+}
+
+#ifdef _WIN32
+void cMappedFile::Open(const std::string& thePath, bool theCopyOnWrite)
+{
+    Close();
+    HANDLE myFile = CreateFileA(thePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (myFile == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("cMappedFile: cannot open " + thePath);
+    LARGE_INTEGER mySize;
+    if (!GetFileSizeEx(myFile, &mySize))
+    {
+        CloseHandle(myFile);
+        throw std::runtime_error("cMappedFile: cannot read the size of " + thePath);
+    }
+    mvFile = myFile;
+    mvPath = thePath;
+    mvSize = (size_t)mySize.QuadPart;
+    mvCopyOnWrite = theCopyOnWrite;
+    // An empty file cannot be mapped, it is simply empty
+    if (mvSize == 0)
+        return;
+    mvMapping = CreateFileMappingA(myFile, NULL, theCopyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL);
+    if (mvMapping != NULL)
+        mvData = static_cast<const char*>(MapViewOfFile(mvMapping, theCopyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0));
+    if (mvData == NULL)
+    {
+        Close();
+        throw std::runtime_error("cMappedFile: cannot map " + thePath);
+    }
+}
+
+void cMappedFile::Close(void)
+{
+    if (mvData != NULL)
+        UnmapViewOfFile(mvData);
+    if (mvMapping != NULL)
+        CloseHandle(mvMapping);
+    if (mvFile != NULL)
+        CloseHandle(mvFile);
+    mvData = NULL;
+    mvMapping = NULL;
+    mvFile = NULL;
+    mvSize = 0;
+    mvCopyOnWrite = false;
+    mvPath.clear();
+}
+
+bool cMappedFile::IsOpen(void) const
+{
+    return mvFile != NULL;
+}
+#else
+void cMappedFile::Open(const std::string& thePath, bool theCopyOnWrite)
+{
+    Close();
+    int myFd = open(thePath.c_str(), O_RDONLY);
+    if (myFd < 0)
+        throw std::runtime_error("cMappedFile: cannot open " + thePath);
+    struct stat myStat;
+    if (fstat(myFd, &myStat) != 0)
+    {
+        close(myFd);
+        throw std::runtime_error("cMappedFile: cannot read the size of " + thePath);
+    }
+    size_t mySize = (size_t)myStat.st_size;
+    const char* myData = NULL;
+    if (mySize > 0)
+    {
+        void* myMap = theCopyOnWrite
+            ? mmap(NULL, mySize, PROT_READ | PROT_WRITE, MAP_PRIVATE, myFd, 0)
+            : mmap(NULL, mySize, PROT_READ, MAP_SHARED, myFd, 0);
+        if (myMap == MAP_FAILED)
+        {
+            close(myFd);
+            throw std::runtime_error("cMappedFile: cannot map " + thePath);
+        }
+        myData = static_cast<const char*>(myMap);
+    }
+    // The mapping stays valid once the descriptor is closed
+    close(myFd);
+    mvData = myData;
+    mvSize = mySize;
+    mvPath = thePath;
+    mvCopyOnWrite = theCopyOnWrite;
+}
+
+void cMappedFile::Close(void)
+{
+    if (mvData != NULL)
+        munmap(const_cast<char*>(mvData), mvSize);
+    mvData = NULL;
+    mvSize = 0;
+    mvCopyOnWrite = false;
+    mvPath.clear();
+}
+
+bool cMappedFile::IsOpen(void) const
+{
+    return !mvPath.empty();
+}
+#endif // _WIN32
+
+const char* cMappedFile::GetData(void) const
+{
+    return mvData;
+}
+
+char* cMappedFile::GetWritableData(void) const
+{
+    return mvCopyOnWrite ? const_cast<char*>(mvData) : NULL;
+}
+
+size_t cMappedFile::GetSize(void) const
+{
+    return mvSize;
+}
+
+const std::string& cMappedFile::GetPath(void) const
+{
+    return mvPath;
+}
@@ -0,0 +1,49 @@
+#ifndef _CMAPPEDFILE_H_
+#define _CMAPPEDFILE_H_
+
+#include <cstddef>
+#include <string>
+
+/*!
+ * \file cMappedFile.h
+ * \brief Read-only memory mapping of a whole file.
+ *
+ * The pages are loaded by the system on first access: opening a large file
+ * costs the same as opening a small one. The mapping is released on Close()
+ * or destruction, every pointer into it is then invalid.
+ *
+ * With theCopyOnWrite the pages are also writable: a page written to becomes
+ * a private copy, the file itself is never modified.
+ */
+class cMappedFile
+{
+public:
+    cMappedFile();
+    /*! Maps thePath, throws std::runtime_error on failure */
+    explicit cMappedFile(const std::string& thePath, bool theCopyOnWrite = false);
+    ~cMappedFile();
+    cMappedFile(const cMappedFile&) = delete;
+    cMappedFile& operator=(const cMappedFile&) = delete;
+
+    void Open(const std::string& thePath, bool theCopyOnWrite = false);
+    void Close(void);
+    bool IsOpen(void) const;
+
+    const char* GetData(void) const;
+    /*! Same as GetData, NULL unless opened with theCopyOnWrite */
+    char* GetWritableData(void) const;
+    size_t GetSize(void) const;
+    const std::string& GetPath(void) const;
+
+private:
+    const char* mvData;
+    size_t mvSize;
+    bool mvCopyOnWrite;
+    std::string mvPath;
+#ifdef _WIN32
+    void* mvFile;
+    void* mvMapping;
+#endif // _WIN32
+};
+
+#endif // _CMAPPEDFILE_H_
@@ -0,0 +1,291 @@
+#include "cPackedRegArchValue.h"
+#include "cProfile.h"
+#include <cstring>
+#include <new>
+
+using namespace RegArchLib;
+
+// Doubles per block, rounded up to a multiple of the alignment
+static size_t PaddedSize(size_t theN)
+{
+    const size_t myStep = cPackedRegArchValue::msAlign / sizeof(double);
+    return (theN + myStep - 1) / myStep * myStep;
+}
+
+cPackedRegArchValue::cPackedRegArchValue(uint theSize, cDMatrix* theXt, cDMatrix* theXvt)
+    : cRegArchValue(theSize, theXt, theXvt), mvArena(NULL), mvArenaSize(0)
+{
+    for (int i = 0; i < eNVector + eNMatrix; i++)
+        mvExternal[i] = false;
+    Pack();
+}
+
+cPackedRegArchValue::cPackedRegArchValue(const cDVector& theYt, cDMatrix* theXt, cDMatrix* theXvt)
+    : cRegArchValue(const_cast<cDVector*>(&theYt), theXt, theXvt), mvArena(NULL), mvArenaSize(0)
+{
+    for (int i = 0; i < eNVector + eNMatrix; i++)
+        mvExternal[i] = false;
+    Pack();
+}
+
+cPackedRegArchValue::~cPackedRegArchValue()
+{
+    // The members do not own their data: free them before the arena
+    cRegArchValue::Delete();
+    FreeArena();
+}
+
+gsl_vector* cPackedRegArchValue::Vector(int theIndex) const
+{
+    const cDVector* myVect[eNVector] = { &mYt, &mMt, &mHt, &mUt, &mEpst };
+    return myVect[theIndex]->GetGSLVector();
+}
+
+gsl_matrix* cPackedRegArchValue::Matrix(int theIndex) const
+{
+    return (theIndex == 0) ? mXt.GetGSLMatrix() : mXvt.GetGSLMatrix();
+}
+
+bool cPackedRegArchValue::InArena(const double* thePtr) const
+{
+    return mvArena != NULL && thePtr >= mvArena && thePtr < mvArena + mvArenaSize / sizeof(double);
+}
+
+void cPackedRegArchValue::FreeArena(void)
+{
+    if (mvArena != NULL)
+        ::operator delete(mvArena, std::align_val_t(msAlign));
+    mvArena = NULL;
+    mvArenaSize = 0;
+}
+
+void cPackedRegArchValue::ReAlloc(uint theSize)
+{
+    if (IsPacked() && mYt.GetSize() == (int)theSize)
+    {
+        // Same layout: clear the series in place, no allocation
+        for (int i = 0; i < eNVector; i++)
+        {
+            gsl_vector* myV = Vector(i);
+            if (myV != NULL && myV->size > 0)
+                memset(myV->data, 0, myV->size * sizeof(double));
+        }
+        return;
+    }
+    cRegArchValue::ReAlloc(theSize);
+    Pack();
+}
+
+void cPackedRegArchValue::ReAlloc(cDVector& theYt)
+{
+    if (IsPacked() && mYt.GetSize() == theYt.GetSize())
+    {
+        ReAlloc((uint)theYt.GetSize());
+        gsl_vector* myYt = Vector(0);
+        for (size_t t = 0; t < myYt->size; t++)
+            myYt->data[t] = theYt[(int)t];
+        return;
+    }
+    cRegArchValue::ReAlloc(theYt);
+    Pack();
+}
+
+void cPackedRegArchValue::SetVectorData(int theIndex, double* theData)
+{
+    gsl_vector* myV = Vector(theIndex);
+    if (myV->owner)
+        gsl_block_free(myV->block);
+    mvBlock[theIndex].size = myV->size;
+    mvBlock[theIndex].data = theData;
+    myV->block = &mvBlock[theIndex];
+    myV->data = theData;
+    myV->stride = 1;
+    myV->owner = 0;
+}
+
+void cPackedRegArchValue::SetMatrixData(int theIndex, double* theData)
+{
+    gsl_matrix* myM = Matrix(theIndex);
+    if (myM->owner)
+        gsl_block_free(myM->block);
+    mvBlock[eNVector + theIndex].size = myM->size1 * myM->size2;
+    mvBlock[eNVector + theIndex].data = theData;
+    myM->block = &mvBlock[eNVector + theIndex];
+    myM->data = theData;
+    myM->tda = myM->size2;
+    myM->owner = 0;
+}
+
+bool cPackedRegArchValue::IsExternal(int theIndex) const
+{
+    if (!mvExternal[theIndex])
+        return false;
+    const double* myData = (theIndex < eNVector)
+        ? ((Vector(theIndex) != NULL) ? Vector(theIndex)->data : NULL)
+        : ((Matrix(theIndex - eNVector) != NULL) ? Matrix(theIndex - eNVector)->data : NULL);
+    return myData != NULL && myData == mvBlock[theIndex].data;
+}
+
+void cPackedRegArchValue::Pack(void)
+{
+    Gather(false);
+}
+
+void cPackedRegArchValue::Gather(bool theKeepExternal)
+{
+    size_t mySize[eNVector + eNMatrix];
+    bool myKeep[eNVector + eNMatrix];
+    size_t myTotal = 0;
+    for (int i = 0; i < eNVector + eNMatrix; i++)
+    {
+        myKeep[i] = theKeepExternal && IsExternal(i);
+        if (i < eNVector)
+            mySize[i] = (Vector(i) != NULL) ? Vector(i)->size : 0;
+        else
+            mySize[i] = (Matrix(i - eNVector) != NULL) ? Matrix(i - eNVector)->size1 * Matrix(i - eNVector)->size2 : 0;
+        if (myKeep[i])
+            mySize[i] = 0;
+        myTotal += PaddedSize(mySize[i]);
+    }
+
+    REGARCH_PROFILE_COUNT("alloc", "cPackedRegArchValue", "Pack", 1);
+    double* myArena = (myTotal > 0)
+        ? static_cast<double*>(::operator new(myTotal * sizeof(double), std::align_val_t(msAlign)))
+        : NULL;
+
+    // Copy every member into its block and point it there. The old storage
+    // is released after the copy, it may be the previous arena.
+    size_t myOffset = 0;
+    for (int i = 0; i < eNVector; i++)
+    {
+        if (mySize[i] == 0)
+            continue;
+        gsl_vector* myV = Vector(i);
+        double* myData = myArena + myOffset;
+        for (size_t t = 0; t < myV->size; t++)
+            myData[t] = myV->data[t * myV->stride];
+        SetVectorData(i, myData);
+        myOffset += PaddedSize(mySize[i]);
+    }
+    for (int i = 0; i < eNMatrix; i++)
+    {
+        if (mySize[eNVector + i] == 0)
+            continue;
+        gsl_matrix* myM = Matrix(i);
+        double* myData = myArena + myOffset;
+        for (size_t r = 0; r < myM->size1; r++)
+            memcpy(myData + r * myM->size2, myM->data + r * myM->tda, myM->size2 * sizeof(double));
+        SetMatrixData(i, myData);
+        myOffset += PaddedSize(mySize[eNVector + i]);
+    }
+
+    FreeArena();
+    mvArena = myArena;
+    mvArenaSize = myTotal * sizeof(double);
+    for (int i = 0; i < eNVector + eNMatrix; i++)
+        mvExternal[i] = myKeep[i];
+}
+
+bool cPackedRegArchValue::IsPacked(void) const
+{
+    for (int i = 0; i < eNVector; i++)
+    {
+        gsl_vector* myV = Vector(i);
+        if (myV != NULL && myV->size > 0 && !InArena(myV->data) && !IsExternal(i))
+            return false;
+    }
+    for (int i = 0; i < eNMatrix; i++)
+    {
+        gsl_matrix* myM = Matrix(i);
+        if (myM != NULL && myM->size1 * myM->size2 > 0 && !InArena(myM->data) && !IsExternal(eNVector + i))
+            return false;
+    }
+    return true;
+}
+
+size_t cPackedRegArchValue::GetArenaSize(void) const
+{
+    return mvArenaSize;
+}
+
+void cPackedRegArchValue::Attach(double* theData, uint theSize)
+{
+    // Gives the five gsl_vector the right size, their blocks are then dropped.
+    // The matrices stay where they are.
+    cRegArchValue::ReAlloc(theSize);
+    for (int i = 0; i < eNVector; i++)
+    {
+        if (theSize == 0 || Vector(i) == NULL)
+            continue;
+        SetVectorData(i, theData + (size_t)i * theSize);
+        mvExternal[i] = true;
+    }
+}
+
+bool cPackedRegArchValue::MoveData(double* theYt, uint theSize, double* theXt, uint theNXtCol, double* theXvt, uint theNXvtCol)
+{
+    double* myData[eNMatrix] = { theXt, theXvt };
+    uint myNCol[eNMatrix] = { theNXtCol, theNXvtCol };
+    if (theSize == 0 || mYt.GetSize() != (int)theSize || !IsExternal(0) || !IsPacked())
+        return false;
+    for (int i = 0; i < eNMatrix; i++)
+    {
+        bool myGiven = myData[i] != NULL && myNCol[i] > 0;
+        gsl_matrix* myM = Matrix(i);
+        if (myGiven != IsExternal(eNVector + i) || (myGiven && myM->size2 != myNCol[i]))
+            return false;
+    }
+
+    Vector(0)->data = mvBlock[0].data = theYt;
+    for (int i = 0; i < eNMatrix; i++)
+        if (myData[i] != NULL && myNCol[i] > 0)
+            Matrix(i)->data = mvBlock[eNVector + i].data = myData[i];
+    for (int i = 1; i < eNVector; i++)
+        if (Vector(i) != NULL && Vector(i)->size > 0)
+            memset(Vector(i)->data, 0, Vector(i)->size * sizeof(double));
+    return true;
+}
+
+void cPackedRegArchValue::AttachData(double* theYt, uint theSize, double* theXt, uint theNXtCol, double* theXvt, uint theNXvtCol)
+{
+    // Same shape as the current attachment: the arena is reused
+    if (MoveData(theYt, theSize, theXt, theNXtCol, theXvt, theNXvtCol))
+        return;
+    cRegArchValue::ReAlloc(theSize);
+    if (theXt != NULL && theNXtCol > 0)
+        ReAllocXt(theSize, theNXtCol);
+    if (theXvt != NULL && theNXvtCol > 0)
+        ReAllocXvt(theSize, theNXvtCol);
+    for (int i = 0; i < eNVector + eNMatrix; i++)
+        mvExternal[i] = false;
+    if (theSize > 0)
+    {
+        SetVectorData(0, theYt);
+        mvExternal[0] = true;
+        if (theXt != NULL && theNXtCol > 0)
+        {
+            SetMatrixData(0, theXt);
+            mvExternal[eNVector] = true;
+        }
+        if (theXvt != NULL && theNXvtCol > 0)
+        {
+            SetMatrixData(1, theXvt);
+            mvExternal[eNVector + 1] = true;
+        }
+    }
+    // The other members go to the arena
+    Gather(true);
+}
+
+bool cPackedRegArchValue::IsAttached(void) const
+{
+    for (int i = 0; i < eNVector + eNMatrix; i++)
+        if (IsExternal(i))
+            return true;
+    return false;
+}
+
+size_t cPackedRegArchValue::GetAttachSize(uint theSize)
+{
+    return (size_t)eNVector * theSize * sizeof(double);
+}
@@ -0,0 +1,94 @@
+#ifndef _CPACKEDREGARCHVALUE_H_
+#define _CPACKEDREGARCHVALUE_H_
+
+#include "StdAfxRegArchLib.h"
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+
+/*!
+ * \file cPackedRegArchValue.h
+ * \brief cRegArchValue whose series live in one aligned arena.
+ *
+ * A cRegArchValue allocates mYt, mMt, mHt, mUt, mEpst, mXt and mXvt
+ * separately. cPackedRegArchValue keeps the same members, and so works with
+ * every RegArchLib function, but their GSL storage points into a single
+ * allocation:
+ *
+ *   | Yt | Mt | Ht | Ut | Epst | Xt (row-major) | Xvt (row-major) |
+ *
+ * Each block starts on a 64-byte boundary. The recursions read the five
+ * series at the same date from one region instead of seven heap blocks, and
+ * ReAlloc makes one allocation, reused when the size does not change.
+ *
+ * The members stay ordinary cDVector / cDMatrix: a library call that
+ * reallocates one of them moves it back to its own heap block (IsPacked()
+ * then returns false), Pack() gathers them again.
+ *
+ * Attach() points the five series at storage owned by someone else (a
+ * shared memory block), laid out as | Yt | Mt | Ht | Ut | Epst |, n values
+ * each. Nothing is copied: the values of one process are seen by all the
+ * others. AttachData() does the same for Yt, Xt and Xvt only (a read-only
+ * data set), the computed series going to the arena. Pack() copies
+ * everything back into a private arena.
+ */
+class cPackedRegArchValue : public RegArchLib::cRegArchValue
+{
+public:
+    cPackedRegArchValue(uint theSize = 0, RegArchLib::cDMatrix* theXt = NULL, RegArchLib::cDMatrix* theXvt = NULL);
+    cPackedRegArchValue(const RegArchLib::cDVector& theYt, RegArchLib::cDMatrix* theXt = NULL, RegArchLib::cDMatrix* theXvt = NULL);
+    virtual ~cPackedRegArchValue();
+    cPackedRegArchValue(const cPackedRegArchValue&) = delete;
+    cPackedRegArchValue& operator=(const cPackedRegArchValue&) = delete;
+
+    /*! Resizes the five series to theSize (zero), in the arena */
+    void ReAlloc(uint theSize);
+    /*! Copies theYt and resizes the other series, in the arena */
+    void ReAlloc(RegArchLib::cDVector& theYt);
+    /*! Moves the current contents of all the members into a fresh arena */
+    void Pack(void);
+    /*! True if every allocated member still points into the arena */
+    bool IsPacked(void) const;
+    /*! Bytes of the arena */
+    size_t GetArenaSize(void) const;
+    /*! Points the five series at theData (5 * theSize doubles, see above). theData must outlive the value or the next Pack() */
+    void Attach(double* theData, uint theSize);
+    /*!
+     * Sizes the value for theSize dates and points Yt at theYt, and Xt, Xvt
+     * at theXt, theXvt (theSize x nCol, row-major) when given, without any
+     * copy. The other series are put in the arena. Attaching again with the
+     * same size and columns only moves the pointers and clears the other
+     * series, the arena is reused.
+     */
+    void AttachData(double* theYt, uint theSize, double* theXt = NULL, uint theNXtCol = 0, double* theXvt = NULL, uint theNXvtCol = 0);
+    /*! True if a member points to storage given to Attach or AttachData */
+    bool IsAttached(void) const;
+    /*! Bytes needed by Attach for theSize dates */
+    static size_t GetAttachSize(uint theSize);
+
+    static const size_t msAlign = 64;
+
+private:
+    enum { eNVector = 5, eNMatrix = 2 };
+    gsl_vector* Vector(int theIndex) const;
+    gsl_matrix* Matrix(int theIndex) const;
+    bool InArena(const double* thePtr) const;
+    void FreeArena(void);
+    // Points member theIndex at theData, its own block is freed
+    void SetVectorData(int theIndex, double* theData);
+    void SetMatrixData(int theIndex, double* theData);
+    // Member theIndex (vectors then matrices) still uses the external storage
+    bool IsExternal(int theIndex) const;
+    // AttachData without allocation, false if the shape differs
+    bool MoveData(double* theYt, uint theSize, double* theXt, uint theNXtCol, double* theXvt, uint theNXvtCol);
+    // Pack, leaving the external members where they are if theKeepExternal
+    void Gather(bool theKeepExternal);
+
+    double* mvArena;
+    size_t mvArenaSize;
+    // Members pointing to storage given to Attach / AttachData, not owned
+    bool mvExternal[eNVector + eNMatrix];
+    // Block descriptors of the members, the arena owns the data
+    gsl_block mvBlock[eNVector + eNMatrix];
+};
+
+#endif // _CPACKEDREGARCHVALUE_H_
@@ -0,0 +1,388 @@
+#include "cParallelNumericDerivative.h"
+#include "PythonConversion.h"
+#include "RegArchBatchCompute.h"
+#include <cfloat>
+#include <cmath>
+
+using namespace RegArchLib;
+
+cParallelNumericDerivative::cParallelNumericDerivative(uint theNThread, double theh, bool theAdaptive,
+    double theTypicalScale)
+    : mvPool(theNThread), mvh(theh), mvAdaptive(theAdaptive), mvTypicalScale(theTypicalScale), mvSerial(false),
+      mvNParam(0)
+{
+}
+
+cParallelNumericDerivative::~cParallelNumericDerivative()
+{
+    Delete();
+}
+
+void cParallelNumericDerivative::Delete(void)
+{
+    for (uint w = 0; w < mvModel.size(); w++)
+        delete mvModel[w];
+    for (uint w = 0; w < mvValue.size(); w++)
+        delete mvValue[w];
+    mvModel.clear();
+    mvValue.clear();
+    mvParam.clear();
+    mvNParam = 0;
+}
+
+uint cParallelNumericDerivative::GetNThread(void) const
+{
+    return mvPool.GetNThread();
+}
+
+double cParallelNumericDerivative::Geth(void) const
+{
+    return mvh;
+}
+
+void cParallelNumericDerivative::Seth(double theh)
+{
+    mvh = theh;
+}
+
+bool cParallelNumericDerivative::IsAdaptive(void) const
+{
+    return mvAdaptive;
+}
+
+void cParallelNumericDerivative::SetAdaptive(bool theAdaptive)
+{
+    mvAdaptive = theAdaptive;
+}
+
+double cParallelNumericDerivative::GetTypicalScale(void) const
+{
+    return mvTypicalScale;
+}
+
+void cParallelNumericDerivative::SetTypicalScale(double theTypicalScale)
+{
+    mvTypicalScale = theTypicalScale;
+}
+
+uint cParallelNumericDerivative::GetNLLHEval(void) const
+{
+    return (uint)mvPoint.size();
+}
+
+const cDVector& cParallelNumericDerivative::GetGradError(void) const
+{
+    return mvGradError;
+}
+
+const cDMatrix& cParallelNumericDerivative::GetHessError(void) const
+{
+    return mvHessError;
+}
+
+void cParallelNumericDerivative::SyncValue(uint theWorker, const cRegArchValue& theValue)
+{
+    uint myNObs = theValue.mYt.GetSize();
+    bool myHasXt = theValue.mXt.GetNRow() > 0;
+    bool myHasXvt = theValue.mXvt.GetNRow() > 0;
+    cRegArchValue* myValue = mvValue[theWorker];
+
+    if (myValue != NULL
+        && (uint)myValue->mYt.GetSize() == myNObs
+        && myValue->mXt.GetNRow() == theValue.mXt.GetNRow() && myValue->mXt.GetNCol() == theValue.mXt.GetNCol()
+        && myValue->mXvt.GetNRow() == theValue.mXvt.GetNRow() && myValue->mXvt.GetNCol() == theValue.mXvt.GetNCol())
+    {
+        // Same shape: only refresh the data
+        myValue->mYt = theValue.mYt;
+        if (myHasXt)
+            myValue->mXt = theValue.mXt;
+        if (myHasXvt)
+            myValue->mXvt = theValue.mXvt;
+        return;
+    }
+
+    delete myValue;
+    myValue = new cRegArchValue(myNObs,
+        myHasXt ? const_cast<cDMatrix*>(&theValue.mXt) : NULL,
+        myHasXvt ? const_cast<cDMatrix*>(&theValue.mXvt) : NULL);
+    myValue->mYt = theValue.mYt;
+    mvValue[theWorker] = myValue;
+}
+
+/*!
+ * theOrder is the order of the derivative the steps are tuned for. In adaptive
+ * mode, Richardson extrapolation leaves an O(h^4) truncation error against a
+ * rounding error of O(eps/h^theOrder), hence h = scale * eps^(1/(4+theOrder)).
+ * The scale is max(|theta_i|, typical scale): a parameter at 1e-12 gets a step
+ * of the order of the typical scale, not one below the rounding of theta_i.
+ */
+void cParallelNumericDerivative::Prepare(const cRegArchModel& theModel, const cRegArchValue& theValue, uint theOrder)
+{
+    mvSerial = HasPythonComponent(theModel);
+    uint myNWorker = mvSerial ? 1 : mvPool.GetNThread();
+
+    if (mvModel.size() < myNWorker)
+    {
+        mvModel.resize(myNWorker, NULL);
+        mvValue.resize(myNWorker, NULL);
+        mvParam.resize(myNWorker);
+    }
+
+    mvNParam = const_cast<cRegArchModel&>(theModel).GetNParam();
+    if (mvTheta.GetSize() != (int)mvNParam)
+    {
+        mvTheta.ReAlloc(mvNParam);
+        mvStep.ReAlloc(mvNParam);
+    }
+    theModel.RegArchParamToVector(mvTheta);
+    double myRelStep = mvAdaptive ? pow(DBL_EPSILON, 1.0 / (4.0 + theOrder)) : mvh;
+    for (uint i = 0; i < mvNParam; i++)
+    {
+        double myScale = fabs(mvTheta[i]);
+        mvStep[i] = myRelStep * ((myScale > mvTypicalScale) ? myScale : mvTypicalScale);
+    }
+
+    for (uint w = 0; w < myNWorker; w++)
+    {
+        if (!mvSerial)
+        {
+            REGARCH_PROFILE_COUNT("alloc", "cRegArchModel", "cParallelNumericDerivative", mvModel[w] == NULL);
+            if (mvModel[w] == NULL)
+                mvModel[w] = new cRegArchModel(theModel);
+            else
+                *mvModel[w] = theModel;
+        }
+        SyncValue(w, theValue);
+        if (mvParam[w].GetSize() != (int)mvNParam)
+            mvParam[w].ReAlloc(mvNParam);
+    }
+}
+
+double cParallelNumericDerivative::EvalPoint(uint theWorker, const cRegArchModel& theModel, const sPoint& thePoint)
+{
+    REGARCH_PROFILE_SCOPE("driver", "cParallelNumericDerivative", "EvalPoint");
+    cDVector& myParam = mvParam[theWorker];
+    myParam = mvTheta;
+    if (thePoint.mSi != 0)
+        myParam[thePoint.mI] += thePoint.mSi * mvStep[thePoint.mI];
+    if (thePoint.mSj != 0)
+        myParam[thePoint.mJ] += thePoint.mSj * mvStep[thePoint.mJ];
+
+    if (mvSerial)
+    {
+        // Python components: batched overrides when the subclass has them
+        const_cast<cRegArchModel&>(theModel).VectorToRegArchParam(myParam);
+        return RegArchLLHBatch(theModel, *mvValue[theWorker]);
+    }
+    mvModel[theWorker]->VectorToRegArchParam(myParam);
+    return RegArchLLH(*mvModel[theWorker], *mvValue[theWorker]);
+}
+
+void cParallelNumericDerivative::RunPoints(const cRegArchModel& theModel)
+{
+    uint myNPoint = (uint)mvPoint.size();
+    mvF.resize(myNPoint);
+
+    if (mvSerial)
+    {
+        // Python components: stay on the calling thread, GIL held
+        try
+        {
+            for (uint p = 0; p < myNPoint; p++)
+                mvF[p] = EvalPoint(0, theModel, mvPoint[p]);
+        }
+        catch (...)
+        {
+            const_cast<cRegArchModel&>(theModel).VectorToRegArchParam(mvTheta);
+            throw;
+        }
+        const_cast<cRegArchModel&>(theModel).VectorToRegArchParam(mvTheta);
+        return;
+    }
+
+    auto myBody = [&](uint p, uint theWorker) { mvF[p] = EvalPoint(theWorker, theModel, mvPoint[p]); };
+    if (Py_IsInitialized() && PyGILState_Check())
+    {
+        cScopedGILRelease myNoGIL;
+        mvPool.ParallelFor(myNPoint, myBody);
+    }
+    else
+        mvPool.ParallelFor(myNPoint, myBody);
+}
+
+void cParallelNumericDerivative::AddGradPoints(double theMult)
+{
+    for (uint i = 0; i < mvNParam; i++)
+    {
+        mvPoint.push_back({ i, i, theMult, 0.0 });
+        mvPoint.push_back({ i, i, -theMult, 0.0 });
+    }
+}
+
+void cParallelNumericDerivative::AddHessPoints(double theMult)
+{
+    // [f(+e_i), f(-e_i)]_i [f(++), f(+-), f(-+), f(--)]_{i<j}
+    AddGradPoints(theMult);
+    for (uint i = 0; i < mvNParam; i++)
+        for (uint j = i + 1; j < mvNParam; j++)
+        {
+            mvPoint.push_back({ i, j, theMult, theMult });
+            mvPoint.push_back({ i, j, theMult, -theMult });
+            mvPoint.push_back({ i, j, -theMult, theMult });
+            mvPoint.push_back({ i, j, -theMult, -theMult });
+        }
+}
+
+void cParallelNumericDerivative::BuildGradPoints(void)
+{
+    mvPoint.clear();
+    AddGradPoints(1.0);
+    if (mvAdaptive)
+        AddGradPoints(0.5);
+}
+
+void cParallelNumericDerivative::BuildHessPoints(void)
+{
+    // f(theta) first, then one block per step level
+    mvPoint.clear();
+    mvPoint.push_back({ 0, 0, 0.0, 0.0 });
+    AddHessPoints(1.0);
+    if (mvAdaptive)
+        AddHessPoints(0.5);
+}
+
+void cParallelNumericDerivative::GradFromPoints(uint& thePos, double theMult, cDVector& theGrad) const
+{
+    theGrad.ReAlloc(mvNParam);
+    for (uint i = 0; i < mvNParam; i++, thePos += 2)
+        theGrad[i] = (mvF[thePos] - mvF[thePos + 1]) / (2.0 * theMult * mvStep[i]);
+}
+
+void cParallelNumericDerivative::HessFromPoints(uint& thePos, double theMult, cDVector* theGrad, cDMatrix& theHess) const
+{
+    double myF0 = mvF[0];
+
+    if (theGrad != NULL)
+        theGrad->ReAlloc(mvNParam);
+    theHess.ReAlloc(mvNParam, mvNParam);
+
+    for (uint i = 0; i < mvNParam; i++, thePos += 2)
+    {
+        double myh = theMult * mvStep[i];
+        if (theGrad != NULL)
+            (*theGrad)[i] = (mvF[thePos] - mvF[thePos + 1]) / (2.0 * myh);
+        theHess[i][i] = (mvF[thePos] - 2.0 * myF0 + mvF[thePos + 1]) / (myh * myh);
+    }
+    for (uint i = 0; i < mvNParam; i++)
+        for (uint j = i + 1; j < mvNParam; j++, thePos += 4)
+        {
+            double myHij = (mvF[thePos] - mvF[thePos + 1] - mvF[thePos + 2] + mvF[thePos + 3])
+                / (4.0 * theMult * theMult * mvStep[i] * mvStep[j]);
+            theHess[i][j] = theHess[j][i] = myHij;
+        }
+}
+
+/*!
+ * Richardson step on central differences (error in h^2, step ratio 2):
+ * D = D(h/2) + (D(h/2) - D(h)) / 3, and |D(h/2) - D(h)| / 3 is the
+ * estimated truncation error reported with the result.
+ */
+static void Richardson(const cDVector& theCoarse, cDVector& theFine, cDVector& theError)
+{
+    uint myN = theFine.GetSize();
+    theError.ReAlloc(myN);
+    for (uint i = 0; i < myN; i++)
+    {
+        double myDiff = (theFine[i] - theCoarse[i]) / 3.0;
+        theFine[i] += myDiff;
+        theError[i] = fabs(myDiff);
+    }
+}
+
+static void Richardson(const cDMatrix& theCoarse, cDMatrix& theFine, cDMatrix& theError)
+{
+    uint myN = theFine.GetNRow();
+    theError.ReAlloc(myN, myN);
+    for (uint i = 0; i < myN; i++)
+        for (uint j = 0; j < myN; j++)
+        {
+            double myDiff = (theFine[i][j] - theCoarse[i][j]) / 3.0;
+            theFine[i][j] += myDiff;
+            theError[i][j] = fabs(myDiff);
+        }
+}
+
+void cParallelNumericDerivative::AssembleGrad(cDVector& theGrad)
+{
+    uint myPos = 0;
+    GradFromPoints(myPos, 1.0, theGrad);
+    mvHessError.Delete();
+    if (!mvAdaptive)
+    {
+        mvGradError.Delete();
+        return;
+    }
+
+    cDVector myCoarse(theGrad);
+    GradFromPoints(myPos, 0.5, theGrad);
+    Richardson(myCoarse, theGrad, mvGradError);
+}
+
+void cParallelNumericDerivative::AssembleHess(cDVector* theGrad, cDMatrix& theHess)
+{
+    uint myPos = 1;
+    HessFromPoints(myPos, 1.0, theGrad, theHess);
+    if (!mvAdaptive)
+    {
+        mvGradError.Delete();
+        mvHessError.Delete();
+        return;
+    }
+
+    cDMatrix myCoarseHess(theHess);
+    if (theGrad != NULL)
+    {
+        cDVector myCoarseGrad(*theGrad);
+        HessFromPoints(myPos, 0.5, theGrad, theHess);
+        Richardson(myCoarseGrad, *theGrad, mvGradError);
+    }
+    else
+    {
+        HessFromPoints(myPos, 0.5, NULL, theHess);
+        mvGradError.Delete();
+    }
+    Richardson(myCoarseHess, theHess, mvHessError);
+}
+
+void cParallelNumericDerivative::ComputeGradLLH(const cRegArchModel& theModel, const cRegArchValue& theValue, cDVector& theGrad)
+{
+    Prepare(theModel, theValue, 1);
+    BuildGradPoints();
+    RunPoints(theModel);
+    AssembleGrad(theGrad);
+}
+
+void cParallelNumericDerivative::ComputeHessLLH(const cRegArchModel& theModel, const cRegArchValue& theValue, cDMatrix& theHess)
+{
+    Prepare(theModel, theValue, 2);
+    BuildHessPoints();
+    RunPoints(theModel);
+    AssembleHess(NULL, theHess);
+}
+
+void cParallelNumericDerivative::ComputeGradAndHessLLH(const cRegArchModel& theModel, const cRegArchValue& theValue,
+    cDVector& theGrad, cDMatrix& theHess)
+{
+    Prepare(theModel, theValue, 2);
+    BuildHessPoints();
+    RunPoints(theModel);
+    AssembleHess(&theGrad, theHess);
+}
+
+void cParallelNumericDerivative::ComputeCov(const cRegArchModel& theModel, const cRegArchValue& theValue, cDMatrix& theCov)
+{
+    cDMatrix myHess;
+    ComputeHessLLH(theModel, theValue, myHess);
+    myHess *= -1.0;
+    theCov = Inv(myHess);
+}
@@ -0,0 +1,110 @@
+#ifndef _CPARALLELNUMERICDERIVATIVE_H_
+#define _CPARALLELNUMERICDERIVATIVE_H_
+
+#include "StdAfxRegArchLib.h"
+#include "cThreadPool.h"
+#include <vector>
+
+/*!
+ * \file cParallelNumericDerivative.h
+ * \brief Central-difference gradient / Hessian / covariance of the log-likelihood,
+ *        with the perturbed likelihood passes spread over a thread pool.
+ *
+ * Every worker owns a copy of the model and a cRegArchValue workspace. Both are
+ * kept between calls: the model copies are refreshed by assignment and the
+ * workspaces are only reallocated when the data shape changes, so the same
+ * object can be used in an estimation loop without reallocating.
+ *
+ * In adaptive mode the steps are chosen per parameter from its scale and the
+ * machine epsilon, and each difference quotient is computed at h and h/2 and
+ * combined by Richardson extrapolation. The difference between the two levels
+ * gives an estimate of the truncation error, available through GetGradError()
+ * and GetHessError() after each call.
+ *
+ * Models with a component implemented in Python cannot be copied nor evaluated
+ * without the GIL: they are evaluated serially on the caller's model, whose
+ * parameters are restored on exit.
+ */
+class cParallelNumericDerivative
+{
+public:
+    /*!
+     * \param theNThread number of workers, 0 for the hardware concurrency
+     * \param theh relative step: parameter i is shifted by h*max(|theta_i|, theTypicalScale)
+     * \param theAdaptive automatic steps and Richardson extrapolation, theh is then unused
+     * \param theTypicalScale floor of the parameter scale, so that a parameter near 0
+     *        is not shifted by a step lost in the rounding of the likelihood
+     */
+    cParallelNumericDerivative(uint theNThread = 0, double theh = 1e-2, bool theAdaptive = false,
+        double theTypicalScale = 1.0);
+    virtual ~cParallelNumericDerivative();
+
+    uint GetNThread(void) const;
+    double Geth(void) const;
+    void Seth(double theh);
+    bool IsAdaptive(void) const;
+    void SetAdaptive(bool theAdaptive);
+    double GetTypicalScale(void) const;
+    void SetTypicalScale(double theTypicalScale);
+    /*! Number of likelihood passes done by the last call */
+    uint GetNLLHEval(void) const;
+
+    /*! Estimated truncation error of the last gradient (adaptive mode only, empty otherwise) */
+    const RegArchLib::cDVector& GetGradError(void) const;
+    /*! Estimated truncation error of the last Hessian (adaptive mode only, empty otherwise) */
+    const RegArchLib::cDMatrix& GetHessError(void) const;
+
+    /*! Gradient of the log-likelihood: 2*k passes, 4*k in adaptive mode */
+    void ComputeGradLLH(const RegArchLib::cRegArchModel& theModel, const RegArchLib::cRegArchValue& theValue,
+        RegArchLib::cDVector& theGrad);
+    /*! Hessian of the log-likelihood: 2*k*k + 1 passes, 4*k*k + 1 in adaptive mode */
+    void ComputeHessLLH(const RegArchLib::cRegArchModel& theModel, const RegArchLib::cRegArchValue& theValue,
+        RegArchLib::cDMatrix& theHess);
+    /*! Gradient and Hessian from the same passes as the Hessian */
+    void ComputeGradAndHessLLH(const RegArchLib::cRegArchModel& theModel, const RegArchLib::cRegArchValue& theValue,
+        RegArchLib::cDVector& theGrad, RegArchLib::cDMatrix& theHess);
+    /*! Inverse of the observed information matrix, i.e. inverse of minus the numeric Hessian */
+    void ComputeCov(const RegArchLib::cRegArchModel& theModel, const RegArchLib::cRegArchValue& theValue,
+        RegArchLib::cDMatrix& theCov);
+
+    /*! Free the worker models and workspaces */
+    void Delete(void);
+
+private:
+    struct sPoint
+    {
+        uint mI, mJ;
+        double mSi, mSj;
+    };
+
+    void Prepare(const RegArchLib::cRegArchModel& theModel, const RegArchLib::cRegArchValue& theValue, uint theOrder);
+    void SyncValue(uint theWorker, const RegArchLib::cRegArchValue& theValue);
+    void AddGradPoints(double theMult);
+    void AddHessPoints(double theMult);
+    void BuildGradPoints(void);
+    void BuildHessPoints(void);
+    void RunPoints(const RegArchLib::cRegArchModel& theModel);
+    double EvalPoint(uint theWorker, const RegArchLib::cRegArchModel& theModel, const sPoint& thePoint);
+    void GradFromPoints(uint& thePos, double theMult, RegArchLib::cDVector& theGrad) const;
+    void HessFromPoints(uint& thePos, double theMult, RegArchLib::cDVector* theGrad, RegArchLib::cDMatrix& theHess) const;
+    void AssembleGrad(RegArchLib::cDVector& theGrad);
+    void AssembleHess(RegArchLib::cDVector* theGrad, RegArchLib::cDMatrix& theHess);
+
+    cThreadPool mvPool;
+    double mvh;
+    bool mvAdaptive;
+    double mvTypicalScale;
+    bool mvSerial;
+    uint mvNParam;
+    std::vector<RegArchLib::cRegArchModel*> mvModel;
+    std::vector<RegArchLib::cRegArchValue*> mvValue;
+    std::vector<RegArchLib::cDVector> mvParam;
+    RegArchLib::cDVector mvTheta;
+    RegArchLib::cDVector mvStep;
+    std::vector<sPoint> mvPoint;
+    std::vector<double> mvF;
+    RegArchLib::cDVector mvGradError;
+    RegArchLib::cDMatrix mvHessError;
+};
+
+#endif // _CPARALLELNUMERICDERIVATIVE_H_
@@ -0,0 +1,266 @@
+#ifndef _CPARAMDISPATCH_H_
+#define _CPARAMDISPATCH_H_
+
+#include "StdAfxRegArchLib.h"
+#include <boost/python.hpp>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+/*!
+ * \file cParamDispatch.h
+ * \brief The unified set / get / realloc methods of the model wrappers.
+ *
+ * Every component wrapper exposes set(value_or_vector, index_or_name,
+ * num_param), get(index_or_name, num_param) and realloc(size_or_vector,
+ * num_param) on top of the Set / Get / ReAlloc overloads of RegArchLib.
+ * The argument is classified once from its Python type, then converted at
+ * most once:
+ *  - float, int: scalar, read directly;
+ *  - str: parameter name;
+ *  - cDVector: used in place, without copy;
+ *  - float64 buffer (NumPy array, memoryview, array('d')): one block copy,
+ *    strided arrays included;
+ *  - any other sequence: one pass over the items.
+ */
+
+/*! Kind of a Python argument */
+typedef enum eParamArgKind
+{
+    eParamArgNone,
+    eParamArgFloat,
+    eParamArgInt,
+    eParamArgName,
+    eParamArgVector,    /*!< wrapped cDVector */
+    eParamArgBuffer,    /*!< 1-D buffer of doubles */
+    eParamArgSequence,
+    eParamArgUnknown
+} eParamArgKind;
+
+/*! Meaning of the two indices of get(i, j) and of set(vector, i, j) */
+typedef enum eParamLayout
+{
+    /*! get(i, p): element i of parameter p. set(vector, i, p) fills parameter p,
+        i is not used (concrete models) */
+    eParamIndexFirst,
+    /*! get(p, i): element i of parameter p. set(vector, p) fills parameter p
+        (cAbstCondMean, cAbstCondVar, cArfima) */
+    eParamNumFirst
+} eParamLayout;
+
+inline bool IsDoubleBuffer(const Py_buffer& theBuf)
+{
+    return theBuf.itemsize == sizeof(double) && theBuf.format != NULL
+        && (strcmp(theBuf.format, "d") == 0 || strcmp(theBuf.format, "<d") == 0 || strcmp(theBuf.format, "=d") == 0);
+}
+
+inline bool IsIntegerBuffer(const Py_buffer& theBuf)
+{
+    size_t myLen = (theBuf.format != NULL) ? strlen(theBuf.format) : 0;
+    return myLen > 0 && strchr("bBhHiIlLqQnN?", theBuf.format[myLen - 1]) != NULL;
+}
+
+/*! Kind of a value argument (first argument of set and realloc) */
+inline eParamArgKind ClassifyParamArg(PyObject* theObj)
+{
+    if (theObj == Py_None)
+        return eParamArgNone;
+    if (PyFloat_Check(theObj))
+        return eParamArgFloat;
+    if (PyLong_Check(theObj))
+        return eParamArgInt;
+    if (PyUnicode_Check(theObj))
+        return eParamArgName;
+    if (boost::python::converter::get_lvalue_from_python(theObj,
+            boost::python::converter::registered<RegArchLib::cDVector>::converters) != NULL)
+        return eParamArgVector;
+    if (PyObject_CheckBuffer(theObj))
+    {
+        Py_buffer myBuf;
+        if (PyObject_GetBuffer(theObj, &myBuf, PyBUF_STRIDES | PyBUF_FORMAT) != 0)
+        {
+            PyErr_Clear();
+            return PySequence_Check(theObj) ? eParamArgSequence : eParamArgUnknown;
+        }
+        eParamArgKind myKind;
+        if (myBuf.ndim == 0)
+            // NumPy scalars and 0-d arrays
+            myKind = IsIntegerBuffer(myBuf) ? eParamArgInt : eParamArgFloat;
+        else if (myBuf.ndim == 1 && IsDoubleBuffer(myBuf))
+            myKind = eParamArgBuffer;
+        else
+            myKind = eParamArgSequence;
+        PyBuffer_Release(&myBuf);
+        return myKind;
+    }
+    if (PySequence_Check(theObj))
+        return eParamArgSequence;
+    if (PyIndex_Check(theObj))
+        return eParamArgInt;
+    if (Py_TYPE(theObj)->tp_as_number != NULL && Py_TYPE(theObj)->tp_as_number->nb_float != NULL)
+        return eParamArgFloat;
+    return eParamArgUnknown;
+}
+
+inline double ParamDouble(PyObject* theObj)
+{
+    double myRes = PyFloat_AsDouble(theObj);
+    if (myRes == -1.0 && PyErr_Occurred())
+        boost::python::throw_error_already_set();
+    return myRes;
+}
+
+/*! Index or parameter number; theDefault if theObj is None */
+inline uint ParamUint(PyObject* theObj, uint theDefault, const char* theError)
+{
+    if (theObj == Py_None)
+        return theDefault;
+    if (!PyLong_Check(theObj) && !PyIndex_Check(theObj))
+        throw std::runtime_error(theError);
+    boost::python::handle<> myInt(PyNumber_Index(theObj));
+    unsigned long myRes = PyLong_AsUnsignedLong(myInt.get());
+    if (myRes == (unsigned long)-1 && PyErr_Occurred())
+        boost::python::throw_error_already_set();
+    return (uint)myRes;
+}
+
+inline std::string ParamName(PyObject* theObj)
+{
+    Py_ssize_t mySize;
+    const char* myData = PyUnicode_AsUTF8AndSize(theObj, &mySize);
+    if (myData == NULL)
+        boost::python::throw_error_already_set();
+    return std::string(myData, (size_t)mySize);
+}
+
+/*!
+ * The vector held by theObj, classified as theKind: the wrapped cDVector
+ * itself, or theTmp filled in one pass.
+ */
+inline const RegArchLib::cDVector& ParamVector(PyObject* theObj, eParamArgKind theKind, RegArchLib::cDVector& theTmp)
+{
+    if (theKind == eParamArgVector)
+        return *static_cast<RegArchLib::cDVector*>(boost::python::converter::get_lvalue_from_python(theObj,
+            boost::python::converter::registered<RegArchLib::cDVector>::converters));
+    if (theKind == eParamArgBuffer)
+    {
+        Py_buffer myBuf;
+        if (PyObject_GetBuffer(theObj, &myBuf, PyBUF_STRIDES | PyBUF_FORMAT) != 0)
+            boost::python::throw_error_already_set();
+        size_t mySize = (size_t)myBuf.shape[0];
+        theTmp.ReAlloc((int)mySize);
+        if (mySize > 0)
+        {
+            gsl_vector* myDest = theTmp.GetGSLVector();
+            const char* mySrc = static_cast<const char*>(myBuf.buf);
+            if (myBuf.strides[0] == sizeof(double) && myDest->stride == 1)
+                memcpy(myDest->data, mySrc, mySize * sizeof(double));
+            else
+                for (size_t i = 0; i < mySize; i++)
+                    myDest->data[i * myDest->stride] = *reinterpret_cast<const double*>(mySrc + i * myBuf.strides[0]);
+        }
+        PyBuffer_Release(&myBuf);
+        return theTmp;
+    }
+    if (theKind == eParamArgSequence)
+    {
+        boost::python::handle<> mySeq(PySequence_Fast(theObj, "expected a sequence of floats"));
+        Py_ssize_t mySize = PySequence_Fast_GET_SIZE(mySeq.get());
+        PyObject** myItems = PySequence_Fast_ITEMS(mySeq.get());
+        theTmp.ReAlloc((int)mySize);
+        for (Py_ssize_t i = 0; i < mySize; i++)
+            theTmp[(int)i] = ParamDouble(myItems[i]);
+        return theTmp;
+    }
+    throw std::runtime_error("First argument must be a float, a cDVector, a float64 array or a sequence of floats");
+}
+
+/*!
+ * set(value, index, num_param) -> Set(value, index, num_param)
+ * set(value, name, index)      -> Set(value, name, index)
+ * set(vector, name)            -> Set(vector, name)
+ * set(vector, ...)             -> Set(vector, num), num as given by theLayout
+ */
+template <class T>
+void ParamSet(T& theSelf, const boost::python::object& theValue, const boost::python::object& theIndex,
+    const boost::python::object& theNumParam, eParamLayout theLayout)
+{
+    static const char* myIndexError = "Second argument must be either a parameter name (string) or an index (uint)";
+    PyObject* myIndex = theIndex.ptr();
+    bool myByName = PyUnicode_Check(myIndex);
+    if (!myByName && !PyLong_Check(myIndex) && !PyIndex_Check(myIndex))
+        throw std::runtime_error(myIndexError);
+
+    eParamArgKind myKind = ClassifyParamArg(theValue.ptr());
+    if (myKind == eParamArgFloat || myKind == eParamArgInt)
+    {
+        double myValue = ParamDouble(theValue.ptr());
+        uint myNum = ParamUint(theNumParam.ptr(), 0, "Third argument must be an index (uint)");
+        if (myByName)
+            theSelf.Set(myValue, ParamName(myIndex), myNum);
+        else
+            theSelf.Set(myValue, ParamUint(myIndex, 0, myIndexError), myNum);
+        return;
+    }
+
+    RegArchLib::cDVector myTmp;
+    const RegArchLib::cDVector& myVector = ParamVector(theValue.ptr(), myKind, myTmp);
+    if (myByName)
+        theSelf.Set(myVector, ParamName(myIndex));
+    else if (theLayout == eParamNumFirst)
+        theSelf.Set(myVector, ParamUint(myIndex, 0, myIndexError));
+    else
+        theSelf.Set(myVector, ParamUint(theNumParam.ptr(), 0, "Third argument must be a parameter number (uint)"));
+}
+
+/*!
+ * get(name) / get(num)  -> the parameter vector (a reference, not a copy)
+ * get(name, index)      -> element index of the parameter
+ * get(i, j)             -> one element, read as given by theLayout
+ */
+template <class T>
+boost::python::object ParamGet(T& theSelf, const boost::python::object& theKey, const boost::python::object& theSub,
+    eParamLayout theLayout)
+{
+    static const char* myKeyError = "First argument must be either a parameter name (string) or a parameter number (uint)";
+    static const char* mySubError = "Second argument must be an index (uint)";
+    PyObject* myKey = theKey.ptr();
+    if (PyUnicode_Check(myKey))
+    {
+        std::string myName = ParamName(myKey);
+        if (theSub.is_none())
+            return boost::python::object(boost::ref(theSelf.Get(myName)));
+        return boost::python::object(theSelf.Get(myName, ParamUint(theSub.ptr(), 0, mySubError)));
+    }
+    if (myKey == Py_None)
+        throw std::runtime_error(myKeyError);
+    uint myFirst = ParamUint(myKey, 0, myKeyError);
+    if (theSub.is_none())
+        return boost::python::object(boost::ref(theSelf.Get(myFirst)));
+    uint mySecond = ParamUint(theSub.ptr(), 0, mySubError);
+    if (theLayout == eParamIndexFirst)
+        return boost::python::object(theSelf.Get(myFirst, mySecond));
+    return boost::python::object(theSelf.Get(mySecond, myFirst));
+}
+
+/*!
+ * realloc(size, num_param)   -> ReAlloc(size, num_param)
+ * realloc(vector, num_param) -> ReAlloc(vector, num_param)
+ */
+template <class T>
+void ParamReAlloc(T& theSelf, const boost::python::object& theSizeOrVector, const boost::python::object& theNumParam)
+{
+    uint myNum = ParamUint(theNumParam.ptr(), 0, "Second argument must be a parameter number (uint)");
+    eParamArgKind myKind = ClassifyParamArg(theSizeOrVector.ptr());
+    if (myKind == eParamArgInt)
+    {
+        theSelf.ReAlloc(ParamUint(theSizeOrVector.ptr(), 0, "First argument must be a uint size"), myNum);
+        return;
+    }
+    if (myKind == eParamArgFloat || myKind == eParamArgName || myKind == eParamArgNone)
+        throw std::runtime_error("First argument must be a uint size, a cDVector, a float64 array or a sequence of floats");
+    RegArchLib::cDVector myTmp;
+    theSelf.ReAlloc(ParamVector(theSizeOrVector.ptr(), myKind, myTmp), myNum);
+}
+
+#endif // _CPARAMDISPATCH_H_
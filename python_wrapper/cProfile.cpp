@@ -0,0 +1,194 @@
+#include "cProfile.h"
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#endif
+
+namespace
+{
+    typedef struct sProfileKey
+    {
+        const char* mKind;
+        const char* mClass;
+        const char* mMethod;
+        bool operator==(const sProfileKey& theOther) const
+        {
+            return mKind == theOther.mKind && mClass == theOther.mClass && mMethod == theOther.mMethod;
+        }
+    } sProfileKey;
+
+    struct cProfileKeyHash
+    {
+        size_t operator()(const sProfileKey& theKey) const
+        {
+            std::hash<const void*> myHash;
+            return myHash(theKey.mKind) ^ (myHash(theKey.mClass) * 31) ^ (myHash(theKey.mMethod) * 131);
+        }
+    };
+
+    // The label is built on first use: class names may come from Python types
+    typedef struct sProfileSlot
+    {
+        std::string mLabel;
+        sProfileEntry mEntry;
+    } sProfileSlot;
+
+    // One per thread, only its thread writes, Snapshot and Reset read under mLock
+    typedef struct sProfileTable
+    {
+        std::mutex mLock;
+        std::unordered_map<sProfileKey, sProfileSlot, cProfileKeyHash> mSlots;
+    } sProfileTable;
+
+    typedef struct sProfileRegistry
+    {
+        std::mutex mLock;
+        std::vector<sProfileTable*> mTables;
+        // Totals of the threads that have exited
+        std::map<std::string, sProfileEntry> mRetired;
+        std::unordered_map<std::type_index, std::string> mTypeNames;
+    } sProfileRegistry;
+
+    // Never destroyed: threads may exit after the static destructors ran
+    sProfileRegistry& Registry(void)
+    {
+        static sProfileRegistry* myRegistry = new sProfileRegistry;
+        return *myRegistry;
+    }
+
+    void Merge(std::map<std::string, sProfileEntry>& theDest, const std::string& theLabel, const sProfileEntry& theEntry)
+    {
+        sProfileEntry& myDest = theDest[theLabel];
+        myDest.mCount += theEntry.mCount;
+        myDest.mNs += theEntry.mNs;
+    }
+
+    struct cProfileThread
+    {
+        cProfileThread()
+        {
+            mvTable = new sProfileTable;
+            std::lock_guard<std::mutex> myLock(Registry().mLock);
+            Registry().mTables.push_back(mvTable);
+        }
+        ~cProfileThread()
+        {
+            sProfileRegistry& myRegistry = Registry();
+            std::lock_guard<std::mutex> myLock(myRegistry.mLock);
+            for (size_t i = 0; i < myRegistry.mTables.size(); i++)
+                if (myRegistry.mTables[i] == mvTable)
+                {
+                    myRegistry.mTables.erase(myRegistry.mTables.begin() + i);
+                    break;
+                }
+            for (auto& mySlot : mvTable->mSlots)
+                Merge(myRegistry.mRetired, mySlot.second.mLabel, mySlot.second.mEntry);
+            delete mvTable;
+        }
+        sProfileTable* mvTable;
+    };
+
+    sProfileTable& LocalTable(void)
+    {
+        thread_local cProfileThread myThread;
+        return *myThread.mvTable;
+    }
+
+    unsigned long long NowNs(void)
+    {
+        return (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+bool cProfile::IsEnabled(void)
+{
+#ifdef REGARCH_ENABLE_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void cProfile::Add(const char* theKind, const char* theClass, const char* theMethod,
+    unsigned long long theCount, unsigned long long theNs)
+{
+    sProfileTable& myTable = LocalTable();
+    sProfileKey myKey = { theKind, theClass, theMethod };
+    std::lock_guard<std::mutex> myLock(myTable.mLock);
+    sProfileSlot& mySlot = myTable.mSlots[myKey];
+    if (mySlot.mLabel.empty())
+        mySlot.mLabel = std::string(theKind) + "/" + theClass + "/" + theMethod;
+    mySlot.mEntry.mCount += theCount;
+    mySlot.mEntry.mNs += theNs;
+}
+
+std::map<std::string, sProfileEntry> cProfile::Snapshot(void)
+{
+    sProfileRegistry& myRegistry = Registry();
+    std::lock_guard<std::mutex> myLock(myRegistry.mLock);
+    std::map<std::string, sProfileEntry> myRes(myRegistry.mRetired);
+    for (sProfileTable* myTable : myRegistry.mTables)
+    {
+        std::lock_guard<std::mutex> myTableLock(myTable->mLock);
+        for (auto& mySlot : myTable->mSlots)
+            Merge(myRes, mySlot.second.mLabel, mySlot.second.mEntry);
+    }
+    return myRes;
+}
+
+void cProfile::Reset(void)
+{
+    sProfileRegistry& myRegistry = Registry();
+    std::lock_guard<std::mutex> myLock(myRegistry.mLock);
+    myRegistry.mRetired.clear();
+    for (sProfileTable* myTable : myRegistry.mTables)
+    {
+        std::lock_guard<std::mutex> myTableLock(myTable->mLock);
+        myTable->mSlots.clear();
+    }
+}
+
+const char* cProfile::TypeName(const std::type_info& theType)
+{
+    // Per-thread cache in front of the registry, the probes call this per date
+    thread_local std::unordered_map<std::type_index, const char*> myCache;
+    auto myCached = myCache.find(std::type_index(theType));
+    if (myCached != myCache.end())
+        return myCached->second;
+
+    sProfileRegistry& myRegistry = Registry();
+    std::lock_guard<std::mutex> myLock(myRegistry.mLock);
+    auto myIt = myRegistry.mTypeNames.find(std::type_index(theType));
+    if (myIt != myRegistry.mTypeNames.end())
+        return myCache[std::type_index(theType)] = myIt->second.c_str();
+
+    std::string myName(theType.name());
+#if defined(__GNUC__)
+    int myStatus = 0;
+    char* myDemangled = abi::__cxa_demangle(theType.name(), NULL, NULL, &myStatus);
+    if (myStatus == 0 && myDemangled != NULL)
+        myName = myDemangled;
+    free(myDemangled);
+#endif
+    // "RegArchLib::cGarch" -> "cGarch"
+    size_t myPos = myName.rfind("::");
+    if (myPos != std::string::npos && myName.find('<') == std::string::npos)
+        myName = myName.substr(myPos + 2);
+    return myCache[std::type_index(theType)] = myRegistry.mTypeNames.emplace(std::type_index(theType), myName).first->second.c_str();
+}
+
+cProfileScope::cProfileScope(const char* theKind, const char* theClass, const char* theMethod)
+    : mvKind(theKind), mvClass(theClass), mvMethod(theMethod), mvStart(NowNs())
+{
+}
+
+cProfileScope::~cProfileScope()
+{
+    cProfile::Add(mvKind, mvClass, mvMethod, 1, NowNs() - mvStart);
+}
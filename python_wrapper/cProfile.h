@@ -0,0 +1,73 @@
+#ifndef _CPROFILE_H_
+#define _CPROFILE_H_
+
+#include <map>
+#include <string>
+#include <typeinfo>
+
+/*!
+ * \file cProfile.h
+ * \brief Opt-in call counters and timers for the wrapper hot paths.
+ *
+ * The probes are only compiled with REGARCH_ENABLE_PROFILE defined (CMake
+ * option of the same name). Otherwise the macros expand to nothing: no
+ * code, no clock reads, no lookups.
+ *
+ *   REGARCH_PROFILE_SCOPE(kind, class, method)     counts and times the enclosing scope
+ *   REGARCH_PROFILE_COUNT(kind, class, method, n)  adds n calls without timing
+ *
+ * kind is "mean", "var", "resid", "driver" or "alloc"; class and method are
+ * C strings, REGARCH_PROFILE_TYPE(obj) gives the readable class name of obj.
+ * Each thread records into its own table, get_profile() sums them under
+ * the keys "kind/class/method".
+ */
+
+typedef struct sProfileEntry
+{
+    unsigned long long mCount = 0;
+    unsigned long long mNs = 0;
+} sProfileEntry;
+
+class cProfile
+{
+public:
+    /*! True if the module was built with REGARCH_ENABLE_PROFILE */
+    static bool IsEnabled(void);
+    static void Add(const char* theKind, const char* theClass, const char* theMethod,
+        unsigned long long theCount, unsigned long long theNs);
+    /*! Totals of all threads, keyed by "kind/class/method" */
+    static std::map<std::string, sProfileEntry> Snapshot(void);
+    static void Reset(void);
+    /*! Demangled name of theType, interned (the pointer stays valid) */
+    static const char* TypeName(const std::type_info& theType);
+};
+
+class cProfileScope
+{
+public:
+    cProfileScope(const char* theKind, const char* theClass, const char* theMethod);
+    ~cProfileScope();
+    cProfileScope(const cProfileScope&) = delete;
+    cProfileScope& operator=(const cProfileScope&) = delete;
+private:
+    const char* mvKind;
+    const char* mvClass;
+    const char* mvMethod;
+    unsigned long long mvStart;
+};
+
+#ifdef REGARCH_ENABLE_PROFILE
+#define REGARCH_PROFILE_CAT2(a, b) a##b
+#define REGARCH_PROFILE_CAT(a, b) REGARCH_PROFILE_CAT2(a, b)
+#define REGARCH_PROFILE_SCOPE(theKind, theClass, theMethod) \
+    cProfileScope REGARCH_PROFILE_CAT(myProfileScope, __LINE__)(theKind, theClass, theMethod)
+#define REGARCH_PROFILE_COUNT(theKind, theClass, theMethod, theN) \
+    cProfile::Add(theKind, theClass, theMethod, (unsigned long long)(theN), 0)
+#define REGARCH_PROFILE_TYPE(theObj) cProfile::TypeName(typeid(theObj))
+#else
+#define REGARCH_PROFILE_SCOPE(theKind, theClass, theMethod) ((void)0)
+#define REGARCH_PROFILE_COUNT(theKind, theClass, theMethod, theN) ((void)0)
+#define REGARCH_PROFILE_TYPE(theObj) ""
+#endif
+
+#endif // _CPROFILE_H_
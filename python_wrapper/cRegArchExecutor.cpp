@@ -0,0 +1,175 @@
+#include "cRegArchExecutor.h"
+#include "PythonConversion.h"
+#include <stdexcept>
+
+using namespace boost::python;
+
+typedef struct sExecutorJob
+{
+    cRegArchExecutor::tJob mJob;
+    object mKeepAlive;
+    object mFuture;
+} sExecutorJob;
+
+// await future: asyncio.wrap_future(future).__await__()
+static object Future_Await(object theFuture)
+{
+    return import("asyncio").attr("wrap_future")(theFuture).attr("__await__")();
+}
+
+// Subclass of concurrent.futures.Future with __await__, built once
+static object FutureType(void)
+{
+    static PyObject* myType = NULL;
+    if (myType == NULL)
+    {
+        dict myDict;
+        myDict["__module__"] = "regarch_wrapper";
+        myDict["__doc__"] = "concurrent.futures.Future of a cRegArchExecutor job, also awaitable from asyncio.";
+        myDict["__await__"] = make_function(&Future_Await);
+        object myBase = import("concurrent.futures").attr("Future");
+        object myMeta(handle<>(borrowed(reinterpret_cast<PyObject*>(&PyType_Type))));
+        myType = incref(myMeta("RegArchFuture", make_tuple(myBase), myDict).ptr());
+    }
+    return object(handle<>(borrowed(myType)));
+}
+
+// The Python error being handled, translated as the module does, for set_exception
+static object CurrentException(void)
+{
+    handle_exception();
+    PyObject* myType;
+    PyObject* myValue;
+    PyObject* myTrace;
+    PyErr_Fetch(&myType, &myValue, &myTrace);
+    PyErr_NormalizeException(&myType, &myValue, &myTrace);
+    if (myTrace != NULL)
+        PyException_SetTraceback(myValue, myTrace);
+    Py_XDECREF(myType);
+    Py_XDECREF(myTrace);
+    return object(handle<>(myValue));
+}
+
+// Worker side: start the job unless cancelled, then publish its outcome
+static void RunJob(sExecutorJob* theJob, std::set<sExecutorJob*>& thePending)
+{
+    // Interpreter gone: the job and its references are left as they are
+    if (!Py_IsInitialized())
+        return;
+    PyGILState_STATE myState = PyGILState_Ensure();
+    try
+    {
+        std::unique_ptr<sExecutorJob> myJob(theJob);
+        thePending.erase(theJob);
+        if (extract<bool>(myJob->mFuture.attr("set_running_or_notify_cancel")()))
+        {
+            object myResult;
+            bool myOk = true;
+            try
+            {
+                myResult = myJob->mJob();
+            }
+            catch (...)
+            {
+                myOk = false;
+                myResult = CurrentException();
+            }
+            myJob->mFuture.attr(myOk ? "set_result" : "set_exception")(myResult);
+        }
+    }
+    catch (...)
+    {
+        // Failure to publish (e.g. out of memory): reported, the worker goes on
+        handle_exception();
+        PyErr_WriteUnraisable(NULL);
+    }
+    PyGILState_Release(myState);
+}
+
+cRegArchExecutor::cRegArchExecutor(unsigned int theNThread, size_t theMaxQueue)
+    : mvPool(new cThreadPool(theNThread, theMaxQueue)),
+      mvPending(new std::set<sExecutorJob*>()),
+      mvMaxQueue(theMaxQueue),
+      mvShutdown(false)
+{
+    mvNThread = mvPool->GetNThread();
+}
+
+cRegArchExecutor::~cRegArchExecutor()
+{
+    // The workers need the GIL to finish the queued jobs
+    if (Py_IsInitialized() && PyGILState_Check())
+    {
+        cScopedGILRelease myNoGIL;
+        mvPool.reset();
+    }
+    else
+        mvPool.reset();
+}
+
+object cRegArchExecutor::Submit(const tJob& theJob, const object& theKeepAlive, double theTimeout)
+{
+    if (mvShutdown)
+        throw std::runtime_error("cRegArchExecutor: cannot submit after shutdown");
+    std::unique_ptr<sExecutorJob> myJob(new sExecutorJob());
+    myJob->mJob = theJob;
+    myJob->mKeepAlive = theKeepAlive;
+    myJob->mFuture = FutureType()();
+    object myFuture = myJob->mFuture;
+
+    // The pool and the set outlive a shutdown from another thread while waiting
+    std::shared_ptr<cThreadPool> myPool = mvPool;
+    std::shared_ptr<std::set<sExecutorJob*> > myPending = mvPending;
+    sExecutorJob* myTask = myJob.get();
+    // Registered first: the job may run before the GIL is back
+    myPending->insert(myTask);
+    bool myQueued;
+    {
+        cScopedGILRelease myNoGIL;
+        myQueued = myPool->Submit([myTask, myPending](unsigned int) { RunJob(myTask, *myPending); }, theTimeout);
+    }
+    if (!myQueued)
+    {
+        myPending->erase(myTask);
+        object myFull = import("queue").attr("Full");
+        PyErr_SetString(myFull.ptr(), "cRegArchExecutor: the job queue is full");
+        throw_error_already_set();
+    }
+    myJob.release();
+    return myFuture;
+}
+
+void cRegArchExecutor::Shutdown(bool theWait, bool theCancelPending)
+{
+    mvShutdown = true;
+    // cancel() only succeeds on the futures still pending
+    if (theCancelPending)
+        for (std::set<sExecutorJob*>::iterator myIt = mvPending->begin(); myIt != mvPending->end(); ++myIt)
+            (*myIt)->mFuture.attr("cancel")();
+    if (theWait && mvPool)
+    {
+        std::shared_ptr<cThreadPool> myPool = mvPool;
+        cScopedGILRelease myNoGIL;
+        myPool->WaitIdle();
+    }
+}
+
+unsigned int cRegArchExecutor::GetNThread(void) const
+{
+    return mvNThread;
+}
+
+size_t cRegArchExecutor::GetMaxQueue(void) const
+{
+    return mvMaxQueue;
+}
+
+size_t cRegArchExecutor::GetNQueued(void) const
+{
+    return mvPool->GetNQueued();
+}
+
+bool cRegArchExecutor::IsShutdown(void) const
+{
+    return mvShutdown;
+}
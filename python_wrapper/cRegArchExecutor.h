@@ -0,0 +1,68 @@
+#ifndef _CREGARCHEXECUTOR_H_
+#define _CREGARCHEXECUTOR_H_
+
+#include "StdAfxRegArchLib.h"
+#include <boost/python.hpp>
+#include "cThreadPool.h"
+#include <functional>
+#include <memory>
+#include <set>
+
+/*!
+ * \file cRegArchExecutor.h
+ * \brief Native jobs run on a cThreadPool, with concurrent.futures results.
+ *
+ * Submit() queues a job and returns at once a Future (a subclass of
+ * concurrent.futures.Future that can also be awaited from asyncio). A
+ * worker takes the GIL only to start the job and to publish its result or
+ * its exception; the job body releases it around the native work when the
+ * model has no Python component.
+ *
+ * Futures follow the concurrent.futures protocol: cancel() succeeds while
+ * the job is queued, a running job is not interrupted. The queue is
+ * bounded by theMaxQueue: Submit() then waits for a slot (GIL released) or
+ * raises queue.Full after theTimeout.
+ */
+typedef struct sExecutorJob sExecutorJob;
+
+class cRegArchExecutor
+{
+public:
+    /*! Job body, called by a worker with the GIL held */
+    typedef std::function<boost::python::object(void)> tJob;
+
+    /*!
+     * \param theNThread number of workers, 0 means hardware_concurrency()
+     * \param theMaxQueue most jobs waiting for a worker, 0 means no limit
+     */
+    cRegArchExecutor(unsigned int theNThread = 0, size_t theMaxQueue = 0);
+    /*! Runs the jobs still queued, then stops the workers */
+    virtual ~cRegArchExecutor();
+
+    /*!
+     * Queues theJob and returns its future. theKeepAlive holds the Python
+     * objects theJob uses until it has run.
+     * \param theTimeout seconds to wait for a slot, negative: no limit, 0: do not wait
+     */
+    boost::python::object Submit(const tJob& theJob, const boost::python::object& theKeepAlive, double theTimeout);
+    /*!
+     * No job is accepted afterwards. theCancelPending cancels the futures of
+     * the jobs not started yet, theWait waits for the others.
+     */
+    void Shutdown(bool theWait, bool theCancelPending);
+
+    unsigned int GetNThread(void) const;
+    size_t GetMaxQueue(void) const;
+    size_t GetNQueued(void) const;
+    bool IsShutdown(void) const;
+
+private:
+    std::shared_ptr<cThreadPool> mvPool;
+    /*! Jobs not started yet, only touched with the GIL held */
+    std::shared_ptr<std::set<sExecutorJob*> > mvPending;
+    unsigned int mvNThread;
+    size_t mvMaxQueue;
+    bool mvShutdown;
+};
+
+#endif // _CREGARCHEXECUTOR_H_
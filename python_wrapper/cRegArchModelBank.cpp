@@ -0,0 +1,139 @@
+#include "cRegArchModelBank.h"
+#include "cRegArchSerial.h"
+#include "cThreadPool.h"
+#include "cProfile.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+using namespace RegArchLib;
+
+static const uint32_t gsBankVersion = 1;
+static const size_t gsHeaderSize = 4 + 3 * sizeof(uint32_t);
+
+cRegArchModelBank::cRegArchModelBank()
+{
+}
+
+cRegArchModelBank::cRegArchModelBank(const std::string& thePath)
+    : cRegArchModelBank()
+{
+    Open(thePath);
+}
+
+void cRegArchModelBank::Open(const std::string& thePath)
+{
+    Close();
+    // Unmapped by its destructor if the checks below throw
+    std::shared_ptr<sBankMapping> myMapping(new sBankMapping());
+    myMapping->mFile.Open(thePath);
+    const char* myData = myMapping->mFile.GetData();
+    size_t mySize = myMapping->mFile.GetSize();
+
+    uint32_t myHeader[3];
+    if (mySize < gsHeaderSize || memcmp(myData, "RAMB", 4) != 0)
+        throw std::runtime_error("cRegArchModelBank: " + thePath + " is not a model bank");
+    memcpy(myHeader, myData + 4, sizeof(myHeader));
+    if (myHeader[0] != gsBankVersion)
+        throw std::runtime_error("cRegArchModelBank: unsupported version in " + thePath);
+    uint32_t myNModel = myHeader[1];
+    size_t myTableSize = ((size_t)myNModel + 1) * sizeof(uint64_t);
+    if (mySize < gsHeaderSize + myTableSize)
+        throw std::runtime_error("cRegArchModelBank: truncated offset table in " + thePath);
+    // The header is 16 bytes: the table is aligned in the page-aligned mapping
+    const uint64_t* myOffset = reinterpret_cast<const uint64_t*>(myData + gsHeaderSize);
+    const char* myRecord = myData + gsHeaderSize + myTableSize;
+    size_t myRecordSize = mySize - gsHeaderSize - myTableSize;
+    for (uint32_t i = 0; i < myNModel; i++)
+    {
+        if (myOffset[i] > myOffset[i + 1] || myOffset[i + 1] > myRecordSize)
+            throw std::runtime_error("cRegArchModelBank: corrupted offset table in " + thePath);
+    }
+    myMapping->mNModel = myNModel;
+    myMapping->mOffset = myOffset;
+    myMapping->mRecord = myRecord;
+    std::atomic_store(&mvMapping, std::shared_ptr<const sBankMapping>(myMapping));
+}
+
+void cRegArchModelBank::Close(void)
+{
+    // The file stays mapped while a LoadAll holds it
+    std::atomic_store(&mvMapping, std::shared_ptr<const sBankMapping>());
+}
+
+uint cRegArchModelBank::GetNModel(void) const
+{
+    std::shared_ptr<const sBankMapping> myMapping = std::atomic_load(&mvMapping);
+    return myMapping ? myMapping->mNModel : 0;
+}
+
+void cRegArchModelBank::Decode(const sBankMapping& theMapping, uint theIndex, cRegArchModel& theModel)
+{
+    const uint64_t* myOffset = theMapping.mOffset;
+    DeserializeRegArchModel(theMapping.mRecord + myOffset[theIndex], (size_t)(myOffset[theIndex + 1] - myOffset[theIndex]), theModel);
+}
+
+void cRegArchModelBank::Load(uint theIndex, cRegArchModel& theModel) const
+{
+    std::shared_ptr<const sBankMapping> myMapping = std::atomic_load(&mvMapping);
+    if (!myMapping || theIndex >= myMapping->mNModel)
+        throw std::out_of_range("cRegArchModelBank: model index out of range");
+    Decode(*myMapping, theIndex, theModel);
+}
+
+void cRegArchModelBank::LoadAll(std::vector<cRegArchModel*>& theModels, unsigned int theNThread) const
+{
+    REGARCH_PROFILE_SCOPE("driver", "cRegArchModelBank", "LoadAll");
+    // Held until the end: a concurrent Close() does not unmap the records being decoded
+    std::shared_ptr<const sBankMapping> myMapping = std::atomic_load(&mvMapping);
+    uint myNModel = myMapping ? myMapping->mNModel : 0;
+    std::vector<cRegArchModel*> myModels(myNModel, (cRegArchModel*)NULL);
+    try
+    {
+        cThreadPool myPool(theNThread);
+        myPool.ParallelFor(myNModel, [&](unsigned int i, unsigned int)
+        {
+            cRegArchModel* myModel = new cRegArchModel();
+            myModels[i] = myModel;
+            try
+            {
+                Decode(*myMapping, i, *myModel);
+            }
+            catch (const std::exception& e)
+            {
+                throw std::runtime_error("cRegArchModelBank: model " + std::to_string(i) + ": " + e.what());
+            }
+        });
+    }
+    catch (...)
+    {
+        for (size_t i = 0; i < myModels.size(); i++)
+            delete myModels[i];
+        throw;
+    }
+    theModels.insert(theModels.end(), myModels.begin(), myModels.end());
+}
+
+void cRegArchModelBank::Write(const std::string& thePath, const std::vector<const cRegArchModel*>& theModels)
+{
+    std::string myRecords;
+    std::vector<uint64_t> myOffset(1, 0);
+    myOffset.reserve(theModels.size() + 1);
+    for (size_t i = 0; i < theModels.size(); i++)
+    {
+        SerializeRegArchModel(*theModels[i], myRecords);
+        myOffset.push_back(myRecords.size());
+    }
+
+    std::ofstream myOut(thePath.c_str(), std::ios::binary | std::ios::trunc);
+    if (!myOut)
+        throw std::runtime_error("cRegArchModelBank: cannot create " + thePath);
+    uint32_t myHeader[3] = { gsBankVersion, (uint32_t)theModels.size(), 0 };
+    myOut.write("RAMB", 4);
+    myOut.write(reinterpret_cast<const char*>(myHeader), sizeof(myHeader));
+    myOut.write(reinterpret_cast<const char*>(myOffset.data()), myOffset.size() * sizeof(uint64_t));
+    myOut.write(myRecords.data(), myRecords.size());
+    if (!myOut)
+        throw std::runtime_error("cRegArchModelBank: cannot write " + thePath);
+}
@@ -0,0 +1,64 @@
+#ifndef _CREGARCHMODELBANK_H_
+#define _CREGARCHMODELBANK_H_
+
+#include "StdAfxRegArchLib.h"
+#include "cMappedFile.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*!
+ * \file cRegArchModelBank.h
+ * \brief File of many fitted models, read through a memory mapping.
+ *
+ * Layout (native-endian):
+ *
+ *   "RAMB", uint32 version, uint32 nModel, uint32 0,
+ *   uint64 offset[nModel + 1]    start of each record from the first one,
+ *   records                      cRegArchSerial model records
+ *
+ * The offsets give random access to any model. LoadAll decodes the records
+ * on a cThreadPool, straight from the mapping. Every call takes its own
+ * reference to the mapping: Close() or Open() while a LoadAll runs on
+ * another thread unmaps the file only once that LoadAll is done.
+ */
+class cRegArchModelBank
+{
+public:
+    cRegArchModelBank();
+    /*! Maps thePath and checks the header, throws std::runtime_error */
+    explicit cRegArchModelBank(const std::string& thePath);
+
+    void Open(const std::string& thePath);
+    void Close(void);
+    uint GetNModel(void) const;
+    /*! Replaces theModel by model theIndex */
+    void Load(uint theIndex, RegArchLib::cRegArchModel& theModel) const;
+    /*!
+     * New models for all the records, to be deleted by the caller.
+     * \param theNThread number of threads decoding, 0 means hardware_concurrency()
+     */
+    void LoadAll(std::vector<RegArchLib::cRegArchModel*>& theModels, unsigned int theNThread = 0) const;
+
+    /*! Writes theModels to thePath */
+    static void Write(const std::string& thePath, const std::vector<const RegArchLib::cRegArchModel*>& theModels);
+
+private:
+    /*! The mapping and the offset table and records in it */
+    typedef struct sBankMapping
+    {
+        cMappedFile mFile;
+        uint mNModel;
+        const uint64_t* mOffset;
+        const char* mRecord;
+    } sBankMapping;
+
+    /*! Decodes record theIndex < theMapping.mNModel */
+    static void Decode(const sBankMapping& theMapping, uint theIndex, RegArchLib::cRegArchModel& theModel);
+
+    /*! Null when closed, read and replaced with std::atomic_load / std::atomic_store */
+    std::shared_ptr<const sBankMapping> mvMapping;
+};
+
+#endif // _CREGARCHMODELBANK_H_
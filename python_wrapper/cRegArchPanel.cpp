@@ -0,0 +1,185 @@
+#include "cRegArchPanel.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+using namespace RegArchLib;
+
+static const uint32_t gsPanelVersion = 1;
+static const size_t gsHeaderSize = 4 + 3 * sizeof(uint32_t);
+static const size_t gsAlign = 64;
+
+static uint64_t Padded(uint64_t theOffset)
+{
+    return (theOffset + gsAlign - 1) / gsAlign * gsAlign;
+}
+
+cRegArchPanel::cRegArchPanel()
+    : mvNColumn(0), mvColumn(NULL)
+{
+}
+
+cRegArchPanel::cRegArchPanel(const std::string& thePath)
+    : cRegArchPanel()
+{
+    Open(thePath);
+}
+
+void cRegArchPanel::Open(const std::string& thePath)
+{
+    Close();
+    // Copy-on-write: the values may write into Yt without touching the file
+    mvFile.Open(thePath, true);
+    const char* myData = mvFile.GetData();
+    uint64_t mySize = mvFile.GetSize();
+
+    uint32_t myHeader[3];
+    if (mySize < gsHeaderSize || memcmp(myData, "RAPN", 4) != 0)
+    {
+        Close();
+        throw std::runtime_error("cRegArchPanel: " + thePath + " is not a panel");
+    }
+    memcpy(myHeader, myData + 4, sizeof(myHeader));
+    if (myHeader[0] != gsPanelVersion)
+    {
+        Close();
+        throw std::runtime_error("cRegArchPanel: unsupported version in " + thePath);
+    }
+    uint32_t myNColumn = myHeader[1];
+    if (mySize < gsHeaderSize + (uint64_t)myNColumn * sizeof(sPanelColumn))
+    {
+        Close();
+        throw std::runtime_error("cRegArchPanel: truncated column table in " + thePath);
+    }
+
+    // Every block must lie in the file and be aligned
+    const sPanelColumn* myColumn = reinterpret_cast<const sPanelColumn*>(myData + gsHeaderSize);
+    for (uint32_t i = 0; i < myNColumn; i++)
+    {
+        const sPanelColumn& myCol = myColumn[i];
+        uint64_t myBlock[3] = { myCol.mYt, myCol.mXt, myCol.mXvt };
+        uint64_t myLen[3] = { myCol.mNDate, (uint64_t)myCol.mNDate * myCol.mNXtCol, (uint64_t)myCol.mNDate * myCol.mNXvtCol };
+        bool myOk = myCol.mName <= mySize && myCol.mNameSize <= mySize - myCol.mName;
+        for (int k = 0; k < 3 && myOk; k++)
+            myOk = myLen[k] == 0
+                || (myBlock[k] % sizeof(double) == 0 && myBlock[k] <= mySize && myLen[k] <= (mySize - myBlock[k]) / sizeof(double));
+        if (!myOk)
+        {
+            Close();
+            throw std::runtime_error("cRegArchPanel: corrupted column " + std::to_string(i) + " in " + thePath);
+        }
+    }
+    mvNColumn = myNColumn;
+    mvColumn = myColumn;
+}
+
+void cRegArchPanel::Close(void)
+{
+    mvFile.Close();
+    mvNColumn = 0;
+    mvColumn = NULL;
+}
+
+uint cRegArchPanel::GetNColumn(void) const
+{
+    return mvNColumn;
+}
+
+const sPanelColumn& cRegArchPanel::Column(uint theIndex) const
+{
+    if (theIndex >= mvNColumn)
+        throw std::out_of_range("cRegArchPanel: column index out of range");
+    return mvColumn[theIndex];
+}
+
+double* cRegArchPanel::Data(uint64_t theOffset) const
+{
+    return reinterpret_cast<double*>(mvFile.GetWritableData() + theOffset);
+}
+
+std::string cRegArchPanel::GetName(uint theIndex) const
+{
+    const sPanelColumn& myCol = Column(theIndex);
+    return std::string(mvFile.GetData() + myCol.mName, myCol.mNameSize);
+}
+
+uint cRegArchPanel::GetNDate(uint theIndex) const
+{
+    return Column(theIndex).mNDate;
+}
+
+int cRegArchPanel::Find(const std::string& theName) const
+{
+    for (uint i = 0; i < mvNColumn; i++)
+        if (mvColumn[i].mNameSize == theName.size() && memcmp(mvFile.GetData() + mvColumn[i].mName, theName.data(), theName.size()) == 0)
+            return (int)i;
+    return -1;
+}
+
+double* cRegArchPanel::GetYt(uint theIndex) const
+{
+    return Data(Column(theIndex).mYt);
+}
+
+void cRegArchPanel::GetValue(uint theIndex, cPackedRegArchValue& theValue) const
+{
+    const sPanelColumn& myCol = Column(theIndex);
+    theValue.AttachData(Data(myCol.mYt), myCol.mNDate,
+        (myCol.mNXtCol > 0) ? Data(myCol.mXt) : NULL, myCol.mNXtCol,
+        (myCol.mNXvtCol > 0) ? Data(myCol.mXvt) : NULL, myCol.mNXvtCol);
+}
+
+void cRegArchPanel::Write(const std::string& thePath, const std::vector<sPanelColumnData>& theColumns)
+{
+    // Layout first: the table holds the offsets of the blocks
+    std::vector<sPanelColumn> myTable(theColumns.size());
+    uint64_t myOffset = gsHeaderSize + theColumns.size() * sizeof(sPanelColumn);
+    for (size_t i = 0; i < theColumns.size(); i++)
+    {
+        const sPanelColumnData& mySrc = theColumns[i];
+        sPanelColumn& myCol = myTable[i];
+        myCol.mNDate = mySrc.mNDate;
+        myCol.mNXtCol = (mySrc.mXt != NULL) ? mySrc.mNXtCol : 0;
+        myCol.mNXvtCol = (mySrc.mXvt != NULL) ? mySrc.mNXvtCol : 0;
+        myCol.mNameSize = (uint32_t)mySrc.mName.size();
+        myCol.mName = myOffset;
+        myOffset += myCol.mNameSize;
+        myCol.mYt = myOffset = Padded(myOffset);
+        myOffset += (uint64_t)myCol.mNDate * sizeof(double);
+        myCol.mXt = myOffset = Padded(myOffset);
+        myOffset += (uint64_t)myCol.mNDate * myCol.mNXtCol * sizeof(double);
+        myCol.mXvt = myOffset = Padded(myOffset);
+        myOffset += (uint64_t)myCol.mNDate * myCol.mNXvtCol * sizeof(double);
+    }
+
+    std::ofstream myOut(thePath.c_str(), std::ios::binary | std::ios::trunc);
+    if (!myOut)
+        throw std::runtime_error("cRegArchPanel: cannot create " + thePath);
+    uint32_t myHeader[3] = { gsPanelVersion, (uint32_t)theColumns.size(), 0 };
+    myOut.write("RAPN", 4);
+    myOut.write(reinterpret_cast<const char*>(myHeader), sizeof(myHeader));
+    if (!myTable.empty())
+        myOut.write(reinterpret_cast<const char*>(myTable.data()), myTable.size() * sizeof(sPanelColumn));
+
+    static const char myZero[gsAlign] = { 0 };
+    uint64_t myPos = gsHeaderSize + theColumns.size() * sizeof(sPanelColumn);
+    // Pads up to theTo, then writes theSize bytes
+    auto myPut = [&](uint64_t theTo, const void* theData, uint64_t theSize)
+    {
+        myOut.write(myZero, (std::streamsize)(theTo - myPos));
+        if (theSize > 0)
+            myOut.write(static_cast<const char*>(theData), (std::streamsize)theSize);
+        myPos = theTo + theSize;
+    };
+    for (size_t i = 0; i < theColumns.size(); i++)
+    {
+        const sPanelColumnData& mySrc = theColumns[i];
+        const sPanelColumn& myCol = myTable[i];
+        myPut(myCol.mName, mySrc.mName.data(), myCol.mNameSize);
+        myPut(myCol.mYt, mySrc.mYt, (uint64_t)myCol.mNDate * sizeof(double));
+        myPut(myCol.mXt, mySrc.mXt, (uint64_t)myCol.mNDate * myCol.mNXtCol * sizeof(double));
+        myPut(myCol.mXvt, mySrc.mXvt, (uint64_t)myCol.mNDate * myCol.mNXvtCol * sizeof(double));
+    }
+    if (!myOut)
+        throw std::runtime_error("cRegArchPanel: cannot write " + thePath);
+}
@@ -0,0 +1,85 @@
+#ifndef _CREGARCHPANEL_H_
+#define _CREGARCHPANEL_H_
+
+#include "StdAfxRegArchLib.h"
+#include "cMappedFile.h"
+#include "cPackedRegArchValue.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*!
+ * \file cRegArchPanel.h
+ * \brief Columnar file of many series (a panel), read through a memory mapping.
+ *
+ * Layout (native-endian):
+ *
+ *   "RAPN", uint32 version, uint32 nColumn, uint32 0
+ *   sPanelColumn[nColumn]        where each column is in the file
+ *   data                         float64 blocks, each on a 64-byte boundary
+ *
+ * A column holds Yt (nDate values) and, optionally, Xt and Xvt (nDate x
+ * nCol, row-major) and a name. Opening a panel only reads the header and
+ * the column table, whatever the size of the file. GetValue() points Yt,
+ * Xt and Xvt of a cPackedRegArchValue straight into the mapping; the
+ * mapping is copy-on-write, so a value written to never changes the file.
+ */
+typedef struct sPanelColumn
+{
+    uint64_t mYt;
+    uint64_t mXt;
+    uint64_t mXvt;
+    uint64_t mName;
+    uint32_t mNDate;
+    uint32_t mNXtCol;
+    uint32_t mNXvtCol;
+    uint32_t mNameSize;
+} sPanelColumn;
+
+/*! One column to write, the pointers are not owned */
+typedef struct sPanelColumnData
+{
+    std::string mName;
+    const double* mYt;
+    uint mNDate;
+    const double* mXt;
+    uint mNXtCol;
+    const double* mXvt;
+    uint mNXvtCol;
+} sPanelColumnData;
+
+class cRegArchPanel
+{
+public:
+    cRegArchPanel();
+    /*! Maps thePath and checks the column table, throws std::runtime_error */
+    explicit cRegArchPanel(const std::string& thePath);
+
+    void Open(const std::string& thePath);
+    void Close(void);
+    uint GetNColumn(void) const;
+    std::string GetName(uint theIndex) const;
+    uint GetNDate(uint theIndex) const;
+    /*! Index of the column named theName, -1 if there is none */
+    int Find(const std::string& theName) const;
+    /*! Yt of column theIndex, in the mapping */
+    double* GetYt(uint theIndex) const;
+    /*!
+     * Points theValue at column theIndex (AttachData), without copy. theValue
+     * must not be used once the panel is closed, unless it is packed first.
+     */
+    void GetValue(uint theIndex, cPackedRegArchValue& theValue) const;
+
+    /*! Writes theColumns to thePath */
+    static void Write(const std::string& thePath, const std::vector<sPanelColumnData>& theColumns);
+
+private:
+    const sPanelColumn& Column(uint theIndex) const;
+    double* Data(uint64_t theOffset) const;
+
+    cMappedFile mvFile;
+    uint mvNColumn;
+    const sPanelColumn* mvColumn;
+};
+
+#endif // _CREGARCHPANEL_H_
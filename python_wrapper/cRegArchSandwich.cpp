@@ -0,0 +1,317 @@
+#include "cRegArchSandwich.h"
+#include "PythonConversion.h"
+#include <gsl/gsl_cblas.h>
+#include <cmath>
+
+using namespace RegArchLib;
+
+cRegArchSandwich::cRegArchSandwich(eHacKernelEnum theKernel, int theNLag)
+    : mvKernel(theKernel), mvNLag(theNLag), mvHacNLag(0), mvHacBandwidth(0.0), mvNObs(0), mvLLH(0.0)
+{
+}
+
+cRegArchSandwich::~cRegArchSandwich()
+{
+}
+
+void cRegArchSandwich::Delete(void)
+{
+    mvNObs = 0;
+    mvLLH = 0.0;
+    mvParam.Delete();
+    mvI.Delete();
+    mvJ.Delete();
+    mvCov.Delete();
+    mvStdErr.Delete();
+    mvTStat.Delete();
+    mvPValue.Delete();
+    mvStatTable.Delete();
+    mvHacCov.Delete();
+    mvHacNLag = 0;
+    mvHacBandwidth = 0.0;
+    mvScoreHist.Delete();
+    std::vector<double>().swap(mvGamma);
+}
+
+void cRegArchSandwich::SetHac(eHacKernelEnum theKernel, int theNLag)
+{
+    mvKernel = theKernel;
+    mvNLag = theNLag;
+}
+
+eHacKernelEnum cRegArchSandwich::GetHacKernel(void) const
+{
+    return mvKernel;
+}
+
+double cRegArchSandwich::KernelWeight(eHacKernelEnum theKernel, double theX)
+{
+    double myX = fabs(theX);
+    if (myX >= 1.0)
+        return 0.0;
+    switch (theKernel)
+    {
+    case eHacBartlett:
+        return 1.0 - myX;
+    case eHacParzen:
+        if (myX <= 0.5)
+            return 1.0 - 6.0 * myX * myX + 6.0 * myX * myX * myX;
+        return 2.0 * (1.0 - myX) * (1.0 - myX) * (1.0 - myX);
+    default:
+        return 0.0;
+    }
+}
+
+void cRegArchSandwich::Compute(cRegArchModel& theModel, cRegArchValue& theValue)
+{
+    uint myNParam = theModel.GetNParam();
+
+    mvNObs = theValue.mYt.GetSize();
+    mvLLH = 0.0;
+    mvParam.ReAlloc(myNParam);
+    theModel.RegArchParamToVector(mvParam);
+    mvI.ReAlloc(myNParam, myNParam);
+    mvJ.ReAlloc(myNParam, myNParam);
+
+    // Pure C++ models: the passes do not need the interpreter
+    if (!HasPythonComponent(theModel) && Py_IsInitialized() && PyGILState_Check())
+    {
+        cScopedGILRelease myNoGIL;
+        SetupHac(theModel, theValue);
+        Accumulate(theModel, theValue);
+    }
+    else
+    {
+        SetupHac(theModel, theValue);
+        Accumulate(theModel, theValue);
+    }
+
+    for (uint i = 0; i < myNParam; i++)
+        for (uint j = 0; j < i; j++)
+            mvI[i][j] = mvI[j][i];
+    mvI /= (double)mvNObs;
+    mvJ /= (double)mvNObs;
+    Finalize();
+}
+
+void cRegArchSandwich::SetupHac(cRegArchModel& theModel, cRegArchValue& theValue)
+{
+    uint myNParam = mvParam.GetSize();
+
+    mvHacNLag = 0;
+    mvHacBandwidth = 0.0;
+    if (mvKernel != eHacNone)
+    {
+        if (mvNLag >= 0)
+            mvHacBandwidth = mvNLag + 1.0;
+        else
+            ComputeBandwidth(theModel, theValue);
+        mvHacNLag = (uint)ceil(mvHacBandwidth) - 1;
+        if (mvHacNLag >= mvNObs)
+            mvHacNLag = (mvNObs > 0) ? mvNObs - 1 : 0;
+    }
+    mvScoreHist.ReAlloc(mvHacNLag, myNParam);
+    mvGamma.assign((size_t)mvHacNLag * myNParam * myNParam, 0.0);
+}
+
+/*!
+ * Newey-West (1994) plug-in bandwidth from the scalar series s(t) = sum_i g_i(t):
+ * sigma(j) = 1/n sum_t s(t) s(t-j) for j <= m, s0 = sigma(0) + 2 sum_j sigma(j),
+ * sq = 2 sum_j j^q sigma(j), and b = c (sq / s0)^(2/(2q+1)) n^(1/(2q+1)),
+ * with (q, c, m) = (1, 1.1447, 4 (n/100)^(2/9)) for Bartlett and
+ * (2, 2.6614, 4 (n/100)^(4/25)) for Parzen. Only the last m s(t) are kept.
+ */
+void cRegArchSandwich::ComputeBandwidth(cRegArchModel& theModel, cRegArchValue& theValue)
+{
+    REGARCH_PROFILE_SCOPE("driver", "cRegArchSandwich", "ComputeBandwidth");
+    uint myNParam = mvParam.GetSize();
+    uint myNMeanParam = (theModel.mMean != NULL) ? theModel.mMean->GetNParam() : 0;
+    uint myNDistrParam = theModel.mResids->GetNParam();
+    double myQ = (mvKernel == eHacParzen) ? 2.0 : 1.0;
+    double myC = (mvKernel == eHacParzen) ? 2.6614 : 1.1447;
+    double myExpM = (mvKernel == eHacParzen) ? 4.0 / 25.0 : 2.0 / 9.0;
+    uint myM = (uint)floor(4.0 * pow(mvNObs / 100.0, myExpM));
+
+    cRegArchGradient myGradData(theModel.GetNLags(), myNMeanParam, myNParam - myNMeanParam - myNDistrParam, myNDistrParam);
+    cDVector myGradlt(myNParam);
+    cRingHistory<double> myHist(myM, 1);
+    std::vector<double> mySigma(myM + 1, 0.0);
+
+    for (uint t = 0; t < mvNObs; t++)
+    {
+        RegArchGradLt((int)t, theModel, theValue, myGradData, myGradlt);
+        double mySt = 0.0;
+        for (uint i = 0; i < myNParam; i++)
+            mySt += myGradlt[i];
+        mySigma[0] += mySt * mySt;
+        // myHist.Lag(j - 1) holds s(t - j)
+        for (uint j = 1; j <= myHist.GetSize(); j++)
+            mySigma[j] += mySt * *myHist.Lag(j - 1);
+        if (myM > 0)
+            *myHist.Push() = mySt;
+    }
+
+    double myS0 = mySigma[0], mySq = 0.0;
+    for (uint j = 1; j <= myM; j++)
+    {
+        myS0 += 2.0 * mySigma[j];
+        mySq += 2.0 * pow((double)j, myQ) * mySigma[j];
+    }
+    double myGamma = (myS0 != 0.0) ? myC * pow(mySq * mySq / (myS0 * myS0), 1.0 / (2.0 * myQ + 1.0)) : 0.0;
+    mvHacBandwidth = myGamma * pow((double)mvNObs, 1.0 / (2.0 * myQ + 1.0));
+    if (mvHacBandwidth < 1.0)
+        mvHacBandwidth = 1.0;
+}
+
+void cRegArchSandwich::Accumulate(cRegArchModel& theModel, cRegArchValue& theValue)
+{
+    REGARCH_PROFILE_SCOPE("driver", "cRegArchSandwich", "Accumulate");
+    uint myNParam = mvParam.GetSize();
+    uint myNMeanParam = (theModel.mMean != NULL) ? theModel.mMean->GetNParam() : 0;
+    uint myNDistrParam = theModel.mResids->GetNParam();
+    uint myNVarParam = myNParam - myNMeanParam - myNDistrParam;
+
+    cRegArchGradient myGradData(theModel.GetNLags(), myNMeanParam, myNVarParam, myNDistrParam);
+    cRegArchHessien myHessData(theModel.GetNLags(), myNMeanParam, myNVarParam, myNDistrParam);
+    cDVector myGradlt(myNParam);
+    cDMatrix myHesslt(myNParam, myNParam);
+
+    gsl_matrix* myI = mvI.GetGSLMatrix();
+    gsl_matrix* myJ = mvJ.GetGSLMatrix();
+    const gsl_vector* myG = myGradlt.GetGSLVector();
+    const gsl_matrix* myH = myHesslt.GetGSLMatrix();
+
+    for (uint t = 0; t < mvNObs; t++)
+    {
+        double mylt;
+        RegArchLtGradAndHessLt((int)t, theModel, theValue, mylt, myGradData, myHessData, myGradlt, myHesslt);
+        mvLLH += mylt;
+        // I += g g' (upper triangle only), J += H
+        cblas_dsyr(CblasRowMajor, CblasUpper, (int)myNParam, 1.0, myG->data, (int)myG->stride,
+            myI->data, (int)myI->tda);
+        for (uint i = 0; i < myNParam; i++)
+        {
+            double* myJRow = myJ->data + i * myJ->tda;
+            const double* myHRow = myH->data + i * myH->tda;
+            for (uint j = 0; j < myNParam; j++)
+                myJRow[j] += myHRow[j];
+        }
+
+        if (mvHacNLag == 0)
+            continue;
+        // Gamma(j) += g(t) g(t-j)', the score of date t-j is at lag j-1 before the push
+        for (uint j = 1; j <= mvScoreHist.GetSize(); j++)
+            cblas_dger(CblasRowMajor, (int)myNParam, (int)myNParam, 1.0, myG->data, (int)myG->stride,
+                mvScoreHist.Lag(j - 1), 1,
+                &mvGamma[(size_t)(j - 1) * myNParam * myNParam], (int)myNParam);
+        double* mySlot = mvScoreHist.Push();
+        for (uint i = 0; i < myNParam; i++)
+            mySlot[i] = myGradlt[i];
+    }
+}
+
+void cRegArchSandwich::Finalize(void)
+{
+    REGARCH_PROFILE_SCOPE("driver", "cRegArchSandwich", "Finalize");
+    uint myNParam = mvParam.GetSize();
+    cDMatrix myInvJ = Inv(mvJ);
+    mvCov = myInvJ * mvI * myInvJ / (double)mvNObs;
+
+    const cDMatrix* myCov = &mvCov;
+    if (mvKernel != eHacNone)
+    {
+        cDMatrix myOmega(mvI);
+        for (uint j = 1; j <= mvHacNLag; j++)
+        {
+            double myW = KernelWeight(mvKernel, j / mvHacBandwidth) / (double)mvNObs;
+            const double* myGamma = &mvGamma[(size_t)(j - 1) * myNParam * myNParam];
+            for (uint a = 0; a < myNParam; a++)
+                for (uint b = 0; b < myNParam; b++)
+                    myOmega[a][b] += myW * (myGamma[a * myNParam + b] + myGamma[b * myNParam + a]);
+        }
+        mvHacCov = myInvJ * myOmega * myInvJ / (double)mvNObs;
+        myCov = &mvHacCov;
+    }
+    else
+        mvHacCov.Delete();
+
+    mvStdErr.ReAlloc(myNParam);
+    mvTStat.ReAlloc(myNParam);
+    mvPValue.ReAlloc(myNParam);
+    mvStatTable.ReAlloc(myNParam, 4);
+    for (uint i = 0; i < myNParam; i++)
+    {
+        mvStdErr[i] = sqrt((*myCov)[i][i]);
+        mvTStat[i] = mvParam[i] / mvStdErr[i];
+        mvPValue[i] = erfc(fabs(mvTStat[i]) / sqrt(2.0));
+        mvStatTable[i][0] = mvParam[i];
+        mvStatTable[i][1] = mvStdErr[i];
+        mvStatTable[i][2] = mvTStat[i];
+        mvStatTable[i][3] = mvPValue[i];
+    }
+}
+
+uint cRegArchSandwich::GetNObs(void) const
+{
+    return mvNObs;
+}
+
+double cRegArchSandwich::GetLLH(void) const
+{
+    return mvLLH;
+}
+
+const cDVector& cRegArchSandwich::GetParam(void) const
+{
+    return mvParam;
+}
+
+const cDMatrix& cRegArchSandwich::GetI(void) const
+{
+    return mvI;
+}
+
+const cDMatrix& cRegArchSandwich::GetJ(void) const
+{
+    return mvJ;
+}
+
+const cDMatrix& cRegArchSandwich::GetCov(void) const
+{
+    return mvCov;
+}
+
+const cDVector& cRegArchSandwich::GetStdErr(void) const
+{
+    return mvStdErr;
+}
+
+const cDVector& cRegArchSandwich::GetTStat(void) const
+{
+    return mvTStat;
+}
+
+const cDVector& cRegArchSandwich::GetPValue(void) const
+{
+    return mvPValue;
+}
+
+const cDMatrix& cRegArchSandwich::GetStatTable(void) const
+{
+    return mvStatTable;
+}
+
+const cDMatrix& cRegArchSandwich::GetHacCov(void) const
+{
+    return mvHacCov;
+}
+
+uint cRegArchSandwich::GetHacNLag(void) const
+{
+    return mvHacNLag;
+}
+
+double cRegArchSandwich::GetHacBandwidth(void) const
+{
+    return mvHacBandwidth;
+}
@@ -0,0 +1,106 @@
+#ifndef _CREGARCHSANDWICH_H_
+#define _CREGARCHSANDWICH_H_
+
+#include "StdAfxRegArchLib.h"
+#include "cRingHistory.h"
+#include <vector>
+
+/*!
+ * \file cRegArchSandwich.h
+ * \brief Robust (sandwich) covariance of the estimates and the statistics
+ *        table, from a single pass over the data.
+ *
+ * One call to RegArchLtGradAndHessLt per date gives l(t), its gradient and
+ * its Hessian: the log-likelihood, I and J are accumulated together, I
+ * with a rank-1 BLAS update. Everything RegArchComputeIAndJ,
+ * RegArchComputeCov and RegArchStatTable compute separately is then
+ * available from the same object:
+ *
+ *   I = 1/n sum_t grad l(t) grad l(t)'
+ *   J = 1/n sum_t hess l(t)
+ *   Cov = J^-1 I J^-1 / n
+ *
+ * The statistics table has one row per parameter and the columns
+ * (estimate, standard error, t-stat, two-sided p-value).
+ *
+ * With a HAC kernel, the same pass also accumulates the score
+ * autocovariances Gamma(j) = 1/n sum_t g(t) g(t-j)' for j <= L, keeping only
+ * the last L scores, and
+ *
+ *   Omega = I + sum_j w(j/b) (Gamma(j) + Gamma(j)')
+ *   HacCov = J^-1 Omega J^-1 / n
+ *
+ * with b = L + 1. When L is not given, b is the Newey-West (1994) plug-in
+ * bandwidth, estimated by a first pass over the scores. The standard errors
+ * and the table then come from HacCov.
+ */
+typedef enum eHacKernelEnum
+{
+    eHacNone,
+    eHacBartlett,
+    eHacParzen
+} eHacKernelEnum;
+
+class cRegArchSandwich
+{
+public:
+    /*!
+     * \param theKernel HAC kernel, eHacNone for i.i.d. scores
+     * \param theNLag number of autocovariance lags, negative for the automatic bandwidth
+     */
+    cRegArchSandwich(eHacKernelEnum theKernel = eHacNone, int theNLag = -1);
+    virtual ~cRegArchSandwich();
+
+    void SetHac(eHacKernelEnum theKernel, int theNLag = -1);
+    eHacKernelEnum GetHacKernel(void) const;
+
+    /*! Runs the pass on theValue, with the parameters of theModel */
+    void Compute(RegArchLib::cRegArchModel& theModel, RegArchLib::cRegArchValue& theValue);
+
+    uint GetNObs(void) const;
+    double GetLLH(void) const;
+    const RegArchLib::cDVector& GetParam(void) const;
+    const RegArchLib::cDMatrix& GetI(void) const;
+    const RegArchLib::cDMatrix& GetJ(void) const;
+    const RegArchLib::cDMatrix& GetCov(void) const;
+    const RegArchLib::cDVector& GetStdErr(void) const;
+    const RegArchLib::cDVector& GetTStat(void) const;
+    const RegArchLib::cDVector& GetPValue(void) const;
+    const RegArchLib::cDMatrix& GetStatTable(void) const;
+    /*! HAC covariance of the last call (empty without kernel) */
+    const RegArchLib::cDMatrix& GetHacCov(void) const;
+    /*! Number of lags and bandwidth used by the last call */
+    uint GetHacNLag(void) const;
+    double GetHacBandwidth(void) const;
+
+    static double KernelWeight(eHacKernelEnum theKernel, double theX);
+
+    void Delete(void);
+
+private:
+    void Accumulate(RegArchLib::cRegArchModel& theModel, RegArchLib::cRegArchValue& theValue);
+    void SetupHac(RegArchLib::cRegArchModel& theModel, RegArchLib::cRegArchValue& theValue);
+    void ComputeBandwidth(RegArchLib::cRegArchModel& theModel, RegArchLib::cRegArchValue& theValue);
+    void Finalize(void);
+
+    eHacKernelEnum mvKernel;
+    int mvNLag;
+    uint mvHacNLag;
+    double mvHacBandwidth;
+    cRingHistory<double> mvScoreHist;
+    std::vector<double> mvGamma;
+
+    uint mvNObs;
+    double mvLLH;
+    RegArchLib::cDVector mvParam;
+    RegArchLib::cDMatrix mvI;
+    RegArchLib::cDMatrix mvJ;
+    RegArchLib::cDMatrix mvCov;
+    RegArchLib::cDVector mvStdErr;
+    RegArchLib::cDVector mvTStat;
+    RegArchLib::cDVector mvPValue;
+    RegArchLib::cDMatrix mvStatTable;
+    RegArchLib::cDMatrix mvHacCov;
+};
+
+#endif // _CREGARCHSANDWICH_H_
@@ -0,0 +1,520 @@
+#include "cRegArchSerial.h"
+#include "cAutoDiffGarch.h"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+using namespace RegArchLib;
+
+static const uint32_t gsVersion = 1;
+// No component has that many families, the probe stops before
+static const uint32_t gsMaxFamily = 16;
+// Set on the type of a variance record for the cAutoDiffCondVar twin of the class
+static const uint32_t gsAutoDiffFlag = 0x80000000u;
+
+//------------------------------------------------------------------------------
+// Raw writing and reading
+//------------------------------------------------------------------------------
+static void PutU32(uint32_t theVal, std::string& theDest)
+{
+    theDest.append(reinterpret_cast<const char*>(&theVal), sizeof(theVal));
+}
+
+static void PutF64(const double* theVal, size_t theN, std::string& theDest)
+{
+    if (theN > 0)
+        theDest.append(reinterpret_cast<const char*>(theVal), theN * sizeof(double));
+}
+
+static void PutTag(const char* theTag, std::string& theDest)
+{
+    theDest.append(theTag, 4);
+    PutU32(gsVersion, theDest);
+}
+
+/*! The values only */
+static void PutValues(const cDVector& theVect, std::string& theDest)
+{
+    gsl_vector* myV = theVect.GetGSLVector();
+    size_t mySize = (size_t)theVect.GetSize();
+    if (mySize == 0)
+        return;
+    if (myV->stride == 1)
+        PutF64(myV->data, mySize, theDest);
+    else
+        for (size_t i = 0; i < mySize; i++)
+            PutF64(myV->data + i * myV->stride, 1, theDest);
+}
+
+static void PutVector(const cDVector& theVect, std::string& theDest)
+{
+    PutU32((uint32_t)theVect.GetSize(), theDest);
+    PutValues(theVect, theDest);
+}
+
+static void PutMatrix(const cDMatrix& theMat, std::string& theDest)
+{
+    uint32_t myNRow = theMat.GetNRow();
+    uint32_t myNCol = theMat.GetNCol();
+    PutU32(myNRow, theDest);
+    PutU32(myNCol, theDest);
+    gsl_matrix* myM = theMat.GetGSLMatrix();
+    for (uint32_t r = 0; r < myNRow && myNCol > 0; r++)
+        PutF64(myM->data + r * myM->tda, myNCol, theDest);
+}
+
+class cByteReader
+{
+public:
+    cByteReader(const char* theData, size_t theSize)
+        : mvPos(theData), mvEnd(theData + theSize)
+    {
+    }
+
+    void Need(size_t theBytes) const
+    {
+        if ((size_t)(mvEnd - mvPos) < theBytes)
+            throw std::runtime_error("RegArch serial: truncated record");
+    }
+
+    uint32_t U32(void)
+    {
+        uint32_t myRes;
+        Need(sizeof(myRes));
+        memcpy(&myRes, mvPos, sizeof(myRes));
+        mvPos += sizeof(myRes);
+        return myRes;
+    }
+
+    void F64(double* theDest, size_t theN)
+    {
+        Need(theN * sizeof(double));
+        if (theN > 0)
+            memcpy(theDest, mvPos, theN * sizeof(double));
+        mvPos += theN * sizeof(double);
+    }
+
+    void Tag(const char* theTag)
+    {
+        Need(4);
+        if (memcmp(mvPos, theTag, 4) != 0)
+            throw std::runtime_error(std::string("RegArch serial: expected a '") + std::string(theTag, 4) + "' record");
+        mvPos += 4;
+        if (U32() != gsVersion)
+            throw std::runtime_error("RegArch serial: unsupported version");
+    }
+
+    /*! theVect->size values */
+    void Values(gsl_vector* theVect)
+    {
+        Need(theVect->size * sizeof(double));
+        if (theVect->stride == 1)
+            F64(theVect->data, theVect->size);
+        else
+            for (size_t i = 0; i < theVect->size; i++)
+                F64(theVect->data + i * theVect->stride, 1);
+    }
+
+    /*! Size followed by the values */
+    void Vector(cDVector& theVect)
+    {
+        uint32_t mySize = U32();
+        Need((size_t)mySize * sizeof(double));
+        theVect.ReAlloc((int)mySize);
+        if (mySize > 0)
+            Values(theVect.GetGSLVector());
+    }
+
+    void End(void) const
+    {
+        if (mvPos != mvEnd)
+            throw std::runtime_error("RegArch serial: trailing bytes after the record");
+    }
+
+private:
+    const char* mvPos;
+    const char* mvEnd;
+};
+
+//------------------------------------------------------------------------------
+// Components
+//------------------------------------------------------------------------------
+/*
+ * Families of a mean or variance component: Get(k) until it throws. Both
+ * classes declare the same Get / ReAlloc / GetNLags / GetNParam, hence the
+ * templates.
+ */
+template<class T>
+static void PutFamilies(T& theComp, std::string& theDest)
+{
+    std::vector<cDVector> myFamily;
+    for (uint32_t k = 0; k < gsMaxFamily; k++)
+    {
+        try
+        {
+            myFamily.push_back(theComp.Get(k));
+        }
+        catch (...)
+        {
+            break;
+        }
+    }
+    PutU32(theComp.GetNLags(), theDest);
+    PutU32((uint32_t)myFamily.size(), theDest);
+    for (size_t k = 0; k < myFamily.size(); k++)
+        PutVector(myFamily[k], theDest);
+}
+
+/*! Sizes theComp as recorded. Scalar families (d of a Figarch...) may not accept ReAlloc, they are set with the parameters */
+template<class T>
+static uint32_t GetFamilies(cByteReader& theReader, T& theComp)
+{
+    uint32_t myNLags = theReader.U32();
+    uint32_t myNFamily = theReader.U32();
+    if (myNFamily > gsMaxFamily)
+        throw std::runtime_error("RegArch serial: corrupted component record");
+    cDVector myVect;
+    for (uint32_t k = 0; k < myNFamily; k++)
+    {
+        theReader.Vector(myVect);
+        try
+        {
+            theComp.ReAlloc(myVect, k);
+        }
+        catch (...)
+        {
+            if (myVect.GetSize() > 1)
+                throw std::runtime_error("RegArch serial: the component rejected one of its recorded orders");
+        }
+    }
+    return myNLags;
+}
+
+static void CheckSizes(uint32_t theNParam, uint32_t theExpected, uint32_t theNLags, uint32_t theExpectedLags)
+{
+    if (theNParam != theExpected || theNLags != theExpectedLags)
+        throw std::runtime_error("RegArch serial: the rebuilt component does not have the recorded number of parameters or lags");
+}
+
+void SerializeCondMean(cAbstCondMean& theMean, std::string& theDest)
+{
+    PutTag("RACM", theDest);
+    PutU32((uint32_t)theMean.GetCondMeanType(), theDest);
+    PutFamilies(theMean, theDest);
+    uint32_t myNParam = theMean.GetNParam();
+    cDVector myParam((int)myNParam);
+    if (myNParam > 0)
+        theMean.RegArchParamToVector(myParam, 0);
+    PutVector(myParam, theDest);
+}
+
+void SerializeCondVar(cAbstCondVar& theVar, std::string& theDest)
+{
+    PutTag("RACV", theDest);
+    uint32_t myType = (uint32_t)theVar.GetCondVarType();
+    if (dynamic_cast<cAutoDiffGarch*>(&theVar) != NULL || dynamic_cast<cAutoDiffTarch*>(&theVar) != NULL)
+        myType |= gsAutoDiffFlag;
+    PutU32(myType, theDest);
+    PutFamilies(theVar, theDest);
+    uint32_t myNParam = theVar.GetNParam();
+    cDVector myParam((int)myNParam);
+    if (myNParam > 0)
+        theVar.RegArchParamToVector(myParam, 0);
+    PutVector(myParam, theDest);
+}
+
+void SerializeResiduals(const cAbstResiduals& theResid, std::string& theDest)
+{
+    PutTag("RARS", theDest);
+    PutU32((uint32_t)theResid.GetDistrType(), theDest);
+    uint32_t myNParam = theResid.GetNParam();
+    cDVector myParam((int)myNParam);
+    if (myNParam > 0)
+        theResid.RegArchParamToVector(myParam, 0);
+    PutVector(myParam, theDest);
+}
+
+static cAbstCondMean* ReadCondMean(cByteReader& theReader)
+{
+    theReader.Tag("RACM");
+    cAbstCondMean* myMean = NULL;
+    uint32_t myType = theReader.U32();
+    switch ((eCondMeanEnum)myType)
+    {
+    case eConst: myMean = new cConst(); break;
+    case eAr: myMean = new cAr(); break;
+    case eMa: myMean = new cMa(); break;
+    case eLinReg: myMean = new cLinReg(); break;
+    case eStdDevInMean: myMean = new cStdDevInMean(); break;
+    case eVarInMean: myMean = new cVarInMean(); break;
+    case eArfima: myMean = new cArfima(); break;
+    default: throw std::runtime_error("RegArch serial: unknown conditional mean type");
+    }
+    try
+    {
+        uint32_t myNLags = GetFamilies(theReader, *myMean);
+        cDVector myParam;
+        theReader.Vector(myParam);
+        myMean->ReAllocProxyMeanParameters();
+        if (myParam.GetSize() > 0)
+            myMean->VectorToRegArchParam(myParam, 0);
+        myMean->UpdateProxyMeanParameters();
+        CheckSizes(myMean->GetNParam(), (uint32_t)myParam.GetSize(), myMean->GetNLags(), myNLags);
+    }
+    catch (...)
+    {
+        delete myMean;
+        throw;
+    }
+    return myMean;
+}
+
+/* theResid: residuals of the model being rebuilt, an Egarch needs them */
+static cAbstCondVar* ReadCondVar(cByteReader& theReader, cAbstResiduals* theResid)
+{
+    theReader.Tag("RACV");
+    cAbstCondVar* myVar = NULL;
+    uint32_t myType = theReader.U32();
+    // The AD twins have the type of the class they derive from, and the flag
+    if ((myType & gsAutoDiffFlag) != 0)
+    {
+        switch ((eCondVarEnum)(myType & ~gsAutoDiffFlag))
+        {
+        case eGarch: myVar = new cAutoDiffGarch(); break;
+        case eTarch: myVar = new cAutoDiffTarch(); break;
+        default: throw std::runtime_error("RegArch serial: unknown automatic differentiation variance type");
+        }
+    }
+    else
+    {
+        switch ((eCondVarEnum)myType)
+        {
+        case eCste: myVar = new cConstCondVar(); break;
+        case eArch: myVar = new cArch(); break;
+        case eGarch: myVar = new cGarch(); break;
+        case eNgarch: myVar = new cNgarch(); break;
+        // E|eps| of an Egarch is computed from the residuals
+        case eEgarch: myVar = (theResid != NULL) ? new cEgarch(theResid) : new cEgarch(); break;
+        case eAparch: myVar = new cAparch(); break;
+        case eTarch: myVar = new cTarch(); break;
+        case eFigarch: myVar = new cFigarch(); break;
+        case eUgarch: myVar = new cUgarch(); break;
+        case eTsgarch: myVar = new cTsgarch(); break;
+        case eGtarch: myVar = new cGtarch(); break;
+        case eNagarch: myVar = new cNagarch(); break;
+        case eSqrgarch: myVar = new cSqrgarch(); break;
+        default: throw std::runtime_error("RegArch serial: unknown conditional variance type");
+        }
+    }
+    try
+    {
+        uint32_t myNLags = GetFamilies(theReader, *myVar);
+        cDVector myParam;
+        theReader.Vector(myParam);
+        myVar->ReAllocProxyVarParameters();
+        if (myParam.GetSize() > 0)
+            myVar->VectorToRegArchParam(myParam, 0);
+        myVar->UpdateProxyVarParameters();
+        CheckSizes(myVar->GetNParam(), (uint32_t)myParam.GetSize(), myVar->GetNLags(), myNLags);
+    }
+    catch (...)
+    {
+        delete myVar;
+        throw;
+    }
+    return myVar;
+}
+
+static cAbstResiduals* ReadResiduals(cByteReader& theReader)
+{
+    theReader.Tag("RARS");
+    cAbstResiduals* myResid = NULL;
+    uint32_t myType = theReader.U32();
+    switch ((eDistrTypeEnum)myType)
+    {
+    case eNormal: myResid = new cNormResiduals(); break;
+    case eStudent: myResid = new cStudentResiduals(); break;
+    case eGed: myResid = new cGedResiduals(); break;
+    // Placeholder weights, the recorded ones are set below
+    case eMixNorm: myResid = new cMixNormResiduals(0.5, 1.0, 1.0); break;
+    default: throw std::runtime_error("RegArch serial: unknown residuals type");
+    }
+    try
+    {
+        cDVector myParam;
+        theReader.Vector(myParam);
+        if (myParam.GetSize() > 0)
+            myResid->VectorToRegArchParam(myParam, 0);
+        CheckSizes(myResid->GetNParam(), (uint32_t)myParam.GetSize(), 0, 0);
+    }
+    catch (...)
+    {
+        delete myResid;
+        throw;
+    }
+    return myResid;
+}
+
+cAbstCondMean* NewCondMean(const std::string& theSrc)
+{
+    cByteReader myReader(theSrc.data(), theSrc.size());
+    cAbstCondMean* myRes = ReadCondMean(myReader);
+    try
+    {
+        myReader.End();
+    }
+    catch (...)
+    {
+        delete myRes;
+        throw;
+    }
+    return myRes;
+}
+
+cAbstCondVar* NewCondVar(const std::string& theSrc)
+{
+    cByteReader myReader(theSrc.data(), theSrc.size());
+    cAbstCondVar* myRes = ReadCondVar(myReader, NULL);
+    try
+    {
+        myReader.End();
+    }
+    catch (...)
+    {
+        delete myRes;
+        throw;
+    }
+    return myRes;
+}
+
+cAbstResiduals* NewResiduals(const std::string& theSrc)
+{
+    cByteReader myReader(theSrc.data(), theSrc.size());
+    cAbstResiduals* myRes = ReadResiduals(myReader);
+    try
+    {
+        myReader.End();
+    }
+    catch (...)
+    {
+        delete myRes;
+        throw;
+    }
+    return myRes;
+}
+
+//------------------------------------------------------------------------------
+// Model
+//------------------------------------------------------------------------------
+void SerializeRegArchModel(const cRegArchModel& theModel, std::string& theDest)
+{
+    PutTag("RAMD", theDest);
+    uint32_t myNMean = (theModel.mMean != NULL) ? theModel.mMean->GetNMean() : 0;
+    PutU32(myNMean, theDest);
+    for (uint32_t i = 0; i < myNMean; i++)
+        SerializeCondMean(*theModel.mMean->GetCondMean()[i], theDest);
+    // The residuals come first: an Egarch is built on them
+    PutU32(theModel.mResids != NULL, theDest);
+    if (theModel.mResids != NULL)
+        SerializeResiduals(*theModel.mResids, theDest);
+    PutU32(theModel.mVar != NULL, theDest);
+    if (theModel.mVar != NULL)
+        SerializeCondVar(*theModel.mVar, theDest);
+}
+
+void DeserializeRegArchModel(const std::string& theSrc, cRegArchModel& theModel)
+{
+    DeserializeRegArchModel(theSrc.data(), theSrc.size(), theModel);
+}
+
+void DeserializeRegArchModel(const char* theData, size_t theSize, cRegArchModel& theModel)
+{
+    cByteReader myReader(theData, theSize);
+    myReader.Tag("RAMD");
+
+    // Everything is decoded before theModel is touched
+    cCondMean myMean;
+    cAbstResiduals* myResid = NULL;
+    cAbstCondVar* myVar = NULL;
+    try
+    {
+        uint32_t myNMean = myReader.U32();
+        for (uint32_t i = 0; i < myNMean; i++)
+        {
+            cAbstCondMean* myOne = ReadCondMean(myReader);
+            myMean.AddOneMean(*myOne);
+            delete myOne;
+        }
+        if (myReader.U32() != 0)
+            myResid = ReadResiduals(myReader);
+        if (myReader.U32() != 0)
+            myVar = ReadCondVar(myReader, myResid);
+        myReader.End();
+    }
+    catch (...)
+    {
+        delete myVar;
+        delete myResid;
+        throw;
+    }
+
+    theModel.Delete();
+    if (myMean.GetNMean() > 0)
+        theModel.SetMean(myMean);
+    if (myResid != NULL)
+        theModel.SetResid(*myResid);
+    if (myVar != NULL)
+        theModel.SetVar(*myVar);
+    delete myVar;
+    delete myResid;
+}
+
+//------------------------------------------------------------------------------
+// Data
+//------------------------------------------------------------------------------
+void SerializeRegArchValue(const cRegArchValue& theValue, std::string& theDest)
+{
+    PutTag("RAVL", theDest);
+    uint32_t mySize = (uint32_t)theValue.mYt.GetSize();
+    const cDVector* mySeries[] = { &theValue.mYt, &theValue.mMt, &theValue.mHt, &theValue.mUt, &theValue.mEpst };
+    theDest.reserve(theDest.size() + 5 * (size_t)mySize * sizeof(double));
+    PutU32(mySize, theDest);
+    for (int k = 0; k < 5; k++)
+    {
+        // The size is written once
+        if (mySeries[k]->GetSize() != (int)mySize)
+            throw std::runtime_error("RegArch serial: the series of the value do not have the same size");
+        PutValues(*mySeries[k], theDest);
+    }
+    PutMatrix(theValue.mXt, theDest);
+    PutMatrix(theValue.mXvt, theDest);
+}
+
+void DeserializeRegArchValue(const std::string& theSrc, cRegArchValue& theValue)
+{
+    cByteReader myReader(theSrc.data(), theSrc.size());
+    myReader.Tag("RAVL");
+    uint32_t mySize = myReader.U32();
+    myReader.Need(5 * (size_t)mySize * sizeof(double));
+    theValue.ReAlloc((uint)mySize);
+    cDVector* mySeries[] = { &theValue.mYt, &theValue.mMt, &theValue.mHt, &theValue.mUt, &theValue.mEpst };
+    for (int k = 0; k < 5 && mySize > 0; k++)
+        myReader.Values(mySeries[k]->GetGSLVector());
+    for (int k = 0; k < 2; k++)
+    {
+        uint32_t myNRow = myReader.U32();
+        uint32_t myNCol = myReader.U32();
+        myReader.Need((size_t)myNRow * myNCol * sizeof(double));
+        if (myNRow * myNCol == 0)
+            continue;
+        if (k == 0)
+            theValue.ReAllocXt(myNRow, myNCol);
+        else
+            theValue.ReAllocXvt(myNRow, myNCol);
+        gsl_matrix* myM = (k == 0) ? theValue.mXt.GetGSLMatrix() : theValue.mXvt.GetGSLMatrix();
+        for (uint32_t r = 0; r < myNRow; r++)
+            myReader.F64(myM->data + r * myM->tda, myNCol);
+    }
+    myReader.End();
+}
@@ -0,0 +1,56 @@
+#ifndef _CREGARCHSERIAL_H_
+#define _CREGARCHSERIAL_H_
+
+#include "StdAfxRegArchLib.h"
+#include <string>
+
+/*!
+ * \file cRegArchSerial.h
+ * \brief Compact binary encoding of models, components and data sets.
+ *
+ * Used by the pickle support of the Python classes. Every record starts with
+ * a four character tag and a version, followed by native-endian uint32
+ * counts and float64 values:
+ *
+ *   mean / variance : type, nLags, nFamily, { size, values } * nFamily, nParam, params
+ *   residuals       : type, nParam, params
+ *   model           : nMean, mean records, variance record (type 0: none), residuals record
+ *   value           : n, Yt Mt Ht Ut Epst (n each), Xt (rows, cols, row-major), Xvt
+ *
+ * The families of a component are the vectors returned by Get(k) for
+ * k = 0, 1, ... until the component rejects k: they give the orders (AR
+ * lags, ARCH and GARCH terms...). On reading, the component is rebuilt from
+ * its type, resized family by family with ReAlloc, then the parameters are
+ * set with VectorToRegArchParam. The number of parameters and of lags are
+ * checked at the end, a std::runtime_error is thrown if they differ.
+ *
+ * The variance type of cAutoDiffGarch and cAutoDiffTarch has its high bit
+ * set, so that they come back as the AD class and not as cGarch / cTarch.
+ *
+ * Only the RegArchLib components are supported: a component written in
+ * Python has no type to rebuild it from.
+ */
+
+/*! Appends the encoding of theMean to theDest */
+extern void SerializeCondMean(RegArchLib::cAbstCondMean& theMean, std::string& theDest);
+/*! Appends the encoding of theVar to theDest */
+extern void SerializeCondVar(RegArchLib::cAbstCondVar& theVar, std::string& theDest);
+/*! Appends the encoding of theResid to theDest */
+extern void SerializeResiduals(const RegArchLib::cAbstResiduals& theResid, std::string& theDest);
+/*! Appends the encoding of theModel to theDest */
+extern void SerializeRegArchModel(const RegArchLib::cRegArchModel& theModel, std::string& theDest);
+/*! Appends the encoding of theValue to theDest */
+extern void SerializeRegArchValue(const RegArchLib::cRegArchValue& theValue, std::string& theDest);
+
+/*! New component decoded from theSrc, to be deleted by the caller */
+extern RegArchLib::cAbstCondMean* NewCondMean(const std::string& theSrc);
+extern RegArchLib::cAbstCondVar* NewCondVar(const std::string& theSrc);
+extern RegArchLib::cAbstResiduals* NewResiduals(const std::string& theSrc);
+/*! Replaces the components of theModel by the ones decoded from theSrc */
+extern void DeserializeRegArchModel(const std::string& theSrc, RegArchLib::cRegArchModel& theModel);
+/*! Same, from theSize bytes at theData (a memory mapping) */
+extern void DeserializeRegArchModel(const char* theData, size_t theSize, RegArchLib::cRegArchModel& theModel);
+/*! Resizes theValue and fills it with the series decoded from theSrc */
+extern void DeserializeRegArchValue(const std::string& theSrc, RegArchLib::cRegArchValue& theValue);
+
+#endif // _CREGARCHSERIAL_H_
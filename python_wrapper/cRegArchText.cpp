@@ -0,0 +1,292 @@
+#include "cRegArchText.h"
+#include "cMappedFile.h"
+#include "cThreadPool.h"
+#include "cProfile.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+using namespace RegArchLib;
+
+// Smallest chunk worth a task
+static const size_t gsMinChunk = 1 << 16;
+
+typedef struct sTextChunk
+{
+    const char* mBegin;
+    const char* mEnd;
+    std::vector<double> mRows;  // row-major, one entry per used column
+    uint mNRow;
+    const char* mErrorAt;       // start of the faulty line, NULL if none
+    std::string mError;
+} sTextChunk;
+
+static bool IsBlank(char theChar)
+{
+    return theChar == ' ' || theChar == '\t' || theChar == '\r';
+}
+
+static const char* LineEnd(const char* theBegin, const char* theEnd)
+{
+    const char* myEol = static_cast<const char*>(memchr(theBegin, '\n', theEnd - theBegin));
+    return (myEol != NULL) ? myEol : theEnd;
+}
+
+// Field [theBegin, theEnd) without blanks and quotes
+static void Trim(const char*& theBegin, const char*& theEnd)
+{
+    while (theBegin < theEnd && IsBlank(*theBegin))
+        theBegin++;
+    while (theEnd > theBegin && IsBlank(theEnd[-1]))
+        theEnd--;
+    if (theEnd - theBegin >= 2 && *theBegin == '"' && theEnd[-1] == '"')
+    {
+        theBegin++;
+        theEnd--;
+    }
+}
+
+// Next field of the line starting at theBegin, theNext is after its separator
+static const char* FieldEnd(const char* theBegin, const char* theEnd, char theDelimiter, const char*& theNext)
+{
+    if (theDelimiter != '\0')
+    {
+        const char* mySep = static_cast<const char*>(memchr(theBegin, theDelimiter, theEnd - theBegin));
+        if (mySep == NULL)
+        {
+            theNext = NULL;
+            return theEnd;
+        }
+        theNext = mySep + 1;
+        return mySep;
+    }
+    const char* myPos = theBegin;
+    while (myPos < theEnd && !IsBlank(*myPos))
+        myPos++;
+    const char* myFieldEnd = myPos;
+    while (myPos < theEnd && IsBlank(*myPos))
+        myPos++;
+    theNext = (myPos < theEnd) ? myPos : NULL;
+    return myFieldEnd;
+}
+
+// 0: value read, 1: missing, -1: not a number
+static int ParseField(const char* theBegin, const char* theEnd, const std::vector<std::string>& theMissing, double& theValue)
+{
+    Trim(theBegin, theEnd);
+    if (theBegin == theEnd)
+        return 1;
+    for (size_t k = 0; k < theMissing.size(); k++)
+        if (theMissing[k].size() == (size_t)(theEnd - theBegin) && memcmp(theMissing[k].data(), theBegin, theMissing[k].size()) == 0)
+            return 1;
+    const char* myStart = (*theBegin == '+') ? theBegin + 1 : theBegin;
+    std::from_chars_result myRes = std::from_chars(myStart, theEnd, theValue);
+    if (myRes.ptr != theEnd)
+        return -1;
+    if (myRes.ec == std::errc::result_out_of_range)
+    {
+        // from_chars leaves the value unset: under/overflow as strtod gives it
+        theValue = strtod(std::string(myStart, theEnd).c_str(), NULL);
+        return 0;
+    }
+    return (myRes.ec == std::errc()) ? 0 : -1;
+}
+
+static void ParseChunk(sTextChunk& theChunk, const sTextOptions& theOptions, const std::vector<int>& theSlot, uint theNUsed)
+{
+    std::vector<double> myRow(theNUsed);
+    uint myNCol = (uint)theSlot.size();
+    theChunk.mNRow = 0;
+    theChunk.mErrorAt = NULL;
+    for (const char* myLine = theChunk.mBegin; myLine < theChunk.mEnd; )
+    {
+        const char* myEol = LineEnd(myLine, theChunk.mEnd);
+        const char* myPos = myLine;
+        while (myPos < myEol && IsBlank(*myPos))
+            myPos++;
+        if (myPos == myEol)
+        {
+            myLine = myEol + 1;
+            continue;
+        }
+        if (theOptions.mDelimiter != '\0')
+            myPos = myLine;
+
+        bool myMissing = false;
+        uint myCol = 0;
+        for (; myCol < myNCol && myPos != NULL; myCol++)
+        {
+            const char* myNext;
+            const char* myFieldEnd = FieldEnd(myPos, myEol, theOptions.mDelimiter, myNext);
+            int mySlot = theSlot[myCol];
+            if (mySlot >= 0)
+            {
+                int myStatus = ParseField(myPos, myFieldEnd, theOptions.mMissing, myRow[mySlot]);
+                if (myStatus < 0)
+                {
+                    const char* myBegin = myPos;
+                    const char* myEnd = myFieldEnd;
+                    Trim(myBegin, myEnd);
+                    theChunk.mErrorAt = myLine;
+                    theChunk.mError = "column " + std::to_string(myCol) + ": cannot read '" + std::string(myBegin, myEnd) + "' as a number";
+                    return;
+                }
+                if (myStatus > 0)
+                {
+                    if (theOptions.mOnMissing == eMissingError)
+                    {
+                        theChunk.mErrorAt = myLine;
+                        theChunk.mError = "column " + std::to_string(myCol) + ": missing value";
+                        return;
+                    }
+                    myMissing = true;
+                    myRow[mySlot] = std::numeric_limits<double>::quiet_NaN();
+                }
+            }
+            myPos = myNext;
+        }
+        if (myCol < myNCol)
+        {
+            theChunk.mErrorAt = myLine;
+            theChunk.mError = std::to_string(myNCol) + " columns expected, " + std::to_string(myCol) + " found";
+            return;
+        }
+        if (!myMissing || theOptions.mOnMissing != eMissingSkipRow)
+        {
+            theChunk.mRows.insert(theChunk.mRows.end(), myRow.begin(), myRow.end());
+            theChunk.mNRow++;
+        }
+        myLine = myEol + 1;
+    }
+}
+
+void LoadRegArchText(const char* theData, size_t theSize, const sTextOptions& theOptions, cRegArchValue& theValue)
+{
+    REGARCH_PROFILE_SCOPE("driver", "cRegArchText", "LoadRegArchText");
+    // Slot of each column in a row: Yt, then Xt, then Xvt; -1 if unused
+    uint myNXt = (uint)theOptions.mXtCol.size();
+    uint myNXvt = (uint)theOptions.mXvtCol.size();
+    uint myNUsed = 1 + myNXt + myNXvt;
+    uint myMaxCol = theOptions.mYtCol;
+    for (uint k = 0; k < myNXt; k++)
+        myMaxCol = std::max(myMaxCol, theOptions.mXtCol[k]);
+    for (uint k = 0; k < myNXvt; k++)
+        myMaxCol = std::max(myMaxCol, theOptions.mXvtCol[k]);
+    std::vector<int> mySlot(myMaxCol + 1, -1);
+    std::vector<uint> myCols(1, theOptions.mYtCol);
+    myCols.insert(myCols.end(), theOptions.mXtCol.begin(), theOptions.mXtCol.end());
+    myCols.insert(myCols.end(), theOptions.mXvtCol.begin(), theOptions.mXvtCol.end());
+    for (uint k = 0; k < myNUsed; k++)
+    {
+        if (mySlot[myCols[k]] >= 0)
+            throw std::runtime_error("LoadRegArchText: column " + std::to_string(myCols[k]) + " is used twice");
+        mySlot[myCols[k]] = (int)k;
+    }
+
+    if (theSize == 0)
+        throw std::runtime_error("LoadRegArchText: no data row");
+    const char* myEnd = theData + theSize;
+    const char* myBody = theData;
+    if (theOptions.mHeader)
+        myBody = std::min(LineEnd(theData, myEnd) + 1, myEnd);
+
+    // Chunks end on line boundaries
+    cThreadPool myPool(theOptions.mNThread);
+    size_t myBodySize = myEnd - myBody;
+    size_t myNChunk = std::max<size_t>(1, std::min<size_t>(myBodySize / gsMinChunk, 8 * (size_t)myPool.GetNThread()));
+    std::vector<sTextChunk> myChunk(myNChunk);
+    const char* myPos = myBody;
+    for (size_t c = 0; c < myNChunk; c++)
+    {
+        myChunk[c].mBegin = myPos;
+        if (c + 1 < myNChunk)
+        {
+            const char* myCut = std::max(myPos, myBody + myBodySize * (c + 1) / myNChunk);
+            myPos = (myCut > myBody && myCut[-1] == '\n') ? myCut : std::min(LineEnd(myCut, myEnd) + 1, myEnd);
+        }
+        else
+            myPos = myEnd;
+        myChunk[c].mEnd = myPos;
+    }
+
+    myPool.ParallelFor((unsigned int)myNChunk, [&](unsigned int c, unsigned int)
+    {
+        ParseChunk(myChunk[c], theOptions, mySlot, myNUsed);
+    });
+
+    // First error in the text, with its line number
+    std::vector<uint> myFirstRow(myNChunk + 1, 0);
+    for (size_t c = 0; c < myNChunk; c++)
+    {
+        if (myChunk[c].mErrorAt != NULL)
+        {
+            size_t myLine = 1 + std::count(theData, myChunk[c].mErrorAt, '\n');
+            throw std::runtime_error("LoadRegArchText: line " + std::to_string(myLine) + ": " + myChunk[c].mError);
+        }
+        myFirstRow[c + 1] = myFirstRow[c] + myChunk[c].mNRow;
+    }
+    uint myNRow = myFirstRow[myNChunk];
+    if (myNRow == 0)
+        throw std::runtime_error("LoadRegArchText: no data row");
+
+    theValue.ReAlloc(myNRow);
+    if (myNXt > 0)
+        theValue.ReAllocXt(myNRow, myNXt);
+    if (myNXvt > 0)
+        theValue.ReAllocXvt(myNRow, myNXvt);
+    gsl_vector* myYt = theValue.mYt.GetGSLVector();
+    gsl_matrix* myXt = (myNXt > 0) ? theValue.mXt.GetGSLMatrix() : NULL;
+    gsl_matrix* myXvt = (myNXvt > 0) ? theValue.mXvt.GetGSLMatrix() : NULL;
+    myPool.ParallelFor((unsigned int)myNChunk, [&](unsigned int c, unsigned int)
+    {
+        const double* mySrc = myChunk[c].mRows.data();
+        for (uint r = myFirstRow[c]; r < myFirstRow[c + 1]; r++, mySrc += myNUsed)
+        {
+            myYt->data[r * myYt->stride] = mySrc[0];
+            if (myXt != NULL)
+                memcpy(myXt->data + r * myXt->tda, mySrc + 1, myNXt * sizeof(double));
+            if (myXvt != NULL)
+                memcpy(myXvt->data + r * myXvt->tda, mySrc + 1 + myNXt, myNXvt * sizeof(double));
+        }
+        std::vector<double>().swap(myChunk[c].mRows);
+    });
+}
+
+void LoadRegArchText(const std::string& thePath, const sTextOptions& theOptions, cRegArchValue& theValue)
+{
+    cMappedFile myFile(thePath);
+    try
+    {
+        LoadRegArchText(myFile.GetData(), myFile.GetSize(), theOptions, theValue);
+    }
+    catch (const std::runtime_error& e)
+    {
+        throw std::runtime_error(thePath + ": " + e.what());
+    }
+}
+
+std::vector<std::string> ReadTextHeader(const std::string& thePath, char theDelimiter)
+{
+    cMappedFile myFile(thePath);
+    std::vector<std::string> myRes;
+    if (myFile.GetSize() == 0)
+        return myRes;
+    const char* myPos = myFile.GetData();
+    const char* myEol = LineEnd(myPos, myPos + myFile.GetSize());
+    if (theDelimiter == '\0')
+        while (myPos < myEol && IsBlank(*myPos))
+            myPos++;
+    while (myPos != NULL && myPos < myEol)
+    {
+        const char* myNext;
+        const char* myFieldEnd = FieldEnd(myPos, myEol, theDelimiter, myNext);
+        const char* myBegin = myPos;
+        Trim(myBegin, myFieldEnd);
+        myRes.push_back(std::string(myBegin, myFieldEnd));
+        myPos = myNext;
+    }
+    return myRes;
+}
@@ -0,0 +1,52 @@
+#ifndef _CREGARCHTEXT_H_
+#define _CREGARCHTEXT_H_
+
+#include "StdAfxRegArchLib.h"
+#include <string>
+#include <vector>
+
+/*!
+ * \file cRegArchText.h
+ * \brief Native reader of delimited numeric text (CSV, TSV...) into a cRegArchValue.
+ *
+ * The text is split into chunks on line boundaries, the chunks are parsed
+ * on a cThreadPool with std::from_chars, then copied in one pass into mYt,
+ * mXt and mXvt. A file is read through a memory mapping.
+ *
+ * A field is trimmed of blanks and of surrounding double quotes. An empty
+ * field, or one equal to a token of mMissing, is a missing value; what is
+ * done with it depends on mOnMissing. Blank lines are skipped. Errors are
+ * reported as std::runtime_error with the line number.
+ */
+typedef enum eTextMissing
+{
+    eMissingError,      /*!< a missing value is an error */
+    eMissingNaN,        /*!< a missing value is read as NaN */
+    eMissingSkipRow     /*!< a row with a missing value is dropped */
+} eTextMissing;
+
+typedef struct sTextOptions
+{
+    char mDelimiter;                    /*!< field separator, '\0' for runs of blanks */
+    bool mHeader;                       /*!< the first line holds the column names */
+    uint mYtCol;                        /*!< column of Yt */
+    std::vector<uint> mXtCol;           /*!< columns of Xt, none if empty */
+    std::vector<uint> mXvtCol;          /*!< columns of Xvt, none if empty */
+    std::vector<std::string> mMissing;  /*!< tokens read as missing, besides the empty field */
+    eTextMissing mOnMissing;
+    unsigned int mNThread;              /*!< 0 means hardware_concurrency() */
+
+    sTextOptions()
+        : mDelimiter(','), mHeader(false), mYtCol(0), mOnMissing(eMissingError), mNThread(0)
+    {
+    }
+} sTextOptions;
+
+/*! Fills theValue (ReAlloc, ReAllocXt, ReAllocXvt) from theSize bytes of text */
+void LoadRegArchText(const char* theData, size_t theSize, const sTextOptions& theOptions, RegArchLib::cRegArchValue& theValue);
+/*! Same, from the file thePath */
+void LoadRegArchText(const std::string& thePath, const sTextOptions& theOptions, RegArchLib::cRegArchValue& theValue);
+/*! Fields of the first line of thePath, trimmed and unquoted */
+std::vector<std::string> ReadTextHeader(const std::string& thePath, char theDelimiter = ',');
+
+#endif // _CREGARCHTEXT_H_
@@ -0,0 +1,59 @@
+#include "cRegArchValueView.h"
+#include <stdexcept>
+#include <string>
+
+using namespace RegArchLib;
+
+// Start of row theRow of a parent matrix, NULL if there is none
+static double* MatrixRow(const cDMatrix& theMat, uint theRow, uint theNRow, uint& theNCol)
+{
+    gsl_matrix* myM = theMat.GetGSLMatrix();
+    theNCol = 0;
+    if (myM == NULL || myM->size1 * myM->size2 == 0)
+        return NULL;
+    if (myM->size1 != theNRow)
+        throw std::runtime_error("cRegArchValueView: the regressors of the parent do not have one row per date");
+    if (myM->tda != myM->size2)
+        throw std::runtime_error("cRegArchValueView: the regressors of the parent are not contiguous");
+    theNCol = (uint)myM->size2;
+    return myM->data + (size_t)theRow * myM->tda;
+}
+
+cRegArchValueView::cRegArchValueView(cRegArchValue& theParent, uint theBegin, uint theEnd)
+    : mvParent(theParent), mvBegin(0), mvEnd(0)
+{
+    SetRange(theBegin, theEnd);
+}
+
+void cRegArchValueView::SetRange(uint theBegin, uint theEnd)
+{
+    gsl_vector* myYt = mvParent.mYt.GetGSLVector();
+    uint mySize = (myYt != NULL) ? (uint)myYt->size : 0;
+    if (theBegin >= theEnd || theEnd > mySize)
+        throw std::out_of_range("cRegArchValueView: window [" + std::to_string(theBegin) + ", " + std::to_string(theEnd)
+            + ") is not in [0, " + std::to_string(mySize) + ")");
+    if (myYt->stride != 1)
+        throw std::runtime_error("cRegArchValueView: Yt of the parent is not contiguous");
+
+    uint myNXtCol, myNXvtCol;
+    double* myXt = MatrixRow(mvParent.mXt, theBegin, mySize, myNXtCol);
+    double* myXvt = MatrixRow(mvParent.mXvt, theBegin, mySize, myNXvtCol);
+    AttachData(myYt->data + theBegin, theEnd - theBegin, myXt, myNXtCol, myXvt, myNXvtCol);
+    mvBegin = theBegin;
+    mvEnd = theEnd;
+}
+
+uint cRegArchValueView::GetBegin(void) const
+{
+    return mvBegin;
+}
+
+uint cRegArchValueView::GetEnd(void) const
+{
+    return mvEnd;
+}
+
+cRegArchValue& cRegArchValueView::GetParent(void) const
+{
+    return mvParent;
+}
@@ -0,0 +1,36 @@
+#ifndef _CREGARCHVALUEVIEW_H_
+#define _CREGARCHVALUEVIEW_H_
+
+#include "cPackedRegArchValue.h"
+
+/*!
+ * \file cRegArchValueView.h
+ * \brief Window [begin, end) of the data of another cRegArchValue.
+ *
+ * mYt, mXt and mXvt point at rows begin to end - 1 of the parent, nothing
+ * is copied; mMt, mHt, mUt and mEpst are the view's own, in its arena. As a
+ * cRegArchValue it is accepted by every RegArchLib function. SetRange()
+ * moves the window: a rolling window of constant length reuses the arena,
+ * only the pointers change.
+ *
+ * The parent must outlive the view and must not be reallocated while the
+ * view is in use. Pack() turns the view into an independent copy.
+ */
+class cRegArchValueView : public cPackedRegArchValue
+{
+public:
+    /*! Throws std::out_of_range if the range is empty or not in the parent */
+    cRegArchValueView(RegArchLib::cRegArchValue& theParent, uint theBegin, uint theEnd);
+
+    void SetRange(uint theBegin, uint theEnd);
+    uint GetBegin(void) const;
+    uint GetEnd(void) const;
+    RegArchLib::cRegArchValue& GetParent(void) const;
+
+private:
+    RegArchLib::cRegArchValue& mvParent;
+    uint mvBegin;
+    uint mvEnd;
+};
+
+#endif // _CREGARCHVALUEVIEW_H_
@@ -0,0 +1,104 @@
+#ifndef _CRINGHISTORY_H_
+#define _CRINGHISTORY_H_
+
+#include <cstddef>
+#include <vector>
+
+/*!
+ * \file cRingHistory.h
+ * \brief Fixed-depth history of equally sized blocks in one contiguous buffer.
+ *
+ * The last GetDepth() blocks of GetWidth() values each are kept in a single
+ * allocation. Push() overwrites the oldest block and moves the head, nothing
+ * is shifted: an update is O(width) whatever the depth. Lag(j) translates a
+ * lag into a slot, Lag(0) being the block pushed last.
+ *
+ *   cRingHistory<double> myHist(L, k);
+ *   double* mySlot = myHist.Push();      // fill the k values of date t
+ *   const double* myOld = myHist.Lag(j); // values of date t - j, j < GetSize()
+ *
+ * Used by cRegArchSandwich for the HAC score lags and the bandwidth series.
+ * The lagged gradients and Hessians of h(t) and m(t) stay in the
+ * cRegArchGradient / cRegArchHessien of RegArchLib, whose Update() shift the
+ * wrapper cannot replace; RegArchLtSeries keeps every score, not a window.
+ */
+template<class T>
+class cRingHistory
+{
+public:
+    cRingHistory(size_t theDepth = 0, size_t theWidth = 0)
+    {
+        ReAlloc(theDepth, theWidth);
+    }
+
+    /*! Sets the depth and the width, and empties the history */
+    void ReAlloc(size_t theDepth, size_t theWidth)
+    {
+        mvDepth = theDepth;
+        mvWidth = theWidth;
+        mvData.assign(theDepth * theWidth, T());
+        Clear();
+    }
+
+    /*! Empties the history, the allocation is kept */
+    void Clear(void)
+    {
+        mvHead = 0;
+        mvSize = 0;
+    }
+
+    /*! Frees the buffer */
+    void Delete(void)
+    {
+        std::vector<T>().swap(mvData);
+        mvDepth = mvWidth = 0;
+        Clear();
+    }
+
+    size_t GetDepth(void) const { return mvDepth; }
+    size_t GetWidth(void) const { return mvWidth; }
+    /*! Number of blocks stored, at most GetDepth() */
+    size_t GetSize(void) const { return mvSize; }
+
+    /*! Slot of the new most recent block, it holds the oldest values until written. GetDepth() > 0 */
+    T* Push(void)
+    {
+        mvHead = (mvHead + 1 == mvDepth) ? 0 : mvHead + 1;
+        if (mvSize < mvDepth)
+            mvSize++;
+        return &mvData[mvHead * mvWidth];
+    }
+
+    /*! Copies theValues (GetWidth() values) as the new most recent block */
+    void Push(const T* theValues)
+    {
+        T* mySlot = Push();
+        for (size_t i = 0; i < mvWidth; i++)
+            mySlot[i] = theValues[i];
+    }
+
+    /*! Block pushed theLag dates ago, theLag < GetSize() */
+    T* Lag(size_t theLag)
+    {
+        return &mvData[Slot(theLag) * mvWidth];
+    }
+
+    const T* Lag(size_t theLag) const
+    {
+        return &mvData[Slot(theLag) * mvWidth];
+    }
+
+private:
+    size_t Slot(size_t theLag) const
+    {
+        return (theLag <= mvHead) ? mvHead - theLag : mvHead + mvDepth - theLag;
+    }
+
+    std::vector<T> mvData;
+    size_t mvDepth;
+    size_t mvWidth;
+    size_t mvHead;
+    size_t mvSize;
+};
+
+#endif // _CRINGHISTORY_H_
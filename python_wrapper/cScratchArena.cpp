@@ -0,0 +1,73 @@
+#include "cScratchArena.h"
+#include "cProfile.h"
+#include <new>
+
+cScratchArena& cScratchArena::Local(void)
+{
+    thread_local cScratchArena myArena;
+    return myArena;
+}
+
+cScratchArena::cScratchArena()
+    : mvCurrent(0), mvUsed(0)
+{
+}
+
+cScratchArena::~cScratchArena()
+{
+    for (size_t i = 0; i < mvChunk.size(); i++)
+        ::operator delete(mvChunk[i].mData, std::align_val_t(msAlign));
+}
+
+void* cScratchArena::AllocBytes(size_t theBytes)
+{
+    // Keep every block aligned
+    theBytes = (theBytes + msAlign - 1) / msAlign * msAlign;
+    if (theBytes == 0)
+        theBytes = msAlign;
+
+    // First chunk from the current one that has room, a new one at the end otherwise
+    while (mvCurrent < mvChunk.size() && mvUsed + theBytes > mvChunk[mvCurrent].mSize)
+    {
+        mvCurrent++;
+        mvUsed = 0;
+    }
+    if (mvCurrent == mvChunk.size())
+    {
+        size_t mySize = (mvChunk.empty()) ? msMinChunk : 2 * mvChunk.back().mSize;
+        if (mySize < theBytes)
+            mySize = theBytes;
+        REGARCH_PROFILE_COUNT("alloc", "cScratchArena", "chunk", 1);
+        sChunk myChunk = { static_cast<char*>(::operator new(mySize, std::align_val_t(msAlign))), mySize };
+        mvChunk.push_back(myChunk);
+        mvUsed = 0;
+    }
+    void* myRes = mvChunk[mvCurrent].mData + mvUsed;
+    mvUsed += theBytes;
+    return myRes;
+}
+
+cScratchArena::sMark cScratchArena::GetMark(void) const
+{
+    sMark myMark = { mvCurrent, mvUsed };
+    return myMark;
+}
+
+void cScratchArena::Release(const sMark& theMark)
+{
+    mvCurrent = theMark.mChunk;
+    mvUsed = theMark.mUsed;
+}
+
+size_t cScratchArena::GetNChunk(void) const
+{
+    return mvChunk.size();
+}
+
+size_t cScratchArena::GetCapacity(void) const
+{
+    size_t myRes = 0;
+    for (size_t i = 0; i < mvChunk.size(); i++)
+        myRes += mvChunk[i].mSize;
+    return myRes;
+}
@@ -0,0 +1,106 @@
+#ifndef _CSCRATCHARENA_H_
+#define _CSCRATCHARENA_H_
+
+#include <cstddef>
+#include <vector>
+
+/*!
+ * \file cScratchArena.h
+ * \brief Thread-local bump allocator for the temporaries of the compute helpers.
+ *
+ * Each thread owns one arena made of 64-byte aligned chunks. Alloc() moves a
+ * pointer forward; a cScratchScope records the position on entry and puts it
+ * back on exit, so everything allocated inside the scope is released at
+ * once, without touching the heap:
+ *
+ *   cScratchScope myScope;
+ *   double* myTmp = myScope.Alloc<double>(n);   // valid until the scope ends
+ *
+ * Chunks are kept when released: after the first call of a given size, the
+ * helpers run without any malloc and without contention between threads.
+ * Memory from Alloc() is uninitialised and must not outlive its scope.
+ */
+class cScratchArena
+{
+public:
+    typedef struct sMark
+    {
+        size_t mChunk;
+        size_t mUsed;
+    } sMark;
+
+    /*! Arena of the calling thread */
+    static cScratchArena& Local(void);
+
+    void* AllocBytes(size_t theBytes);
+    sMark GetMark(void) const;
+    void Release(const sMark& theMark);
+
+    /*! Number of chunks allocated from the heap by this thread */
+    size_t GetNChunk(void) const;
+    /*! Bytes reserved by this thread */
+    size_t GetCapacity(void) const;
+
+    static const size_t msAlign = 64;
+    static const size_t msMinChunk = 64 * 1024;
+
+    ~cScratchArena();
+
+private:
+    cScratchArena();
+    cScratchArena(const cScratchArena&) = delete;
+    cScratchArena& operator=(const cScratchArena&) = delete;
+
+    typedef struct sChunk
+    {
+        char* mData;
+        size_t mSize;
+    } sChunk;
+
+    std::vector<sChunk> mvChunk;
+    size_t mvCurrent;
+    size_t mvUsed;
+};
+
+/*!
+ * Releases, on destruction, everything allocated from the thread arena
+ * since construction.
+ */
+class cScratchScope
+{
+public:
+    cScratchScope()
+        : mvArena(cScratchArena::Local()), mvMark(mvArena.GetMark())
+    {
+    }
+
+    ~cScratchScope()
+    {
+        mvArena.Release(mvMark);
+    }
+
+    cScratchScope(const cScratchScope&) = delete;
+    cScratchScope& operator=(const cScratchScope&) = delete;
+
+    template<class T>
+    T* Alloc(size_t theN)
+    {
+        return static_cast<T*>(mvArena.AllocBytes(theN * sizeof(T)));
+    }
+
+    /*! Same as Alloc, filled with theVal */
+    template<class T>
+    T* Alloc(size_t theN, const T& theVal)
+    {
+        T* myRes = Alloc<T>(theN);
+        for (size_t i = 0; i < theN; i++)
+            myRes[i] = theVal;
+        return myRes;
+    }
+
+private:
+    cScratchArena& mvArena;
+    cScratchArena::sMark mvMark;
+};
+
+#endif // _CSCRATCHARENA_H_
@@ -0,0 +1,208 @@
+#ifndef _CTHREADPOOL_H_
+#define _CTHREADPOOL_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*!
+ * \file cThreadPool.h
+ * \brief Small fixed-size thread pool used by the wrapper compute helpers.
+ *
+ * Workers are started once and kept alive for the lifetime of the pool, so
+ * objects that own a pool (e.g. cParallelNumericDerivative) can be reused
+ * across calls without paying thread creation again. Every task receives
+ * the index of the worker running it, which lets callers keep one private
+ * workspace per worker.
+ *
+ * The queue can be bounded: Submit() then waits for a free slot, which
+ * gives backpressure to a producer faster than the workers. A task must
+ * not submit to its own bounded pool, it could wait for itself.
+ */
+class cThreadPool
+{
+public:
+    typedef std::function<void(unsigned int)> tTask;
+    typedef std::function<void(unsigned int, unsigned int)> tIndexedTask;
+
+    /*!
+     * \param theNThread number of workers, 0 means std::thread::hardware_concurrency()
+     * \param theMaxQueue most tasks waiting for a worker, 0 means no limit
+     */
+    explicit cThreadPool(unsigned int theNThread = 0, size_t theMaxQueue = 0)
+        : mvMaxQueue(theMaxQueue), mvNRunning(0), mvStop(false)
+    {
+        if (theNThread == 0)
+            theNThread = std::thread::hardware_concurrency();
+        if (theNThread == 0)
+            theNThread = 1;
+        mvWorker.reserve(theNThread);
+        for (unsigned int w = 0; w < theNThread; w++)
+            mvWorker.emplace_back(&cThreadPool::WorkerLoop, this, w);
+    }
+
+    ~cThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> myLock(mvMutex);
+            mvStop = true;
+        }
+        mvCond.notify_all();
+        for (std::thread& myThread : mvWorker)
+            myThread.join();
+    }
+
+    cThreadPool(const cThreadPool&) = delete;
+    cThreadPool& operator=(const cThreadPool&) = delete;
+
+    unsigned int GetNThread(void) const
+    {
+        return (unsigned int)mvWorker.size();
+    }
+
+    size_t GetMaxQueue(void) const
+    {
+        return mvMaxQueue;
+    }
+
+    /*! Number of tasks waiting for a worker */
+    size_t GetNQueued(void)
+    {
+        std::lock_guard<std::mutex> myLock(mvMutex);
+        return mvQueue.size();
+    }
+
+    /*!
+     * \brief Queue a task. The task is called with the index of the worker running it.
+     *
+     * Waits for a free slot if the queue is bounded and full.
+     */
+    void Submit(tTask theTask)
+    {
+        Submit(std::move(theTask), -1.0);
+    }
+
+    /*!
+     * \brief Queue a task, waiting at most theTimeout seconds for a free slot.
+     * \param theTimeout negative: no limit, 0: do not wait
+     * \return false if the queue was still full, theTask is then not queued
+     */
+    bool Submit(tTask theTask, double theTimeout)
+    {
+        {
+            std::unique_lock<std::mutex> myLock(mvMutex);
+            if (mvMaxQueue > 0 && mvQueue.size() >= mvMaxQueue)
+            {
+                std::function<bool()> myHasSlot = [this] { return mvQueue.size() < mvMaxQueue; };
+                if (theTimeout < 0)
+                    mvNotFull.wait(myLock, myHasSlot);
+                else if (!mvNotFull.wait_for(myLock, std::chrono::duration<double>(theTimeout), myHasSlot))
+                    return false;
+            }
+            mvQueue.push_back(std::move(theTask));
+        }
+        mvCond.notify_one();
+        return true;
+    }
+
+    /*! Waits until the queue is empty and no task is running */
+    void WaitIdle(void)
+    {
+        std::unique_lock<std::mutex> myLock(mvMutex);
+        mvIdle.wait(myLock, [this] { return mvQueue.empty() && mvNRunning == 0; });
+    }
+
+    /*!
+     * \brief Run theBody(i, worker) for i in [0, theNTask) and wait for completion.
+     *
+     * Indices are handed out dynamically so that uneven task costs balance
+     * across workers. The first exception thrown by a task is rethrown here
+     * once every worker has stopped.
+     */
+    void ParallelFor(unsigned int theNTask, const tIndexedTask& theBody)
+    {
+        if (theNTask == 0)
+            return;
+
+        std::atomic<unsigned int> myNext(0);
+        std::exception_ptr myError;
+        std::mutex myDoneMutex;
+        std::condition_variable myDoneCond;
+        unsigned int myNRunner = (theNTask < GetNThread()) ? theNTask : GetNThread();
+        unsigned int myNRunning = myNRunner;
+
+        for (unsigned int r = 0; r < myNRunner; r++)
+        {
+            Submit([&](unsigned int theWorker)
+            {
+                unsigned int i;
+                while ((i = myNext.fetch_add(1)) < theNTask)
+                {
+                    try
+                    {
+                        theBody(i, theWorker);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> myLock(myDoneMutex);
+                        if (!myError)
+                            myError = std::current_exception();
+                        myNext = theNTask;
+                    }
+                }
+                std::lock_guard<std::mutex> myLock(myDoneMutex);
+                if (--myNRunning == 0)
+                    myDoneCond.notify_one();
+            });
+        }
+
+        std::unique_lock<std::mutex> myLock(myDoneMutex);
+        myDoneCond.wait(myLock, [&] { return myNRunning == 0; });
+        if (myError)
+            std::rethrow_exception(myError);
+    }
+
+private:
+    void WorkerLoop(unsigned int theWorker)
+    {
+        for (;;)
+        {
+            tTask myTask;
+            {
+                std::unique_lock<std::mutex> myLock(mvMutex);
+                mvCond.wait(myLock, [this] { return mvStop || !mvQueue.empty(); });
+                if (mvStop && mvQueue.empty())
+                    return;
+                myTask = std::move(mvQueue.front());
+                mvQueue.pop_front();
+                mvNRunning++;
+            }
+            mvNotFull.notify_one();
+            myTask(theWorker);
+            myTask = nullptr;
+            {
+                std::lock_guard<std::mutex> myLock(mvMutex);
+                mvNRunning--;
+            }
+            mvIdle.notify_all();
+        }
+    }
+
+    std::vector<std::thread> mvWorker;
+    std::deque<tTask> mvQueue;
+    std::mutex mvMutex;
+    std::condition_variable mvCond;
+    std::condition_variable mvNotFull;
+    std::condition_variable mvIdle;
+    size_t mvMaxQueue;
+    unsigned int mvNRunning;
+    bool mvStop;
+};
+
+#endif // _CTHREADPOOL_H_
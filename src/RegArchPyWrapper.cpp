@@ -6,6 +6,7 @@ using namespace boost::python;
 void export_RegArchDef();
 
 void export_cRegArchValue();
+void export_cPackedRegArchValue();
 
 void export_cAbstCondMean();
 void export_cAbstCondVar();
@@ -47,6 +48,16 @@ void export_cGSLMatrix();
 void export_cRegArchHessien();
 void export_cRegArchGradient();
 
+void export_cParallelNumericDerivative();
+void export_cAutoDiffCondVar();
+void export_cRegArchSandwich();
+void export_cProfile();
+void export_cRegArchModelBank();
+void export_cRegArchPanel();
+void export_cRegArchText();
+void export_cRegArchValueView();
+void export_cRegArchExecutor();
+
 
 
 
@@ -70,6 +81,7 @@ BOOST_PYTHON_MODULE(regarch_wrapper)
     export_cGSLMatrix();
 
     export_cRegArchValue();
+    export_cPackedRegArchValue();
 
     export_cAbstCondMean();
     export_cAbstCondVar();
@@ -104,4 +116,14 @@ BOOST_PYTHON_MODULE(regarch_wrapper)
     export_cRegArchModel();
     export_RegArchCompute();
 
+    export_cParallelNumericDerivative();
+    export_cAutoDiffCondVar();
+    export_cRegArchSandwich();
+    export_cProfile();
+    export_cRegArchModelBank();
+    export_cRegArchPanel();
+    export_cRegArchText();
+    export_cRegArchValueView();
+    export_cRegArchExecutor();
+
 }
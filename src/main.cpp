@@ -1,9 +1,397 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
 #include "StdAfxRegArchLib.h"  // Adjust if needed
+#include "cPackedRegArchValue.h"
 
-int main() {
-    std::cout << "Testing RegArch library...\n";
-    // If there's a function in RegArch you can call, do it here:
-    // e.g. std::cout << "RegArch version: " << RegArchVersion() << std::endl;
+using namespace RegArchLib;
+
+/*!
+ * TestRegArch: benchmark harness for the RegArchLib drivers.
+ *
+ * Times RegArchLLH, RegArchGradLLH, RegArchHessLLH, RegArchSimul, FillValue
+ * and RegArchComputeCov for every variance model x distribution x series
+ * length, and writes one JSON record per case so that runs against
+ * different library releases can be compared. fill_value_packed runs
+ * FillValue on a cPackedRegArchValue, its check is 1 if the value was still
+ * packed afterwards.
+ *
+ * Usage: TestRegArch [--min-time s] [--max-n n] [--filter text] [--out file]
+ *
+ *   --min-time  minimum measured time per case, in seconds (default 0.2)
+ *   --max-n     largest series length (default 1000000)
+ *   --filter    only run the cases whose name contains text, names are
+ *               function/model/distribution/n, e.g. llh/garch/student/1000
+ *   --out       output file (default standard output)
+ */
+
+typedef struct sOptions
+{
+    double mMinTime = 0.2;
+    uint mMaxN = 1000000;
+    std::string mFilter;
+    std::string mOut;
+} sOptions;
+
+typedef struct sResult
+{
+    std::string mName;
+    std::string mFunction;
+    std::string mModel;
+    std::string mDistr;
+    uint mN = 0;
+    uint mIter = 0;
+    double mMeanNs = 0.0;
+    double mMinNs = 0.0;
+    // Scalar summary of the result (llh, norm of the gradient, trace), NaN if none
+    double mCheck = std::numeric_limits<double>::quiet_NaN();
+    std::string mError;
+} sResult;
+
+typedef struct sVarCase
+{
+    const char* mName;
+    cAbstCondVar* (*mCreate)(void);
+} sVarCase;
+
+typedef struct sDistrCase
+{
+    const char* mName;
+    cAbstResiduals* (*mCreate)(void);
+} sDistrCase;
+
+// Orders (1, 1), or 1 for the single-order models. Residuals are created
+// with the simulation flag, RegArchSimul needs their generator.
+static const sVarCase gVarCases[] = {
+    { "cste", []() -> cAbstCondVar* { return new cConstCondVar(1.0); } },
+    { "arch", []() -> cAbstCondVar* { return new cArch(1); } },
+    { "garch", []() -> cAbstCondVar* { return new cGarch(1, 1); } },
+    { "ngarch", []() -> cAbstCondVar* { return new cNgarch(1, 1); } },
+    { "egarch", []() -> cAbstCondVar* { return new cEgarch(1, 1); } },
+    { "aparch", []() -> cAbstCondVar* { return new cAparch(1, 1); } },
+    { "tarch", []() -> cAbstCondVar* { return new cTarch(1); } },
+    { "figarch", []() -> cAbstCondVar* { return new cFigarch(1, 1, 0.3, 20); } },
+    { "ugarch", []() -> cAbstCondVar* { return new cUgarch(true, 0, 1, 1); } },
+    { "tsgarch", []() -> cAbstCondVar* { return new cTsgarch(1, 1); } },
+    { "gtarch", []() -> cAbstCondVar* { return new cGtarch(1, 1); } },
+    { "nagarch", []() -> cAbstCondVar* { return new cNagarch(1, 1); } },
+    { "sqrgarch", []() -> cAbstCondVar* { return new cSqrgarch(1, 1); } },
+};
+
+static const sDistrCase gDistrCases[] = {
+    { "normal", []() -> cAbstResiduals* { return new cNormResiduals(NULL, true); } },
+    { "student", []() -> cAbstResiduals* { return new cStudentResiduals(5.0, true); } },
+    { "ged", []() -> cAbstResiduals* { return new cGedResiduals(1.5, true); } },
+    { "mixnorm", []() -> cAbstResiduals* { return new cMixNormResiduals(0.8, 1.0, 4.0, true); } },
+};
+
+static const uint gSizes[] = { 1000, 10000, 100000, 1000000 };
+
+static bool ParseOptions(int argc, char* argv[], sOptions& theOptions)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string myArg(argv[i]);
+        bool myHasValue = (i + 1 < argc);
+        if (myArg == "--min-time" && myHasValue)
+            theOptions.mMinTime = atof(argv[++i]);
+        else if (myArg == "--max-n" && myHasValue)
+            theOptions.mMaxN = (uint)strtoul(argv[++i], NULL, 10);
+        else if (myArg == "--filter" && myHasValue)
+            theOptions.mFilter = argv[++i];
+        else if (myArg == "--out" && myHasValue)
+            theOptions.mOut = argv[++i];
+        else
+        {
+            std::cerr << "Usage: TestRegArch [--min-time s] [--max-n n] [--filter text] [--out file]\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+/*!
+ * Runs theFunc until theMinTime seconds have been measured. The first call
+ * is a warm-up, unless it already lasts theMinTime (large series): it is
+ * then the only measurement.
+ */
+template<class tFunc>
+static void TimeIt(tFunc theFunc, double theMinTime, sResult& theRes)
+{
+    typedef std::chrono::steady_clock tClock;
+
+    tClock::time_point myStart = tClock::now();
+    theFunc();
+    double myFirst = std::chrono::duration<double>(tClock::now() - myStart).count();
+
+    double myTotal = 0.0, myMin = std::numeric_limits<double>::infinity();
+    uint myIter = 0;
+    if (myFirst >= theMinTime)
+    {
+        myTotal = myMin = myFirst;
+        myIter = 1;
+    }
+    while (myTotal < theMinTime)
+    {
+        myStart = tClock::now();
+        theFunc();
+        double myDt = std::chrono::duration<double>(tClock::now() - myStart).count();
+        myTotal += myDt;
+        if (myDt < myMin)
+            myMin = myDt;
+        myIter++;
+    }
+    theRes.mIter = myIter;
+    theRes.mMeanNs = 1e9 * myTotal / myIter;
+    theRes.mMinNs = 1e9 * myMin;
+}
+
+static double Trace(const cDMatrix& theMat, uint theSize)
+{
+    double myRes = 0.0;
+    for (uint i = 0; i < theSize; i++)
+        myRes += theMat[i][i];
+    return myRes;
+}
+
+static void WriteNumber(std::ostream& theOut, double theX)
+{
+    if (!std::isfinite(theX))
+    {
+        theOut << "null";
+        return;
+    }
+    char myBuf[32];
+    snprintf(myBuf, sizeof(myBuf), "%.17g", theX);
+    theOut << myBuf;
+}
+
+static std::string JsonEscape(const std::string& theStr)
+{
+    std::string myRes;
+    for (char myChar : theStr)
+    {
+        if (myChar == '"' || myChar == '\\')
+        {
+            myRes += '\\';
+            myRes += myChar;
+        }
+        else if ((unsigned char)myChar < 0x20)
+        {
+            // Control characters are not allowed raw in a JSON string
+            char myHex[8];
+            snprintf(myHex, sizeof(myHex), "\\u%04x", (unsigned int)(unsigned char)myChar);
+            myRes += myHex;
+        }
+        else
+            myRes += myChar;
+    }
+    return myRes;
+}
+
+static void WriteJson(std::ostream& theOut, const sOptions& theOptions, const std::vector<sResult>& theResults)
+{
+    char myDate[32];
+    time_t myNow = time(NULL);
+    strftime(myDate, sizeof(myDate), "%Y-%m-%dT%H:%M:%SZ", gmtime(&myNow));
+
+    theOut << "{\n  \"context\": {\n";
+    theOut << "    \"date\": \"" << myDate << "\",\n";
+#if defined(_MSC_VER)
+    theOut << "    \"compiler\": \"msvc " << _MSC_VER << "\",\n";
+#elif defined(__clang__)
+    theOut << "    \"compiler\": \"clang " << __clang_version__ << "\",\n";
+#elif defined(__GNUC__)
+    theOut << "    \"compiler\": \"gcc " << __VERSION__ << "\",\n";
+#else
+    theOut << "    \"compiler\": \"unknown\",\n";
+#endif
+#ifdef NDEBUG
+    theOut << "    \"build_type\": \"release\",\n";
+#else
+    theOut << "    \"build_type\": \"debug\",\n";
+#endif
+    theOut << "    \"min_time_s\": ";
+    WriteNumber(theOut, theOptions.mMinTime);
+    theOut << "\n  },\n  \"benchmarks\": [";
+    for (size_t i = 0; i < theResults.size(); i++)
+    {
+        const sResult& myRes = theResults[i];
+        theOut << (i == 0 ? "\n" : ",\n");
+        theOut << "    {\"name\": \"" << myRes.mName << "\", \"function\": \"" << myRes.mFunction
+            << "\", \"model\": \"" << myRes.mModel << "\", \"distribution\": \"" << myRes.mDistr
+            << "\", \"n\": " << myRes.mN << ", \"iterations\": " << myRes.mIter << ", \"mean_ns\": ";
+        WriteNumber(theOut, myRes.mMeanNs);
+        theOut << ", \"min_ns\": ";
+        WriteNumber(theOut, myRes.mMinNs);
+        theOut << ", \"ns_per_obs\": ";
+        WriteNumber(theOut, myRes.mN > 0 ? myRes.mMeanNs / myRes.mN : 0.0);
+        theOut << ", \"check\": ";
+        WriteNumber(theOut, myRes.mCheck);
+        if (!myRes.mError.empty())
+            theOut << ", \"error\": \"" << JsonEscape(myRes.mError) << "\"";
+        theOut << "}";
+    }
+    theOut << "\n  ]\n}\n";
+}
+
+/*!
+ * All the functions for one model x distribution x length. The parameters
+ * are the default initial point on theRefYt, the data are then simulated
+ * from the model itself.
+ */
+static void RunCase(const sVarCase& theVar, const sDistrCase& theDistr, uint theN, const cDVector& theRefYt,
+    const sOptions& theOptions, std::vector<sResult>& theResults)
+{
+    static const char* myFunctions[] = { "simul", "fill_value", "fill_value_packed", "llh", "grad_llh", "hess_llh", "compute_cov" };
+    const uint myNFunc = sizeof(myFunctions) / sizeof(myFunctions[0]);
+
+    std::vector<sResult> myCase;
+    for (uint f = 0; f < myNFunc; f++)
+    {
+        sResult myRes;
+        myRes.mFunction = myFunctions[f];
+        myRes.mModel = theVar.mName;
+        myRes.mDistr = theDistr.mName;
+        myRes.mN = theN;
+        myRes.mName = myRes.mFunction + "/" + myRes.mModel + "/" + myRes.mDistr + "/" + std::to_string(theN);
+        if (theOptions.mFilter.empty() || myRes.mName.find(theOptions.mFilter) != std::string::npos)
+            myCase.push_back(myRes);
+    }
+    if (myCase.empty())
+        return;
+
+    try
+    {
+        cCondMean myMean;
+        cConst myConst(0.0);
+        myMean.AddOneMean(myConst);
+        std::unique_ptr<cAbstCondVar> myVar(theVar.mCreate());
+        std::unique_ptr<cAbstResiduals> myResids(theDistr.mCreate());
+        cRegArchModel myModel(myMean, *myVar, *myResids);
+
+        cDVector myRefYt(theN);
+        for (uint t = 0; t < theN; t++)
+            myRefYt[t] = theRefYt[t];
+        cRegArchValue myRefValue(&myRefYt);
+        myModel.SetDefaultInitPoint(myRefValue);
+
+        cRegArchValue myValue(theN);
+        RegArchSimul(theN, myModel, myValue);
+        cPackedRegArchValue myPackedValue(myValue.mYt);
+
+        uint myNParam = myModel.GetNParam();
+        cDVector mySimYt(theN);
+        cDVector myGrad(myNParam);
+        cDMatrix myHess(myNParam, myNParam);
+        cDMatrix myCov(myNParam, myNParam);
+
+        for (size_t i = 0; i < myCase.size(); i++)
+        {
+            sResult& myRes = myCase[i];
+            try
+            {
+                if (myRes.mFunction == "simul")
+                    TimeIt([&]() { RegArchSimul(theN, myModel, mySimYt); }, theOptions.mMinTime, myRes);
+                else if (myRes.mFunction == "fill_value")
+                    TimeIt([&]() { FillValue(theN, myModel, myValue); }, theOptions.mMinTime, myRes);
+                else if (myRes.mFunction == "fill_value_packed")
+                {
+                    TimeIt([&]() { FillValue(theN, myModel, myPackedValue); }, theOptions.mMinTime, myRes);
+                    myRes.mCheck = myPackedValue.IsPacked() ? 1.0 : 0.0;
+                }
+                else if (myRes.mFunction == "llh")
+                    TimeIt([&]() { myRes.mCheck = RegArchLLH(myModel, myValue); }, theOptions.mMinTime, myRes);
+                else if (myRes.mFunction == "grad_llh")
+                {
+                    TimeIt([&]() { RegArchGradLLH(myModel, myValue, myGrad); }, theOptions.mMinTime, myRes);
+                    myRes.mCheck = 0.0;
+                    for (uint k = 0; k < myNParam; k++)
+                        myRes.mCheck += myGrad[k] * myGrad[k];
+                    myRes.mCheck = sqrt(myRes.mCheck);
+                }
+                else if (myRes.mFunction == "hess_llh")
+                {
+                    TimeIt([&]() { RegArchHessLLH(myModel, myValue, myHess); }, theOptions.mMinTime, myRes);
+                    myRes.mCheck = Trace(myHess, myNParam);
+                }
+                else if (myRes.mFunction == "compute_cov")
+                {
+                    TimeIt([&]() { RegArchComputeCov(myModel, myValue, myCov); }, theOptions.mMinTime, myRes);
+                    myRes.mCheck = Trace(myCov, myNParam);
+                }
+            }
+            catch (const std::exception& theErr)
+            {
+                myRes.mError = theErr.what();
+            }
+            catch (...)
+            {
+                myRes.mError = "exception";
+            }
+            std::cerr << myRes.mName << ": " << myRes.mMeanNs * 1e-6 << " ms\n";
+        }
+    }
+    catch (...)
+    {
+        for (size_t i = 0; i < myCase.size(); i++)
+            myCase[i].mError = "model setup failed";
+    }
+    theResults.insert(theResults.end(), myCase.begin(), myCase.end());
+}
+
+int main(int argc, char* argv[])
+{
+    sOptions myOptions;
+    if (!ParseOptions(argc, argv, myOptions))
+        return 1;
+
+    std::vector<uint> mySizes;
+    for (uint myN : gSizes)
+        if (myN <= myOptions.mMaxN)
+            mySizes.push_back(myN);
+    if (mySizes.empty())
+        mySizes.push_back(myOptions.mMaxN);
+    uint myMaxN = mySizes.back();
+
+    // Reference data: GARCH(1,1) with normal residuals, used for the initial points
+    cCondMean myRefMean;
+    cConst myRefConst(0.0);
+    myRefMean.AddOneMean(myRefConst);
+    cGarch myRefVar(1, 1);
+    myRefVar.Set(0.05, 0, 0);
+    myRefVar.Set(0.10, 0, 1);
+    myRefVar.Set(0.85, 0, 2);
+    cNormResiduals myRefResids(NULL, true);
+    cRegArchModel myRefModel(myRefMean, myRefVar, myRefResids);
+    cDVector myRefYt(myMaxN);
+    RegArchSimul(myMaxN, myRefModel, myRefYt);
+
+    std::vector<sResult> myResults;
+    for (uint myN : mySizes)
+        for (const sVarCase& myVar : gVarCases)
+            for (const sDistrCase& myDistr : gDistrCases)
+                RunCase(myVar, myDistr, myN, myRefYt, myOptions, myResults);
+
+    if (myOptions.mOut.empty())
+        WriteJson(std::cout, myOptions, myResults);
+    else
+    {
+        std::ofstream myFile(myOptions.mOut.c_str());
+        if (!myFile)
+        {
+            std::cerr << "Cannot open " << myOptions.mOut << "\n";
+            return 1;
+        }
+        WriteJson(myFile, myOptions, myResults);
+    }
     return 0;
 }
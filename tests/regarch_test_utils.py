@@ -0,0 +1,35 @@
+"""Models shared by the tests.
+
+The tests are run from tests/ (python -m unittest discover tests), so this
+module is imported as a top-level module next to regarch_wrapper.
+"""
+import regarch_wrapper
+
+CSTE, ARCH, GARCH = 0.05, 0.10, 0.80
+
+
+def make_const_mean(value=0.1):
+    """cCondMean holding one cConst(value)."""
+    mean = regarch_wrapper.cCondMean()
+    mean.add_one_mean(regarch_wrapper.cConst(value))
+    return mean
+
+
+def make_garch(cls=regarch_wrapper.cGarch):
+    """GARCH(1,1) with CSTE, ARCH, GARCH, built from cls (cGarch or its AD twin)."""
+    var = cls(1, 1)
+    var.set(CSTE, 0, 0)    # constant
+    var.set(ARCH, 0, 1)    # arch
+    var.set(GARCH, 0, 2)   # garch
+    return var
+
+
+def make_garch_model(var=None, resids=None, mean=None):
+    """Const mean + GARCH(1,1) variance + normal residuals, each part can be replaced."""
+    if mean is None:
+        mean = make_const_mean()
+    if var is None:
+        var = make_garch()
+    if resids is None:
+        resids = regarch_wrapper.cNormResiduals()
+    return regarch_wrapper.cRegArchModel(mean, var, resids)
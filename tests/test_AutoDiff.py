@@ -0,0 +1,75 @@
+import pickle
+import unittest
+import regarch_wrapper
+from regarch_test_utils import make_garch, make_garch_model
+
+
+def tarch(cls):
+    var = cls(1)
+    var.SetValueIndex(0.05, 0, 0)   # constant
+    var.SetValueIndex(0.05, 0, 1)   # arch, u > 0
+    var.SetValueIndex(0.20, 0, 2)   # arch, u <= 0
+    return var
+
+
+class TestAutoDiff(unittest.TestCase):
+
+    def check_same_derivatives(self, ref_var, ad_var):
+        ref_model = make_garch_model(ref_var)
+        ad_model = make_garch_model(ad_var)
+
+        yt = [0.0] * 1000
+        regarch_wrapper.RegArchSimul(1000, ref_model, yt)
+        value = regarch_wrapper.cRegArchValue(yt)
+        n_param = ref_model.get_n_param()
+
+        self.assertAlmostEqual(regarch_wrapper.RegArchLLH_from_value(ref_model, value),
+                               regarch_wrapper.RegArchLLH_from_value(ad_model, value), places=10)
+
+        grad_ref = regarch_wrapper.cGSLVector(n_param)
+        grad_ad = regarch_wrapper.cGSLVector(n_param)
+        regarch_wrapper.RegArchGradLLH(ref_model, value, grad_ref)
+        regarch_wrapper.RegArchGradLLH(ad_model, value, grad_ad)
+        for i in range(n_param):
+            self.assertAlmostEqual(grad_ad[i], grad_ref[i], delta=1e-8 * max(1.0, abs(grad_ref[i])))
+
+        hess_ref = regarch_wrapper.cGSLMatrix(n_param, n_param)
+        hess_ad = regarch_wrapper.cGSLMatrix(n_param, n_param)
+        regarch_wrapper.RegArchHessLLH(ref_model, value, hess_ref)
+        regarch_wrapper.RegArchHessLLH(ad_model, value, hess_ad)
+        for i in range(n_param):
+            for j in range(n_param):
+                ref = hess_ref.get(i, j)
+                self.assertAlmostEqual(hess_ad.get(i, j), ref, delta=1e-8 * max(1.0, abs(ref)))
+
+    def test_garch(self):
+        """AD GARCH(1,1) reproduces the hand-written cGarch derivatives."""
+        self.check_same_derivatives(make_garch(regarch_wrapper.cGarch), make_garch(regarch_wrapper.cAutoDiffGarch))
+
+    def test_tarch(self):
+        """AD TARCH(1) reproduces the hand-written cTarch derivatives."""
+        self.check_same_derivatives(tarch(regarch_wrapper.cTarch), tarch(regarch_wrapper.cAutoDiffTarch))
+
+    def test_copies_keep_the_ad_class(self):
+        """Models and set_var copy the variance: the copy is still the AD model."""
+        model = make_garch_model(make_garch(regarch_wrapper.cAutoDiffGarch))
+        self.assertIsInstance(model.get_var(), regarch_wrapper.cAutoDiffGarch)
+        self.assertIsInstance(regarch_wrapper.cRegArchModel(model).get_var(), regarch_wrapper.cAutoDiffGarch)
+        model.set_var(tarch(regarch_wrapper.cAutoDiffTarch))
+        self.assertIsInstance(model.get_var(), regarch_wrapper.cAutoDiffTarch)
+
+    def test_pickle_keeps_the_ad_class(self):
+        """Pickled AD models and components come back as the AD class, with their parameters."""
+        var = pickle.loads(pickle.dumps(make_garch(regarch_wrapper.cAutoDiffGarch)))
+        self.assertIsInstance(var, regarch_wrapper.cAutoDiffGarch)
+        self.assertEqual(var.get_n_param(), 3)
+        model = make_garch_model(tarch(regarch_wrapper.cAutoDiffTarch))
+        copy = pickle.loads(pickle.dumps(model))
+        self.assertIsInstance(copy.get_var(), regarch_wrapper.cAutoDiffTarch)
+        self.assertEqual(copy.to_param_vector(), model.to_param_vector())
+        plain = pickle.loads(pickle.dumps(make_garch()))
+        self.assertNotIsInstance(plain, regarch_wrapper.cAutoDiffGarch)
+
+
+if __name__ == '__main__':
+    unittest.main()
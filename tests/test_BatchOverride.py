@@ -0,0 +1,116 @@
+import unittest
+import regarch_wrapper
+from regarch_test_utils import ARCH, CSTE, GARCH, make_garch_model
+
+
+class PyGarch(regarch_wrapper.cAbstCondVar):
+    """GARCH(1,1) written in Python, per date and as a series."""
+
+    def __init__(self, batched):
+        regarch_wrapper.cAbstCondVar.__init__(self, regarch_wrapper.eCondVarEnum.eGarch)
+        self.n_date_calls = 0
+        self.n_series_calls = 0
+        if not batched:
+            self.compute_var_series = None
+
+    def get_n_param(self):
+        return 3
+
+    def get_n_lags(self):
+        return 1
+
+    def compute_var(self, date, data):
+        self.n_date_calls += 1
+        h = CSTE
+        if date > 0:
+            h += ARCH * data.mUt[date - 1] ** 2 + GARCH * data.mHt[date - 1]
+        return h
+
+    def compute_var_series(self, data, start, end):
+        self.n_series_calls += 1
+        ut = data.ut_view
+        ht = data.ht_view
+        for t in range(start, end):
+            ht[t] = CSTE if t == 0 else CSTE + ARCH * ut[t - 1] ** 2 + GARCH * ht[t - 1]
+
+
+class PyConst(regarch_wrapper.cAbstCondMean):
+    """Constant mean written in Python, with the series override."""
+
+    def __init__(self, value):
+        regarch_wrapper.cAbstCondMean.__init__(self, regarch_wrapper.eCondMeanEnum.eConst)
+        self.value = value
+
+    def get_n_param(self):
+        return 1
+
+    def get_n_lags(self):
+        return 0
+
+    def compute_mean(self, date, data):
+        return self.value
+
+    def compute_mean_series(self, data, start, end):
+        return [self.value] * (end - start)
+
+
+def make_egarch():
+    """EGARCH(1,1): h(t) reads eps(t-1)."""
+    var = regarch_wrapper.cEgarch(regarch_wrapper.cNormResiduals(), 1, 1)
+    var.set(-0.05, 0, 0)
+    var.set(0.20, 0, 1)
+    var.set(0.95, 0, 2)
+    var.set(-0.30, 0, 3)
+    var.set(1.00, 0, 4)
+    return var
+
+
+class TestBatchOverride(unittest.TestCase):
+
+    def setUp(self):
+        self.ref_model = make_garch_model()
+        yt = [0.0] * 500
+        regarch_wrapper.RegArchSimul(500, self.ref_model, yt)
+        self.yt = yt
+
+    def test_views_share_memory(self):
+        value = regarch_wrapper.cRegArchValue(self.yt)
+        view = value.yt_view
+        self.assertEqual(len(view), 500)
+        view[3] = 42.0
+        self.assertEqual(value.mYt[3], 42.0)
+
+    def test_series_hook_is_used_once(self):
+        """The series override replaces the per-date calls and gives the same likelihood."""
+        llh_ref = regarch_wrapper.RegArchLLH_from_value(self.ref_model, regarch_wrapper.cRegArchValue(self.yt))
+
+        var = PyGarch(batched=True)
+        llh = regarch_wrapper.RegArchLLH_from_value(make_garch_model(var), regarch_wrapper.cRegArchValue(self.yt))
+        self.assertAlmostEqual(llh, llh_ref, places=8)
+        self.assertEqual(var.n_series_calls, 1)
+        self.assertEqual(var.n_date_calls, 0)
+
+    def test_per_date_fallback(self):
+        """Without the series override the per-date compute_var is still used."""
+        var = PyGarch(batched=False)
+        regarch_wrapper.RegArchLLH_from_value(make_garch_model(var), regarch_wrapper.cRegArchValue(self.yt))
+        self.assertEqual(var.n_series_calls, 0)
+        self.assertGreaterEqual(var.n_date_calls, 500)
+
+    def test_mean_series_with_lagged_eps(self):
+        """A mean series override next to a C++ EGARCH gives the per-date likelihood."""
+        ref_model = make_garch_model(make_egarch())
+        yt = [0.0] * 500
+        regarch_wrapper.RegArchSimul(500, ref_model, yt)
+        value = regarch_wrapper.cRegArchValue(yt)
+        llh_ref = regarch_wrapper.RegArchLLH(ref_model, value.mYt, None)
+
+        mean = regarch_wrapper.cCondMean()
+        mean.add_one_mean(PyConst(0.1))
+        model = make_garch_model(make_egarch(), mean=mean)
+        llh = regarch_wrapper.RegArchLLH_from_value(model, regarch_wrapper.cRegArchValue(yt))
+        self.assertAlmostEqual(llh, llh_ref, places=8)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,143 @@
+import asyncio
+import concurrent.futures
+import queue
+import threading
+import unittest
+
+import regarch_wrapper
+from regarch_test_utils import make_garch, make_garch_model
+
+
+class GatedGarch(regarch_wrapper.cAbstCondVar):
+    """GARCH(1,1) in Python whose first variance waits for a gate, to hold a worker."""
+
+    def __init__(self, started, gate):
+        regarch_wrapper.cAbstCondVar.__init__(self, regarch_wrapper.eCondVarEnum.eGarch)
+        self.started = started
+        self.gate = gate
+
+    def get_n_param(self):
+        return 3
+
+    def get_n_lags(self):
+        return 1
+
+    def compute_var(self, date, data):
+        if date == 0:
+            self.started.set()
+            self.gate.wait(10.0)
+        h = 0.05
+        if date > 0:
+            h += 0.10 * data.mUt[date - 1] ** 2 + 0.80 * data.mHt[date - 1]
+        return h
+
+
+class TestExecutor(unittest.TestCase):
+
+    def setUp(self):
+        self.model = make_garch_model()
+        yt = [0.0] * 500
+        regarch_wrapper.RegArchSimul(500, self.model, yt)
+        self.value = regarch_wrapper.cRegArchValue(yt)
+        self.n_param = self.model.get_n_param()
+
+    def gated_model(self):
+        started, gate = threading.Event(), threading.Event()
+        model = make_garch_model(GatedGarch(started, gate))
+        return model, started, gate
+
+    def test_results_match_direct_calls(self):
+        with regarch_wrapper.cRegArchExecutor(2) as executor:
+            llh = executor.submit_llh(self.model, self.value)
+            cov = executor.submit_cov(self.model, self.value)
+            sandwich = executor.submit_sandwich(self.model, self.value)
+            simul = executor.submit_simul(300, self.model)
+            self.assertIsInstance(llh, concurrent.futures.Future)
+
+            self.assertAlmostEqual(llh.result(10), regarch_wrapper.RegArchLLH_from_value(self.model, self.value),
+                                   places=8)
+            cov_ref = regarch_wrapper.cGSLMatrix(self.n_param, self.n_param)
+            regarch_wrapper.RegArchComputeCov(self.model, self.value, cov_ref)
+            for i in range(self.n_param):
+                for j in range(self.n_param):
+                    self.assertAlmostEqual(cov.result(10).get(i, j), cov_ref.get(i, j), places=10)
+            self.assertAlmostEqual(sandwich.result(10).llh, llh.result(), places=6)
+            self.assertEqual(simul.result(10).mYt.GetSize(), 300)
+
+    def test_awaitable(self):
+        executor = regarch_wrapper.cRegArchExecutor(2)
+
+        async def run():
+            return await asyncio.gather(executor.submit_llh(self.model, self.value),
+                                        executor.submit_llh(self.model, self.value))
+
+        first, second = asyncio.run(run())
+        self.assertEqual(first, second)
+        executor.shutdown()
+
+    def test_cancel_and_backpressure(self):
+        model, started, gate = self.gated_model()
+        executor = regarch_wrapper.cRegArchExecutor(1, max_queue=1)
+        running = executor.submit_llh(model, self.value)
+        self.assertTrue(started.wait(10.0))
+        queued = executor.submit_llh(self.model, self.value)
+        self.assertEqual(executor.n_queued, 1)
+        with self.assertRaises(queue.Full):
+            executor.submit_llh(self.model, self.value, block=False)
+        with self.assertRaises(queue.Full):
+            executor.submit_llh(self.model, self.value, timeout=0.05)
+
+        self.assertFalse(running.cancel())
+        self.assertTrue(queued.cancel())
+        gate.set()
+        self.assertTrue(queued.cancelled())
+        self.assertIsInstance(running.result(10), float)
+        executor.shutdown()
+
+    def test_llh_releases_the_gil(self):
+        """The main thread keeps running while a pure C++ LLH job computes."""
+        yt = [0.0] * 200000
+        regarch_wrapper.RegArchSimul(len(yt), self.model, yt)
+        value = regarch_wrapper.cRegArchValue(yt)
+        with regarch_wrapper.cRegArchExecutor(1) as executor:
+            future = executor.submit_llh(self.model, value)
+            n_seen_running = 0
+            while not future.done():
+                if future.running():
+                    n_seen_running += 1
+            future.result(10)
+        # A job holding the GIL is seen running only between two Python calls
+        self.assertGreater(n_seen_running, 100)
+
+    def test_model_copied_at_submission(self):
+        """A C++ model changed while its job is queued: the job runs the model as submitted."""
+        llh_ref = regarch_wrapper.RegArchLLH_from_value(self.model, self.value)
+        gated, started, gate = self.gated_model()
+        executor = regarch_wrapper.cRegArchExecutor(1)
+        executor.submit_llh(gated, self.value)
+        self.assertTrue(started.wait(10.0))
+        queued = executor.submit_llh(self.model, self.value)
+        var = make_garch()
+        var.set(0.50, 0, 2)
+        self.model.set_var(var)
+        gate.set()
+        self.assertAlmostEqual(queued.result(10), llh_ref, places=10)
+        executor.shutdown()
+
+    def test_shutdown(self):
+        model, started, gate = self.gated_model()
+        executor = regarch_wrapper.cRegArchExecutor(1)
+        running = executor.submit_llh(model, self.value)
+        self.assertTrue(started.wait(10.0))
+        pending = [executor.submit_llh(self.model, self.value) for _ in range(3)]
+        executor.shutdown(wait=False, cancel_futures=True)
+        self.assertTrue(all(f.cancelled() for f in pending))
+        with self.assertRaises(RuntimeError):
+            executor.submit_llh(self.model, self.value)
+        gate.set()
+        executor.shutdown()
+        self.assertTrue(running.done())
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,67 @@
+import unittest
+
+import regarch_wrapper
+from regarch_test_utils import make_garch_model
+
+try:
+    import numpy as np
+except ImportError:
+    np = None
+
+
+class TestLtSeries(unittest.TestCase):
+    """RegArchLtSeries: l(t) and its gradient for every date in one call."""
+
+    def setUp(self):
+        self.model = make_garch_model()
+        yt = [0.0] * 500
+        regarch_wrapper.RegArchSimul(500, self.model, yt)
+        self.value = regarch_wrapper.cRegArchValue(yt)
+        self.n_param = self.model.get_n_param()
+
+    def test_sum_is_llh(self):
+        lt = regarch_wrapper.RegArchLtSeries(self.model, self.value)
+        self.assertEqual(len(lt), 500)
+        llh = regarch_wrapper.RegArchLLH_from_value(self.model, self.value)
+        self.assertAlmostEqual(sum(lt), llh, places=6)
+
+    def test_score_sums_to_gradient(self):
+        lt, score = regarch_wrapper.RegArchLtSeries(self.model, self.value, score=True)
+        grad = regarch_wrapper.cGSLVector(self.n_param)
+        regarch_wrapper.RegArchGradLLH(self.model, self.value, grad)
+        self.assertEqual(len(score), 500)
+        for j in range(self.n_param):
+            self.assertAlmostEqual(sum(score[t, j] for t in range(500)), grad[j], places=6)
+        llh = regarch_wrapper.RegArchLLH_from_value(self.model, self.value)
+        self.assertAlmostEqual(sum(lt), llh, places=6)
+
+    @unittest.skipIf(np is None, "numpy not installed")
+    def test_preallocated(self):
+        lt = np.full(500, np.nan)
+        score = np.full((500, self.n_param), np.nan)
+        res_lt, res_score = regarch_wrapper.RegArchLtSeries(self.model, self.value, lt, score)
+        self.assertIs(res_lt, lt)
+        self.assertIs(res_score, score)
+        self.assertFalse(np.isnan(lt).any())
+        self.assertFalse(np.isnan(score).any())
+        # strided l(t), e.g. one column of a larger table
+        table = np.zeros((500, 2))
+        regarch_wrapper.RegArchLtSeries(self.model, self.value, table[:, 1])
+        np.testing.assert_allclose(table[:, 1], lt, rtol=1e-12)
+
+    @unittest.skipIf(np is None, "numpy not installed")
+    def test_errors(self):
+        with self.assertRaises(ValueError):
+            regarch_wrapper.RegArchLtSeries(self.model, self.value, np.zeros(499))
+        with self.assertRaises(ValueError):
+            regarch_wrapper.RegArchLtSeries(self.model, self.value, np.zeros(500, dtype=np.float32))
+        with self.assertRaises(ValueError):
+            regarch_wrapper.RegArchLtSeries(self.model, self.value, score=np.zeros((500, self.n_param + 1)))
+        with self.assertRaises(ValueError):
+            regarch_wrapper.RegArchLtSeries(self.model, self.value, score=np.zeros((self.n_param, 500)).T)
+        with self.assertRaises(TypeError):
+            regarch_wrapper.RegArchLtSeries(self.model, self.value, (0.0,) * 500)
+
+
+if __name__ == "__main__":
+    unittest.main()
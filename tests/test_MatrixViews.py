@@ -0,0 +1,72 @@
+import unittest
+
+import regarch_wrapper
+
+try:
+    import numpy as np
+except ImportError:
+    np = None
+
+
+class TestMatrixViews(unittest.TestCase):
+
+    def setUp(self):
+        self.mat = regarch_wrapper.cGSLMatrix(4, 3)
+        self.mat.set_rows([[10.0 * r + c for c in range(3)] for r in range(4)])
+
+    def test_rows_and_elements(self):
+        self.assertEqual(len(self.mat), 4)
+        self.assertEqual(self.mat[2][1], 21.0)
+        self.mat[2][1] = -1.0
+        self.assertEqual(self.mat.get(2, 1), -1.0)
+        self.assertEqual(list(self.mat.row(3)), [30.0, 31.0, 32.0])
+        with self.assertRaises(IndexError):
+            self.mat[4]
+        self.assertEqual(len(list(self.mat)), 4)
+
+    def test_bulk(self):
+        self.assertEqual(self.mat.to_list()[1], [10.0, 11.0, 12.0])
+        self.mat.set_rows([[7.0, 8.0, 9.0]], 3)
+        self.assertEqual(self.mat.get(3, 2), 9.0)
+        self.mat.set_col(0, [1.0, 2.0, 3.0, 4.0])
+        self.assertEqual(self.mat.get(3, 0), 4.0)
+        with self.assertRaises(IndexError):
+            self.mat.set_rows([[0.0, 0.0, 0.0]], 4)
+
+    def test_vector(self):
+        vect = regarch_wrapper.cGSLVector(5)
+        vect.assign([1.0, 2.0], 3)
+        self.assertEqual(vect.to_list(), [0.0, 0.0, 0.0, 1.0, 2.0])
+        self.assertEqual(len(vect), 5)
+        view = memoryview(vect)
+        self.assertEqual(view.format, "d")
+        self.assertEqual(view.shape, (5,))
+        view[0] = 4.0
+        self.assertEqual(vect[0], 4.0)
+
+    def test_matrix_buffer(self):
+        view = memoryview(self.mat)
+        self.assertEqual(view.shape, (4, 3))
+        self.assertEqual(view.tolist()[3], [30.0, 31.0, 32.0])
+
+    @unittest.skipIf(np is None, "numpy not installed")
+    def test_numpy_views(self):
+        arr = np.asarray(self.mat)
+        self.assertEqual(arr.shape, (4, 3))
+        arr[0, 0] = 5.0
+        self.assertEqual(self.mat.get(0, 0), 5.0)
+        col = self.mat.col(2)
+        self.assertEqual(list(col), [2.0, 12.0, 22.0, 32.0])
+        col[1] = -3.0
+        self.assertEqual(self.mat.get(1, 2), -3.0)
+        self.assertEqual(self.mat.rows(1, 3).shape, (2, 3))
+        self.mat.set_rows(np.ones((2, 3)), 2)
+        self.assertEqual(self.mat.get(3, 1), 1.0)
+
+    def test_view_keeps_matrix_alive(self):
+        row = regarch_wrapper.cGSLMatrix(2, 2, 3.0).row(1)
+        self.assertEqual(row[0], 3.0)
+
+
+if __name__ == '__main__':
+    unittest.main()
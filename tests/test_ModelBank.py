@@ -0,0 +1,73 @@
+import os
+import tempfile
+import threading
+import unittest
+
+import regarch_wrapper
+from regarch_test_utils import GARCH, make_const_mean, make_garch, make_garch_model
+
+
+def make_model(k):
+    var = make_garch()
+    var.set(GARCH - 0.001 * k, 0, 2)
+    resid = regarch_wrapper.cStudentResiduals(5.0 + k) if k % 2 else None
+    return make_garch_model(var, resid, make_const_mean(0.01 * k))
+
+
+class TestModelBank(unittest.TestCase):
+
+    def setUp(self):
+        self.models = [make_model(k) for k in range(50)]
+        handle, self.path = tempfile.mkstemp(suffix=".ramb")
+        os.close(handle)
+        regarch_wrapper.save_model_bank(self.path, self.models)
+
+    def tearDown(self):
+        os.remove(self.path)
+
+    def test_load_all(self):
+        loaded = regarch_wrapper.load_model_bank(self.path)
+        self.assertEqual(len(loaded), len(self.models))
+        for ref, model in zip(self.models, loaded):
+            self.assertEqual(model.get_n_param(), ref.get_n_param())
+            self.assertEqual(model.to_param_vector(), ref.to_param_vector())
+
+    def test_random_access(self):
+        bank = regarch_wrapper.cRegArchModelBank(self.path)
+        self.assertEqual(len(bank), 50)
+        self.assertEqual(bank.get(17).to_param_vector(), self.models[17].to_param_vector())
+        self.assertEqual(len(bank.load_all(n_thread=1)), 50)
+        with self.assertRaises(IndexError):
+            bank.get(50)
+        bank.close()
+
+    def test_close_during_load_all(self):
+        """close() while load_all decodes in another thread: the load keeps its mapping."""
+        bank = regarch_wrapper.cRegArchModelBank(self.path)
+        loaded = []
+        worker = threading.Thread(target=lambda: loaded.append(bank.load_all(n_thread=2)))
+        worker.start()
+        bank.close()
+        worker.join()
+        self.assertEqual(len(bank), 0)
+        self.assertIn(len(loaded[0]), (0, 50))
+        for ref, model in zip(self.models, loaded[0]):
+            self.assertEqual(model.to_param_vector(), ref.to_param_vector())
+
+    def test_same_likelihood(self):
+        yt = [0.0] * 300
+        regarch_wrapper.RegArchSimul(300, self.models[3], yt)
+        loaded = regarch_wrapper.load_model_bank(self.path)
+        llh = regarch_wrapper.RegArchLLH_from_value(loaded[3], regarch_wrapper.cRegArchValue(yt))
+        llh_ref = regarch_wrapper.RegArchLLH_from_value(self.models[3], regarch_wrapper.cRegArchValue(yt))
+        self.assertEqual(llh, llh_ref)
+
+    def test_bad_file(self):
+        with open(self.path, "r+b") as f:
+            f.truncate(40)
+        with self.assertRaises(RuntimeError):
+            regarch_wrapper.load_model_bank(self.path)
+
+
+if __name__ == '__main__':
+    unittest.main()
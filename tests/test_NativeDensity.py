@@ -0,0 +1,116 @@
+import ctypes
+import math
+import unittest
+import regarch_wrapper
+from regarch_test_utils import make_garch_model
+
+LOG_SQRT_2PI = 0.5 * math.log(2.0 * math.pi)
+
+SCALAR = ctypes.CFUNCTYPE(ctypes.c_double, ctypes.c_double)
+ARRAY = ctypes.CFUNCTYPE(None, ctypes.POINTER(ctypes.c_double), ctypes.POINTER(ctypes.c_double), ctypes.c_size_t)
+
+
+@SCALAR
+def norm_log_density(x):
+    return -LOG_SQRT_2PI - 0.5 * x * x
+
+
+@ARRAY
+def norm_log_density_array(x, res, n):
+    for i in range(n):
+        res[i] = -LOG_SQRT_2PI - 0.5 * x[i] * x[i]
+
+
+@SCALAR
+def norm_diff_log_density(x):
+    return -x
+
+
+class PyNorm(regarch_wrapper.cAbstResiduals):
+    """Gaussian residuals written in Python, the density may be replaced by a callback."""
+
+    def __init__(self):
+        regarch_wrapper.cAbstResiduals.__init__(self, regarch_wrapper.eDistrTypeEnum.eNormal)
+        self.n_calls = 0
+
+    def get_n_param(self):
+        return 0
+
+    def log_density(self, x):
+        self.n_calls += 1
+        return -LOG_SQRT_2PI - 0.5 * x * x
+
+    def diff_log_density(self, x):
+        self.n_calls += 1
+        return -x
+
+
+def make_egarch_model(resids):
+    """EGARCH(1,1): h(t) reads eps(t-1)."""
+    var = regarch_wrapper.cEgarch(regarch_wrapper.cNormResiduals(), 1, 1)
+    var.set(-0.05, 0, 0)
+    var.set(0.20, 0, 1)
+    var.set(0.95, 0, 2)
+    var.set(-0.30, 0, 3)
+    var.set(1.00, 0, 4)
+    return make_garch_model(var, resids)
+
+
+class TestNativeDensity(unittest.TestCase):
+
+    def setUp(self):
+        self.ref_model = make_garch_model()
+        yt = [0.0] * 500
+        regarch_wrapper.RegArchSimul(500, self.ref_model, yt)
+        self.yt = yt
+        self.llh_ref = regarch_wrapper.RegArchLLH_from_value(self.ref_model, regarch_wrapper.cRegArchValue(yt))
+
+    def test_scalar_callback(self):
+        resids = PyNorm()
+        resids.set_native_density(regarch_wrapper.eNativeDensityEnum.eNativeLogDensity, norm_log_density)
+        self.assertTrue(resids.has_native_density(regarch_wrapper.eNativeDensityEnum.eNativeLogDensity))
+        llh = regarch_wrapper.RegArchLLH_from_value(make_garch_model(resids=resids), regarch_wrapper.cRegArchValue(self.yt))
+        self.assertAlmostEqual(llh, self.llh_ref, places=8)
+        self.assertEqual(resids.n_calls, 0)
+
+    def test_array_callback_by_address(self):
+        resids = PyNorm()
+        address = ctypes.cast(norm_log_density_array, ctypes.c_void_p).value
+        resids.set_native_density(regarch_wrapper.eNativeDensityEnum.eNativeLogDensity, address, array=True)
+        llh = regarch_wrapper.RegArchLLH_from_value(make_garch_model(resids=resids), regarch_wrapper.cRegArchValue(self.yt))
+        self.assertAlmostEqual(llh, self.llh_ref, places=8)
+        self.assertEqual(resids.n_calls, 0)
+
+    def test_diff_callback(self):
+        resids = PyNorm()
+        kind = regarch_wrapper.eNativeDensityEnum.eNativeDiffLogDensity
+        resids.set_native_density(kind, norm_diff_log_density)
+        self.assertTrue(resids.has_native_density(kind))
+        self.assertFalse(resids.has_native_density(regarch_wrapper.eNativeDensityEnum.eNativeLogDensity))
+
+    def test_unregister(self):
+        resids = PyNorm()
+        kind = regarch_wrapper.eNativeDensityEnum.eNativeLogDensity
+        resids.set_native_density(kind, norm_log_density)
+        resids.set_native_density(kind, None)
+        self.assertFalse(resids.has_native_density(kind))
+        regarch_wrapper.RegArchLLH_from_value(make_garch_model(resids=resids), regarch_wrapper.cRegArchValue(self.yt))
+        self.assertGreaterEqual(resids.n_calls, 500)
+
+    def test_egarch_with_native_density(self):
+        """Only the density is batched: the C++ EGARCH still sees eps(t-1)."""
+        ref_model = make_egarch_model(regarch_wrapper.cNormResiduals())
+        yt = [0.0] * 500
+        regarch_wrapper.RegArchSimul(500, ref_model, yt)
+        value = regarch_wrapper.cRegArchValue(yt)
+        llh_ref = regarch_wrapper.RegArchLLH(ref_model, value.mYt, None)
+
+        resids = PyNorm()
+        resids.set_native_density(regarch_wrapper.eNativeDensityEnum.eNativeLogDensity, norm_log_density)
+        llh = regarch_wrapper.RegArchLLH_from_value(make_egarch_model(resids), regarch_wrapper.cRegArchValue(yt))
+        self.assertAlmostEqual(llh, llh_ref, places=8)
+        self.assertEqual(resids.n_calls, 0)
+
+
+if __name__ == '__main__':
+    unittest.main()
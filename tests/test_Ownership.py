@@ -0,0 +1,63 @@
+import sys
+import unittest
+
+import regarch_wrapper
+
+try:
+    import resource
+except ImportError:
+    resource = None
+
+
+def peak_rss_mb():
+    # ru_maxrss is in kB on Linux, in bytes on macOS
+    rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    return rss / (1024.0 * 1024.0) if sys.platform == "darwin" else rss / 1024.0
+
+
+class TestOwnership(unittest.TestCase):
+
+    def test_adopt(self):
+        yt = regarch_wrapper.cGSLVector(50, 1.5)
+        xt = regarch_wrapper.cGSLMatrix(50, 2)
+        xt.set(3, 1, 7.0)
+        value = regarch_wrapper.cRegArchValue.adopt(yt, xt)
+        self.assertEqual(value.mYt.GetSize(), 50)
+        self.assertEqual(value.mYt[49], 1.5)
+        self.assertEqual(value.mMt.GetSize(), 50)
+        self.assertEqual(value.mXt.get(3, 1), 7.0)
+        self.assertEqual(yt.GetSize(), 0)
+        self.assertEqual(xt.GetNRow(), 0)
+
+    def test_adopt_bad_regressors(self):
+        with self.assertRaises(RuntimeError):
+            regarch_wrapper.cRegArchValue.adopt(regarch_wrapper.cGSLVector(10), regarch_wrapper.cGSLMatrix(9, 1))
+
+    def test_moved_results(self):
+        vect = regarch_wrapper.cGSLVector(4, -2.0)
+        self.assertEqual(regarch_wrapper.Abs(vect)[3], 2.0)
+        self.assertEqual(regarch_wrapper.AddDoubleRight(vect, 1.0)[0], -1.0)
+        self.assertEqual(vect[0], -2.0)
+        mat = regarch_wrapper.cGSLMatrix(2, 3)
+        mat.set(0, 2, -4.0)
+        transposed = regarch_wrapper.Transpose(mat)
+        self.assertEqual((transposed.GetNRow(), transposed.GetNCol()), (3, 2))
+        self.assertEqual(transposed.get(2, 0), -4.0)
+        self.assertEqual(regarch_wrapper.Abs(mat).get(0, 2), 4.0)
+
+    @unittest.skipIf(resource is None, "needs the resource module")
+    def test_soak_construction(self):
+        yt = [0.001 * t for t in range(500)]
+        # Warm-up: allocator pools, converters
+        for _ in range(20000):
+            regarch_wrapper.cRegArchValue(yt)
+        before = peak_rss_mb()
+        for _ in range(200000):
+            regarch_wrapper.cRegArchValue(yt)
+            regarch_wrapper.CreateStudentResidualsFromVector([5.0], False)
+        # A leaked copy of yt per construction would be 800 MB
+        self.assertLess(peak_rss_mb() - before, 50.0)
+
+
+if __name__ == '__main__':
+    unittest.main()
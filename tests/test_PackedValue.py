@@ -0,0 +1,39 @@
+import unittest
+import regarch_wrapper
+from regarch_test_utils import make_garch_model
+
+N = 500
+
+
+class TestPackedValue(unittest.TestCase):
+
+    def setUp(self):
+        self.model = make_garch_model()
+        yt = [0.0] * N
+        regarch_wrapper.RegArchSimul(N, self.model, yt)
+        self.yt = yt
+
+    def test_same_likelihood(self):
+        value = regarch_wrapper.cRegArchValue(self.yt)
+        packed = regarch_wrapper.cPackedRegArchValue(self.yt)
+        self.assertTrue(packed.is_packed)
+        self.assertGreaterEqual(packed.arena_size, 5 * N * 8)
+        llh_ref = regarch_wrapper.RegArchLLH_from_value(self.model, value)
+        llh = regarch_wrapper.RegArchLLH_from_value(self.model, packed)
+        self.assertAlmostEqual(llh, llh_ref, places=10)
+        self.assertAlmostEqual(packed.mHt[N - 1], value.mHt[N - 1], places=12)
+
+    def test_realloc_and_pack(self):
+        packed = regarch_wrapper.cPackedRegArchValue(self.yt)
+        packed.ReAlloc(N)
+        self.assertTrue(packed.is_packed)
+        self.assertEqual(packed.mYt[3], 0.0)
+        packed.ReAlloc(2 * N)
+        self.assertTrue(packed.is_packed)
+        self.assertEqual(packed.mYt.GetSize(), 2 * N)
+        packed.pack()
+        self.assertTrue(packed.is_packed)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,73 @@
+import os
+import tempfile
+import unittest
+
+import regarch_wrapper
+from regarch_test_utils import make_garch_model
+
+N = 400
+
+
+class TestPanel(unittest.TestCase):
+
+    def setUp(self):
+        self.model = make_garch_model()
+        self.series = []
+        for k in range(3):
+            yt = [0.0] * (N + 10 * k)
+            regarch_wrapper.RegArchSimul(len(yt), self.model, yt)
+            self.series.append(yt)
+        self.xt = [[float(t), 1.0] for t in range(N)]
+        handle, self.path = tempfile.mkstemp(suffix=".rapn")
+        os.close(handle)
+        regarch_wrapper.write_panel(self.path, self.series, names=["a", "b", "c"],
+                                    xt=[self.xt, None, None])
+
+    def tearDown(self):
+        os.remove(self.path)
+
+    def test_columns(self):
+        panel = regarch_wrapper.cRegArchPanel(self.path)
+        self.assertEqual(len(panel), 3)
+        self.assertEqual(panel.names, ["a", "b", "c"])
+        self.assertEqual(panel.find("b"), 1)
+        self.assertEqual(panel.find("z"), -1)
+        self.assertEqual(panel.n_date("c"), N + 20)
+        with self.assertRaises(KeyError):
+            panel.value("z")
+
+    def test_same_likelihood(self):
+        panel = regarch_wrapper.cRegArchPanel(self.path)
+        value = panel.value(1)
+        self.assertTrue(value.is_attached)
+        llh_ref = regarch_wrapper.RegArchLLH_from_value(self.model, regarch_wrapper.cRegArchValue(self.series[1]))
+        llh = regarch_wrapper.RegArchLLH_from_value(self.model, value)
+        self.assertAlmostEqual(llh, llh_ref, places=10)
+
+    def test_regressors(self):
+        panel = regarch_wrapper.cRegArchPanel(self.path)
+        value = panel.value("a")
+        self.assertEqual(value.mXt.GetNRow(), N)
+        self.assertEqual(value.mXt.GetNCol(), 2)
+        self.assertEqual(value.mXt.get(7, 0), 7.0)
+        self.assertEqual(value.mXt.get(7, 1), 1.0)
+
+    def test_value_outlives_panel(self):
+        value = regarch_wrapper.cRegArchPanel(self.path).value(0)
+        self.assertEqual(value.mYt[5], self.series[0][5])
+
+    def test_copy_on_write(self):
+        panel = regarch_wrapper.cRegArchPanel(self.path)
+        value = panel.value(2)
+        value.mYt[0] = 1234.0
+        self.assertEqual(regarch_wrapper.cRegArchPanel(self.path).value(2).mYt[0], self.series[2][0])
+
+    def test_bad_file(self):
+        with open(self.path, "r+b") as f:
+            f.truncate(100)
+        with self.assertRaises(RuntimeError):
+            regarch_wrapper.cRegArchPanel(self.path)
+
+
+if __name__ == '__main__':
+    unittest.main()
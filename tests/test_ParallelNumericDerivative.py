@@ -0,0 +1,136 @@
+import unittest
+import regarch_wrapper
+from regarch_test_utils import make_const_mean, make_garch_model
+
+
+def simulate_value(model, n_obs):
+    yt = [0.0] * n_obs
+    regarch_wrapper.RegArchSimul(n_obs, model, yt)
+    return regarch_wrapper.cRegArchValue(yt)
+
+
+class TestParallelNumericDerivative(unittest.TestCase):
+
+    def setUp(self):
+        self.model = make_garch_model()
+        self.value = simulate_value(self.model, 2000)
+        self.n_param = self.model.get_n_param()
+
+    def test_gradient_matches_analytic(self):
+        """The numeric gradient must agree with RegArchGradLLH."""
+        grad_ref = regarch_wrapper.cGSLVector(self.n_param)
+        regarch_wrapper.RegArchGradLLH(self.model, self.value, grad_ref)
+
+        deriv = regarch_wrapper.cParallelNumericDerivative(4, 1e-5)
+        grad = regarch_wrapper.cGSLVector()
+        deriv.compute_grad_llh(self.model, self.value, grad)
+
+        self.assertEqual(grad.GetSize(), self.n_param)
+        self.assertEqual(deriv.get_n_llh_eval(), 2 * self.n_param)
+        for i in range(self.n_param):
+            scale = max(1.0, abs(grad_ref[i]))
+            self.assertAlmostEqual(grad[i] / scale, grad_ref[i] / scale, places=3)
+
+    def test_hessian_matches_analytic(self):
+        """The numeric Hessian must agree with RegArchHessLLH and be symmetric."""
+        hess_ref = regarch_wrapper.cGSLMatrix(self.n_param, self.n_param)
+        regarch_wrapper.RegArchHessLLH(self.model, self.value, hess_ref)
+
+        deriv = regarch_wrapper.cParallelNumericDerivative(4, 1e-4)
+        hess = regarch_wrapper.cGSLMatrix()
+        deriv.compute_hess_llh(self.model, self.value, hess)
+
+        self.assertEqual(deriv.get_n_llh_eval(), 2 * self.n_param * self.n_param + 1)
+        for i in range(self.n_param):
+            for j in range(self.n_param):
+                self.assertAlmostEqual(hess.get(i, j), hess.get(j, i), places=8)
+                scale = max(1.0, abs(hess_ref.get(i, j)))
+                self.assertAlmostEqual(hess.get(i, j) / scale, hess_ref.get(i, j) / scale, places=2)
+
+    def test_reuse_and_model_untouched(self):
+        """Reusing the object gives the same result and leaves the model parameters unchanged."""
+        params_before = self.model.to_param_vector()
+
+        deriv = regarch_wrapper.cParallelNumericDerivative(2)
+        first = regarch_wrapper.cGSLVector()
+        second = regarch_wrapper.cGSLVector()
+        deriv.compute_grad_llh(self.model, self.value, first)
+        deriv.compute_grad_llh(self.model, self.value, second)
+
+        for i in range(self.n_param):
+            self.assertEqual(first[i], second[i])
+        self.assertEqual(self.model.to_param_vector(), params_before)
+
+    def test_adaptive_gradient_and_error(self):
+        """Adaptive mode needs no step, matches the analytic gradient and reports an error estimate."""
+        grad_ref = regarch_wrapper.cGSLVector(self.n_param)
+        regarch_wrapper.RegArchGradLLH(self.model, self.value, grad_ref)
+
+        deriv = regarch_wrapper.cParallelNumericDerivative(4, adaptive=True)
+        self.assertTrue(deriv.is_adaptive())
+        grad = regarch_wrapper.cGSLVector()
+        deriv.compute_grad_llh(self.model, self.value, grad)
+        error = deriv.get_grad_error()
+
+        self.assertEqual(deriv.get_n_llh_eval(), 4 * self.n_param)
+        self.assertEqual(error.GetSize(), self.n_param)
+        for i in range(self.n_param):
+            scale = max(1.0, abs(grad_ref[i]))
+            self.assertAlmostEqual(grad[i] / scale, grad_ref[i] / scale, places=4)
+            self.assertGreaterEqual(error[i], 0.0)
+
+        deriv.set_adaptive(False)
+        deriv.compute_grad_llh(self.model, self.value, grad)
+        self.assertEqual(deriv.get_grad_error().GetSize(), 0)
+
+    def test_richardson_beats_fixed_step(self):
+        """Against RegArchGradLLH / RegArchHessLLH, the extrapolated derivatives are closer than
+        the central differences with the default fixed step."""
+        grad_ref = regarch_wrapper.cGSLVector(self.n_param)
+        hess_ref = regarch_wrapper.cGSLMatrix(self.n_param, self.n_param)
+        regarch_wrapper.RegArchGradLLH(self.model, self.value, grad_ref)
+        regarch_wrapper.RegArchHessLLH(self.model, self.value, hess_ref)
+
+        def errors(deriv):
+            grad = regarch_wrapper.cGSLVector()
+            hess = regarch_wrapper.cGSLMatrix()
+            deriv.compute_grad_and_hess_llh(self.model, self.value, grad, hess)
+            grad_error = max(abs(grad[i] - grad_ref[i]) / max(1.0, abs(grad_ref[i]))
+                             for i in range(self.n_param))
+            hess_error = max(abs(hess.get(i, j) - hess_ref.get(i, j)) / max(1.0, abs(hess_ref.get(i, j)))
+                             for i in range(self.n_param) for j in range(self.n_param))
+            return grad_error, hess_error
+
+        fixed_grad, fixed_hess = errors(regarch_wrapper.cParallelNumericDerivative(4))
+        richardson_grad, richardson_hess = errors(regarch_wrapper.cParallelNumericDerivative(4, adaptive=True))
+        self.assertLess(richardson_grad, fixed_grad)
+        self.assertLess(richardson_hess, fixed_hess)
+
+    def test_parameter_near_zero(self):
+        """A mean of 1e-10 gets a step of the typical scale, not one lost in the rounding."""
+        model = make_garch_model(mean=make_const_mean(1e-10))
+        grad_ref = regarch_wrapper.cGSLVector(self.n_param)
+        regarch_wrapper.RegArchGradLLH(model, self.value, grad_ref)
+
+        for deriv in (regarch_wrapper.cParallelNumericDerivative(4, adaptive=True),
+                      regarch_wrapper.cParallelNumericDerivative(4, 1e-5)):
+            self.assertEqual(deriv.get_typical_scale(), 1.0)
+            grad = regarch_wrapper.cGSLVector()
+            deriv.compute_grad_llh(model, self.value, grad)
+            scale = max(1.0, abs(grad_ref[0]))
+            self.assertAlmostEqual(grad[0] / scale, grad_ref[0] / scale, places=3)
+
+    def test_covariance_is_symmetric(self):
+        deriv = regarch_wrapper.cParallelNumericDerivative(h=1e-4)
+        cov = regarch_wrapper.cGSLMatrix()
+        deriv.compute_cov(self.model, self.value, cov)
+
+        self.assertEqual(cov.GetNRow(), self.n_param)
+        for i in range(self.n_param):
+            self.assertGreater(cov.get(i, i), 0.0)
+            for j in range(i):
+                self.assertAlmostEqual(cov.get(i, j), cov.get(j, i), places=10)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,78 @@
+import array
+import unittest
+
+import regarch_wrapper
+
+try:
+    import numpy as np
+except ImportError:
+    np = None
+
+
+class TestParamDispatch(unittest.TestCase):
+    """Argument kinds accepted by the unified set / get / realloc."""
+
+    def setUp(self):
+        self.ar = regarch_wrapper.cAr(3)
+
+    def assertParams(self, expected):
+        vector = self.ar.get(0)
+        for i, value in enumerate(expected):
+            self.assertAlmostEqual(vector[i], value, places=12)
+
+    def test_scalars(self):
+        self.ar.set(0.5, 1, 0)
+        self.ar.set(2, 2)  # an int is a float value, num_param defaults to 0
+        self.assertEqual(self.ar.get(1, 0), 0.5)
+        self.assertEqual(self.ar.get(2, 0), 2.0)
+        self.ar.set(0.25, "ar", 0)
+        self.assertEqual(self.ar.get("ar", 0), 0.25)
+
+    def test_sequences(self):
+        self.ar.set([0.1, 0.2, 0.3], 0)
+        self.assertParams([0.1, 0.2, 0.3])
+        self.ar.set((0.4, 0.5, 0.6), 0)
+        self.assertParams([0.4, 0.5, 0.6])
+        self.ar.set(array.array("d", [0.7, 0.8, 0.9]), 0)
+        self.assertParams([0.7, 0.8, 0.9])
+        self.ar.set(range(3), "ar")
+        self.assertParams([0.0, 1.0, 2.0])
+
+    def test_cgslvector(self):
+        vector = regarch_wrapper.cGSLVector(3)
+        vector[1] = 0.5
+        self.ar.set(vector, 0)
+        self.assertParams([0.0, 0.5, 0.0])
+
+    @unittest.skipIf(np is None, "numpy not installed")
+    def test_numpy(self):
+        self.ar.set(np.array([0.1, 0.2, 0.3]), 0)
+        self.assertParams([0.1, 0.2, 0.3])
+        self.ar.set(np.arange(6.0)[::2], 0)  # strided
+        self.assertParams([0.0, 2.0, 4.0])
+        self.ar.set(np.array([1, 2, 3], dtype=np.int32), 0)
+        self.assertParams([1.0, 2.0, 3.0])
+        self.ar.set(np.float32(0.5), np.int64(1), 0)
+        self.assertEqual(self.ar.get(1, 0), 0.5)
+
+    def test_realloc(self):
+        self.ar.realloc(5)
+        self.assertEqual(self.ar.get_n_param(), 5)
+        self.ar.realloc([0.1, 0.2])
+        self.assertEqual(self.ar.get_n_param(), 2)
+
+    def test_errors(self):
+        with self.assertRaises(RuntimeError):
+            self.ar.set(0.5, 1.5)
+        with self.assertRaises(RuntimeError):
+            self.ar.set(None, 0)
+        with self.assertRaises(TypeError):
+            self.ar.set([0.1, "a", 0.3], 0)
+        with self.assertRaises(OverflowError):
+            self.ar.set(0.5, -1)
+        with self.assertRaises(RuntimeError):
+            self.ar.realloc(2.5)
+
+
+if __name__ == "__main__":
+    unittest.main()
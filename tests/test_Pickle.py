@@ -0,0 +1,124 @@
+import pickle
+import unittest
+from concurrent.futures import ProcessPoolExecutor
+from multiprocessing import shared_memory
+
+import regarch_wrapper
+from regarch_test_utils import GARCH, make_const_mean, make_garch_model
+
+N = 500
+
+
+def make_model():
+    mean = make_const_mean()
+    mean.add_one_mean(regarch_wrapper.cAr(1))
+    return make_garch_model(resids=regarch_wrapper.cStudentResiduals(7.0), mean=mean)
+
+
+def llh_in_worker(model, value):
+    return regarch_wrapper.RegArchLLH_from_value(model, value)
+
+
+def llh_on_shared(model, name, n):
+    shm = shared_memory.SharedMemory(name=name)
+    try:
+        value = regarch_wrapper.cSharedRegArchValue(shm.buf, n)
+        llh = regarch_wrapper.RegArchLLH_from_value(model, value)
+        del value
+    finally:
+        shm.close()
+    return llh
+
+
+class TestPickle(unittest.TestCase):
+
+    def setUp(self):
+        self.model = make_model()
+        yt = [0.0] * N
+        regarch_wrapper.RegArchSimul(N, self.model, yt)
+        self.yt = yt
+        self.llh = regarch_wrapper.RegArchLLH_from_value(self.model, regarch_wrapper.cRegArchValue(yt))
+
+    def test_model_round_trip(self):
+        copy = pickle.loads(pickle.dumps(self.model))
+        self.assertEqual(copy.get_n_param(), self.model.get_n_param())
+        self.assertEqual(copy.to_param_vector(), self.model.to_param_vector())
+        llh = regarch_wrapper.RegArchLLH_from_value(copy, regarch_wrapper.cRegArchValue(self.yt))
+        self.assertEqual(llh, self.llh)
+
+    def test_component_round_trip(self):
+        var = pickle.loads(pickle.dumps(self.model.get_var()))
+        self.assertIsInstance(var, regarch_wrapper.cGarch)
+        self.assertEqual(var.get_n_param(), 3)
+        self.assertAlmostEqual(var.get(0, 2), GARCH)
+        resid = pickle.loads(pickle.dumps(regarch_wrapper.cStudentResiduals(7.0)))
+        self.assertIsInstance(resid, regarch_wrapper.cStudentResiduals)
+        self.assertEqual(resid.get_n_param(), 1)
+
+    def test_value_round_trip(self):
+        value = regarch_wrapper.cRegArchValue(self.yt)
+        regarch_wrapper.RegArchLLH_from_value(self.model, value)
+        copy = pickle.loads(pickle.dumps(value))
+        self.assertEqual(copy.mYt.GetSize(), N)
+        self.assertEqual(copy.mHt[N - 1], value.mHt[N - 1])
+        packed = pickle.loads(pickle.dumps(regarch_wrapper.cPackedRegArchValue(self.yt)))
+        self.assertTrue(packed.is_packed)
+        self.assertEqual(packed.mYt[N - 1], self.yt[N - 1])
+
+    def test_shared_value_round_trip(self):
+        """The buffer is not pickled: a shared value comes back as a packed copy."""
+        shm = shared_memory.SharedMemory(create=True, size=regarch_wrapper.cSharedRegArchValue.nbytes(N))
+        try:
+            value = regarch_wrapper.cSharedRegArchValue(shm.buf, N)
+            value.copy_from(regarch_wrapper.cRegArchValue(self.yt))
+            copy = pickle.loads(pickle.dumps(value))
+            del value
+        finally:
+            shm.close()
+            shm.unlink()
+        self.assertIs(type(copy), regarch_wrapper.cPackedRegArchValue)
+        self.assertFalse(copy.is_attached)
+        self.assertEqual(copy.mYt[N - 1], self.yt[N - 1])
+        self.assertEqual(regarch_wrapper.RegArchLLH_from_value(self.model, copy), self.llh)
+
+    def test_corrupted_state(self):
+        state = self.model.__getstate__()
+        with self.assertRaises(RuntimeError):
+            regarch_wrapper.cRegArchModel().__setstate__(state[:-4])
+
+    def test_python_component_refused(self):
+        class MyVar(regarch_wrapper.cAbstCondVar):
+            pass
+        with self.assertRaises(RuntimeError):
+            pickle.dumps(MyVar())
+
+    def test_shared_memory(self):
+        shm = shared_memory.SharedMemory(create=True, size=regarch_wrapper.cSharedRegArchValue.nbytes(N))
+        try:
+            value = regarch_wrapper.cSharedRegArchValue(shm.buf, N)
+            self.assertTrue(value.is_attached)
+            value.copy_from(regarch_wrapper.cRegArchValue(self.yt))
+            # A second attachment sees the same series
+            other = shared_memory.SharedMemory(name=shm.name)
+            view = regarch_wrapper.cSharedRegArchValue(other.buf, N)
+            self.assertEqual(view.mYt[N - 1], self.yt[N - 1])
+            self.assertEqual(regarch_wrapper.RegArchLLH_from_value(self.model, view), self.llh)
+            self.assertEqual(value.mHt[N - 1], view.mHt[N - 1])
+            del view
+            other.close()
+            with ProcessPoolExecutor(max_workers=2) as pool:
+                llh = pool.submit(llh_on_shared, self.model, shm.name, N).result()
+            self.assertEqual(llh, self.llh)
+            del value
+        finally:
+            shm.close()
+            shm.unlink()
+
+    def test_process_pool(self):
+        with ProcessPoolExecutor(max_workers=2) as pool:
+            llh = pool.submit(llh_in_worker, self.model, regarch_wrapper.cRegArchValue(self.yt)).result()
+        self.assertEqual(llh, self.llh)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,56 @@
+import unittest
+import regarch_wrapper
+from regarch_test_utils import ARCH, CSTE, GARCH, make_garch_model
+
+N = 500
+
+
+class PyGarch(regarch_wrapper.cAbstCondVar):
+    """GARCH(1,1) written in Python, per date only."""
+
+    def __init__(self):
+        regarch_wrapper.cAbstCondVar.__init__(self, regarch_wrapper.eCondVarEnum.eGarch)
+        self.compute_var_series = None
+
+    def get_n_param(self):
+        return 3
+
+    def get_n_lags(self):
+        return 1
+
+    def compute_var(self, date, data):
+        h = CSTE
+        if date > 0:
+            h += ARCH * data.mUt[date - 1] ** 2 + GARCH * data.mHt[date - 1]
+        return h
+
+
+class TestProfile(unittest.TestCase):
+
+    def setUp(self):
+        yt = [0.0] * N
+        regarch_wrapper.RegArchSimul(N, make_garch_model(), yt)
+        self.yt = yt
+        regarch_wrapper.reset_profile()
+
+    def test_reset(self):
+        regarch_wrapper.RegArchLLH_from_value(make_garch_model(PyGarch()), regarch_wrapper.cRegArchValue(self.yt))
+        regarch_wrapper.reset_profile()
+        self.assertEqual(regarch_wrapper.get_profile(), {})
+
+    @unittest.skipIf(regarch_wrapper.profile_enabled(), "profiler compiled in")
+    def test_empty_when_disabled(self):
+        regarch_wrapper.RegArchLLH_from_value(make_garch_model(PyGarch()), regarch_wrapper.cRegArchValue(self.yt))
+        self.assertEqual(regarch_wrapper.get_profile(), {})
+
+    @unittest.skipUnless(regarch_wrapper.profile_enabled(),
+                         "needs a build with REGARCH_ENABLE_PROFILE (cmake --preset linux-profile)")
+    def test_python_component_is_counted(self):
+        regarch_wrapper.RegArchLLH_from_value(make_garch_model(PyGarch()), regarch_wrapper.cRegArchValue(self.yt))
+        entry = regarch_wrapper.get_profile()["var/PyGarch/ComputeVar"]
+        self.assertGreaterEqual(entry["count"], N)
+        self.assertGreater(entry["time_s"], 0.0)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,100 @@
+import math
+import unittest
+import regarch_wrapper
+from regarch_test_utils import make_garch_model
+
+
+class TestSandwich(unittest.TestCase):
+
+    def setUp(self):
+        self.model = make_garch_model()
+        yt = [0.0] * 2000
+        regarch_wrapper.RegArchSimul(2000, self.model, yt)
+        self.value = regarch_wrapper.cRegArchValue(yt)
+        self.n_param = self.model.get_n_param()
+
+    def test_matches_separate_passes(self):
+        """I, J, covariance and LLH agree with RegArchComputeIAndJ / RegArchComputeCov / RegArchLLH."""
+        i_ref = regarch_wrapper.cGSLMatrix(self.n_param, self.n_param)
+        j_ref = regarch_wrapper.cGSLMatrix(self.n_param, self.n_param)
+        cov_ref = regarch_wrapper.cGSLMatrix(self.n_param, self.n_param)
+        regarch_wrapper.RegArchComputeIAndJ(self.model, self.value, i_ref, j_ref)
+        regarch_wrapper.RegArchComputeCov(self.model, self.value, cov_ref)
+        llh_ref = regarch_wrapper.RegArchLLH_from_value(self.model, self.value)
+
+        res = regarch_wrapper.RegArchComputeSandwich(self.model, self.value)
+
+        self.assertEqual(res.n_obs, 2000)
+        self.assertAlmostEqual(res.llh, llh_ref, places=6)
+        for i in range(self.n_param):
+            for j in range(self.n_param):
+                self.assertAlmostEqual(res.I.get(i, j), i_ref.get(i, j), places=8)
+                self.assertAlmostEqual(res.J.get(i, j), j_ref.get(i, j), places=8)
+                self.assertAlmostEqual(res.cov.get(i, j), cov_ref.get(i, j), places=10)
+
+    def test_stat_table(self):
+        """Standard errors, t-stats and p-values are consistent with the covariance."""
+        res = regarch_wrapper.cRegArchSandwich()
+        res.compute(self.model, self.value)
+        table = res.stat_table
+
+        self.assertEqual(table.GetNRow(), self.n_param)
+        self.assertEqual(table.GetNCol(), 4)
+        for i in range(self.n_param):
+            se = math.sqrt(res.cov.get(i, i))
+            self.assertAlmostEqual(res.std_err[i], se, places=12)
+            self.assertAlmostEqual(res.t_stat[i], res.param[i] / se, places=10)
+            self.assertAlmostEqual(res.p_value[i], math.erfc(abs(res.t_stat[i]) / math.sqrt(2.0)), places=12)
+            self.assertAlmostEqual(table.get(i, 1), se, places=12)
+
+    def test_hac_matches_direct_formula(self):
+        """Streaming Bartlett HAC equals J^-1 Omega J^-1 / n built from the stored scores."""
+        n_lag = 3
+        res = regarch_wrapper.RegArchComputeSandwich(self.model, self.value,
+                                                     regarch_wrapper.eHacKernelEnum.eHacBartlett, n_lag)
+        self.assertEqual(res.hac_n_lag, n_lag)
+
+        k = self.n_param
+        n = res.n_obs
+        grad_data = regarch_wrapper.cRegArchGradient(self.model.get_n_lags(), 1, 3, 0)
+        scores = []
+        for t in range(n):
+            g = regarch_wrapper.cGSLVector(k)
+            regarch_wrapper.RegArchGradLt(t, self.model, self.value, grad_data, g)
+            scores.append([g[i] for i in range(k)])
+
+        omega = regarch_wrapper.cGSLMatrix(k, k)
+        for a in range(k):
+            for b in range(k):
+                val = sum(s[a] * s[b] for s in scores) / n
+                for j in range(1, n_lag + 1):
+                    w = 1.0 - j / (n_lag + 1.0)
+                    gab = sum(scores[t][a] * scores[t - j][b] for t in range(j, n)) / n
+                    gba = sum(scores[t][b] * scores[t - j][a] for t in range(j, n)) / n
+                    val += w * (gab + gba)
+                omega.set(a, b, val)
+
+        inv_j = regarch_wrapper.Inv(res.J)
+        for a in range(k):
+            for b in range(k):
+                ref = sum(inv_j.get(a, c) * omega.get(c, d) * inv_j.get(d, b)
+                          for c in range(k) for d in range(k)) / n
+                self.assertAlmostEqual(res.hac_cov.get(a, b), ref, places=10)
+            self.assertAlmostEqual(res.std_err[a] ** 2, res.hac_cov.get(a, a), places=12)
+
+    def test_hac_automatic_bandwidth(self):
+        """Without lags the Newey-West bandwidth is used; zero lags gives back the i.i.d. covariance."""
+        res = regarch_wrapper.cRegArchSandwich(regarch_wrapper.eHacKernelEnum.eHacParzen)
+        res.compute(self.model, self.value)
+        self.assertGreaterEqual(res.hac_bandwidth, 1.0)
+        self.assertEqual(res.hac_n_lag, int(math.ceil(res.hac_bandwidth)) - 1)
+
+        res.set_hac(regarch_wrapper.eHacKernelEnum.eHacBartlett, 0)
+        res.compute(self.model, self.value)
+        for i in range(self.n_param):
+            for j in range(self.n_param):
+                self.assertAlmostEqual(res.hac_cov.get(i, j), res.cov.get(i, j), places=12)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,62 @@
+import math
+import os
+import tempfile
+import unittest
+
+import regarch_wrapper
+
+
+class TestTextLoader(unittest.TestCase):
+
+    def write(self, text):
+        handle, path = tempfile.mkstemp(suffix=".csv")
+        with os.fdopen(handle, "w") as f:
+            f.write(text)
+        self.addCleanup(os.remove, path)
+        return path
+
+    def test_columns_and_header(self):
+        lines = ["date,ret,x1,x2"]
+        lines += ["%d,%r,%d,1.0" % (t, 0.01 * t, t % 5) for t in range(1000)]
+        path = self.write("\n".join(lines) + "\n")
+        self.assertEqual(regarch_wrapper.read_text_header(path), ["date", "ret", "x1", "x2"])
+        value = regarch_wrapper.load_text(path, yt_col="ret", xt_cols=["x1", "x2"], header=True, n_thread=4)
+        self.assertEqual(value.mYt.GetSize(), 1000)
+        self.assertEqual(value.mYt[123], 1.23)
+        self.assertEqual(value.mXt.GetNCol(), 2)
+        self.assertEqual(value.mXt.get(123, 0), 3.0)
+        self.assertEqual(value.mXt.get(123, 1), 1.0)
+
+    def test_same_as_list(self):
+        yt = [0.0] * 300
+        mean = regarch_wrapper.cCondMean()
+        mean.add_one_mean(regarch_wrapper.cConst(0.1))
+        model = regarch_wrapper.cRegArchModel(mean, regarch_wrapper.cConstCondVar(1.0), regarch_wrapper.cNormResiduals())
+        regarch_wrapper.RegArchSimul(300, model, yt)
+        path = self.write("".join("%r\n" % y for y in yt))
+        value = regarch_wrapper.load_text(path)
+        self.assertEqual([value.mYt[t] for t in range(300)], yt)
+
+    def test_missing(self):
+        path = self.write("1 2\n3 NA\n  5   6\n\n7\t8\n")
+        with self.assertRaises(RuntimeError):
+            regarch_wrapper.load_text(path, xt_cols=[1], delimiter=None, missing=["NA"])
+        value = regarch_wrapper.load_text(path, xt_cols=[1], delimiter=None, missing=["NA"], on_missing="skip")
+        self.assertEqual(value.mYt.GetSize(), 3)
+        self.assertEqual(value.mYt[1], 5.0)
+        value = regarch_wrapper.load_text(path, xt_cols=[1], delimiter=None, missing=["NA"], on_missing="nan")
+        self.assertEqual(value.mYt.GetSize(), 4)
+        self.assertTrue(math.isnan(value.mXt.get(1, 0)))
+
+    def test_errors(self):
+        path = self.write("a;b\n1;2\n3;x\n")
+        with self.assertRaisesRegex(RuntimeError, "line 3"):
+            regarch_wrapper.load_text(path, xt_cols=[1], delimiter=";", header=True)
+        with self.assertRaises(KeyError):
+            regarch_wrapper.load_text(path, yt_col="c", delimiter=";", header=True)
+        with self.assertRaises(ValueError):
+            regarch_wrapper.load_text(path, on_missing="zero")
+
+
+if __name__ == '__main__':
+    unittest.main()
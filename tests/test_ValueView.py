@@ -0,0 +1,79 @@
+import pickle
+import unittest
+import regarch_wrapper
+from regarch_test_utils import make_garch_model
+
+N = 600
+WINDOW = 250
+
+
+class TestValueView(unittest.TestCase):
+
+    def setUp(self):
+        self.model = make_garch_model()
+        self.yt = [0.0] * N
+        regarch_wrapper.RegArchSimul(N, self.model, self.yt)
+        self.parent = regarch_wrapper.cRegArchValue(self.yt)
+
+    def llh_copy(self, begin, end):
+        return regarch_wrapper.RegArchLLH_from_value(self.model, regarch_wrapper.cRegArchValue(self.yt[begin:end]))
+
+    def test_rolling_window(self):
+        view = regarch_wrapper.cRegArchValueView(self.parent, 0, WINDOW)
+        self.assertTrue(view.is_attached)
+        arena = view.arena_size
+        for begin in (0, 7, 100, N - WINDOW):
+            view.set_range(begin, begin + WINDOW)
+            self.assertEqual((view.begin, view.end), (begin, begin + WINDOW))
+            self.assertEqual(view.mYt[0], self.yt[begin])
+            llh = regarch_wrapper.RegArchLLH_from_value(self.model, view)
+            self.assertAlmostEqual(llh, self.llh_copy(begin, begin + WINDOW), places=10)
+        self.assertEqual(view.arena_size, arena)
+
+    def test_expanding_window(self):
+        view = regarch_wrapper.cRegArchValueView(self.parent, 0, 100)
+        for end in (100, 300, N):
+            view.set_range(0, end)
+            self.assertEqual(view.mYt.GetSize(), end)
+            llh = regarch_wrapper.RegArchLLH_from_value(self.model, view)
+            self.assertAlmostEqual(llh, self.llh_copy(0, end), places=10)
+
+    def test_shares_parent_data(self):
+        view = regarch_wrapper.cRegArchValueView(self.parent, 10, 20)
+        view.mYt[0] = 42.0
+        self.assertEqual(self.parent.mYt[10], 42.0)
+        regarch_wrapper.RegArchLLH_from_value(self.model, view)
+        self.assertEqual(self.parent.mHt[10], 0.0)
+        view.pack()
+        self.assertFalse(view.is_attached)
+        view.mYt[1] = 43.0
+        self.assertNotEqual(self.parent.mYt[11], 43.0)
+
+    def test_regressors(self):
+        self.parent.set_xt([[float(t), 1.0] for t in range(N)])
+        view = regarch_wrapper.cRegArchValueView(self.parent, 30, 40)
+        self.assertEqual(view.mXt.GetNRow(), 10)
+        self.assertEqual(view.mXt.get(2, 0), 32.0)
+
+    def test_keeps_parent_alive(self):
+        view = regarch_wrapper.cRegArchValueView(regarch_wrapper.cRegArchValue(self.yt), 5, 50)
+        self.assertEqual(view.mYt[0], self.yt[5])
+
+    def test_pickle_round_trip(self):
+        """The parent is not pickled: the window comes back as a packed copy."""
+        view = regarch_wrapper.cRegArchValueView(self.parent, 100, 100 + WINDOW)
+        copy = pickle.loads(pickle.dumps(view))
+        self.assertIs(type(copy), regarch_wrapper.cPackedRegArchValue)
+        self.assertEqual(copy.mYt.GetSize(), WINDOW)
+        self.assertEqual(copy.mYt[0], self.yt[100])
+        self.assertEqual(regarch_wrapper.RegArchLLH_from_value(self.model, copy), self.llh_copy(100, 100 + WINDOW))
+
+    def test_bad_range(self):
+        with self.assertRaises(IndexError):
+            regarch_wrapper.cRegArchValueView(self.parent, 10, N + 1)
+        with self.assertRaises(IndexError):
+            regarch_wrapper.cRegArchValueView(self.parent, 10, 10)
+
+
+if __name__ == '__main__':
+    unittest.main()
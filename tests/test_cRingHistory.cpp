@@ -0,0 +1,82 @@
+/*!
+ * \file test_cRingHistory.cpp
+ * \brief Unit test of cRingHistory, run by ctest.
+ *
+ * The class is header-only and does not depend on RegArchLib or Python.
+ */
+#include "cRingHistory.h"
+#include <cstdio>
+
+static int gsNFail = 0;
+
+#define RING_CHECK(theCond) \
+    do { if (!(theCond)) { std::printf("%s:%d: %s\n", __FILE__, __LINE__, #theCond); gsNFail++; } } while (0)
+
+// Lag(j) of a depth 3 history after 0 to 10 pushes: block t holds (t, 10 t)
+static void TestLagAfterWrapAround(void)
+{
+    cRingHistory<double> myHist(3, 2);
+    RING_CHECK(myHist.GetSize() == 0);
+    for (int t = 0; t < 10; t++)
+    {
+        double myBlock[2] = { (double)t, 10.0 * t };
+        myHist.Push(myBlock);
+        size_t myExpected = (t + 1 < 3) ? (size_t)(t + 1) : 3;
+        RING_CHECK(myHist.GetSize() == myExpected);
+        for (size_t j = 0; j < myHist.GetSize(); j++)
+        {
+            RING_CHECK(myHist.Lag(j)[0] == (double)(t - (int)j));
+            RING_CHECK(myHist.Lag(j)[1] == 10.0 * (t - (int)j));
+        }
+    }
+}
+
+// Push() hands out the slot of the oldest block, written in place
+static void TestPushInPlace(void)
+{
+    cRingHistory<int> myHist(2, 1);
+    *myHist.Push() = 1;
+    *myHist.Push() = 2;
+    int* mySlot = myHist.Push();
+    RING_CHECK(*mySlot == 1);
+    *mySlot = 3;
+    RING_CHECK(*myHist.Lag(0) == 3);
+    RING_CHECK(*myHist.Lag(1) == 2);
+}
+
+// Depth 1: every push replaces the only block
+static void TestDepthOne(void)
+{
+    cRingHistory<double> myHist(1, 1);
+    for (int t = 0; t < 4; t++)
+    {
+        double myValue = t;
+        myHist.Push(&myValue);
+        RING_CHECK(myHist.GetSize() == 1);
+        RING_CHECK(*myHist.Lag(0) == myValue);
+    }
+}
+
+static void TestClearAndReAlloc(void)
+{
+    cRingHistory<double> myHist(2, 1);
+    double myValue = 1.0;
+    myHist.Push(&myValue);
+    myHist.Clear();
+    RING_CHECK(myHist.GetSize() == 0 && myHist.GetDepth() == 2);
+    myHist.ReAlloc(4, 3);
+    RING_CHECK(myHist.GetDepth() == 4 && myHist.GetWidth() == 3 && myHist.GetSize() == 0);
+    myHist.Delete();
+    RING_CHECK(myHist.GetDepth() == 0 && myHist.GetWidth() == 0);
+}
+
+int main(void)
+{
+    TestLagAfterWrapAround();
+    TestPushInPlace();
+    TestDepthOne();
+    TestClearAndReAlloc();
+    if (gsNFail > 0)
+        std::printf("%d check(s) failed\n", gsNFail);
+    return (gsNFail > 0) ? 1 : 0;
+}
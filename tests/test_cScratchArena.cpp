@@ -0,0 +1,145 @@
+/*!
+ * \file test_cScratchArena.cpp
+ * \brief Unit test of cScratchArena and cScratchScope, run by ctest.
+ *
+ * Built with cScratchArena.cpp only, the profiler compiled out: it does not
+ * depend on RegArchLib or Python.
+ */
+#include "cScratchArena.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+static int gsNFail = 0;
+
+#define ARENA_CHECK(theCond) \
+    do { if (!(theCond)) { std::printf("%s:%d: %s\n", __FILE__, __LINE__, #theCond); gsNFail++; } } while (0)
+
+static bool IsAligned(const void* thePtr)
+{
+    return reinterpret_cast<uintptr_t>(thePtr) % cScratchArena::msAlign == 0;
+}
+
+// An inner scope gives its memory back to the outer one, which goes on where it was
+static void TestNestedScopesRewind(void)
+{
+    cScratchScope myOuter;
+    double* myA = myOuter.Alloc<double>(10, 1.0);
+    cScratchArena::sMark myMark = cScratchArena::Local().GetMark();
+    double* myInnerFirst;
+    {
+        cScratchScope myInner;
+        myInnerFirst = myInner.Alloc<double>(100, 2.0);
+        ARENA_CHECK(myInnerFirst != myA && IsAligned(myInnerFirst));
+        double* myC;
+        {
+            cScratchScope myInnermost;
+            myC = myInnermost.Alloc<double>(5);
+            ARENA_CHECK(myC >= myInnerFirst + 100 && IsAligned(myC));
+        }
+        // The innermost block is free again: the next one takes its place
+        double* myD = myInner.Alloc<double>(5);
+        ARENA_CHECK(myD == myC);
+        ARENA_CHECK(myInnerFirst[99] == 2.0);
+    }
+    cScratchArena::sMark myAfter = cScratchArena::Local().GetMark();
+    ARENA_CHECK(myAfter.mChunk == myMark.mChunk && myAfter.mUsed == myMark.mUsed);
+    // Same position as the first inner allocation, the outer block untouched
+    double* myE = myOuter.Alloc<double>(1);
+    ARENA_CHECK(myE == myInnerFirst);
+    for (int i = 0; i < 10; i++)
+        ARENA_CHECK(myA[i] == 1.0);
+}
+
+// Every thread bumps its own arena: the blocks of live threads do not overlap
+// and the allocations of one thread leave the position of another one unchanged
+static void TestThreadsAreIsolated(void)
+{
+    const int myNThread = 4;
+    const size_t myN = 4096;
+    cScratchArena& myMain = cScratchArena::Local();
+    cScratchScope myScope;
+    myScope.Alloc<double>(10);
+    cScratchArena::sMark myMark = myMain.GetMark();
+    size_t myNChunk = myMain.GetNChunk();
+
+    const cScratchArena* myArena[myNThread];
+    double* myFirst[myNThread];
+    bool myOk[myNThread];
+    std::atomic<int> myNReady(0);
+    std::thread myThread[myNThread];
+    for (int k = 0; k < myNThread; k++)
+        myThread[k] = std::thread([k, myN, &myArena, &myFirst, &myOk, &myNReady]()
+        {
+            cScratchScope myThreadScope;
+            double* myBlock = myThreadScope.Alloc<double>(myN, (double)k);
+            myArena[k] = &cScratchArena::Local();
+            myFirst[k] = myBlock;
+            // Every arena stays alive until all the threads have written their block
+            myNReady++;
+            while (myNReady.load() < myNThread)
+                std::this_thread::yield();
+            bool myRes = true;
+            for (size_t i = 0; i < myN; i++)
+                myRes = myRes && myBlock[i] == (double)k;
+            myOk[k] = myRes;
+        });
+    for (int k = 0; k < myNThread; k++)
+        myThread[k].join();
+
+    cScratchArena::sMark myAfter = myMain.GetMark();
+    ARENA_CHECK(myAfter.mChunk == myMark.mChunk && myAfter.mUsed == myMark.mUsed);
+    ARENA_CHECK(myMain.GetNChunk() == myNChunk);
+    for (int k = 0; k < myNThread; k++)
+    {
+        ARENA_CHECK(myOk[k]);
+        ARENA_CHECK(myArena[k] != &myMain);
+        for (int l = 0; l < k; l++)
+        {
+            ARENA_CHECK(myArena[k] != myArena[l]);
+            ARENA_CHECK(myFirst[k] + myN <= myFirst[l] || myFirst[l] + myN <= myFirst[k]);
+        }
+    }
+}
+
+// Past the first chunk a chunk twice as large, or as large as the request, is
+// added; after a release the same requests reuse the chunks, no new one
+static void TestGrowthPastFirstChunk(void)
+{
+    std::thread myThread([]()
+    {
+        cScratchArena& myArena = cScratchArena::Local();
+        ARENA_CHECK(myArena.GetNChunk() == 0);
+        const size_t myN = cScratchArena::msMinChunk / sizeof(double);
+        {
+            cScratchScope myScope;
+            double* myA = myScope.Alloc<double>(myN / 2, 1.0);
+            double* myB = myScope.Alloc<double>(myN, 2.0);
+            double* myC = myScope.Alloc<double>(3 * myN, 3.0);
+            ARENA_CHECK(IsAligned(myB) && IsAligned(myC));
+            ARENA_CHECK(myArena.GetNChunk() == 3);
+            ARENA_CHECK(myArena.GetCapacity() == 7 * cScratchArena::msMinChunk);
+            ARENA_CHECK(myA[myN / 2 - 1] == 1.0 && myB[myN - 1] == 2.0 && myC[3 * myN - 1] == 3.0);
+        }
+        size_t myCapacity = myArena.GetCapacity();
+        {
+            cScratchScope myScope;
+            myScope.Alloc<double>(myN / 2);
+            myScope.Alloc<double>(myN);
+            myScope.Alloc<double>(3 * myN);
+        }
+        ARENA_CHECK(myArena.GetNChunk() == 3 && myArena.GetCapacity() == myCapacity);
+    });
+    myThread.join();
+}
+
+int main(void)
+{
+    TestNestedScopesRewind();
+    TestThreadsAreIsolated();
+    TestGrowthPastFirstChunk();
+    if (gsNFail > 0)
+        std::printf("%d check(s) failed\n", gsNFail);
+    return (gsNFail > 0) ? 1 : 0;
+}